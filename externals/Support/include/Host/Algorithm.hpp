@@ -39,6 +39,7 @@
 #pragma once
 
 #include "HostDevice.hpp"
+#include <cstddef>          //size_t
 #include <unordered_map>    //std::unordered_map
 
 namespace xlib {
@@ -46,6 +47,102 @@ namespace xlib {
 template<class FUN_T, typename... T>
 inline void Funtion_TO_multiThreads(bool MultiCore, FUN_T FUN, T... Args);
 
+/**
+ * @brief Number of host threads used by the multi-threaded algorithms
+ * @return hardware concurrency (at least one)
+ */
+int num_threads() noexcept;
+
+/**
+ * @brief Execute `fun(thread_id, num_threads)` on `num_threads` host threads
+ *        and wait for their termination
+ * @remark the calling thread is reused as `thread_id == 0`
+ */
+template<typename Lambda>
+void parallel_run(const Lambda& fun, int num_threads = xlib::num_threads());
+
+/**
+ * @brief First element of the `thread_id`-th contiguous chunk when `size`
+ *        elements are evenly partitioned among `num_threads` threads
+ */
+template<typename T>
+T thread_chunk(T size, int thread_id, int num_threads) noexcept;
+
+/**
+ * @brief Multi-threaded inclusive prefix sum (as `std::partial_sum`)
+ * @remark `input` and `output` can be the same array
+ */
+template<typename T, typename R>
+void parallel_prefix_sum(const T* input, size_t size, R* output,
+                         int num_threads = xlib::num_threads());
+
+/**
+ * @brief Multi-threaded stable counting sort
+ * @details Call `scatter(index, position)` for every `index` in [0, size),
+ *          where `position` is the rank of `index` in the stable order by
+ *          `key(index)` in [0, num_keys). `counts` (`num_keys` elements) and
+ *          `offsets` (`num_keys + 1` elements, `offsets[0] = 0`) are filled
+ *          with the key histogram and its prefix sum
+ * @remark if the per-thread histograms of all keys exceed `size` elements
+ *         (few items per key, e.g. low-degree graphs) the keys are split in
+ *         `num_threads` contiguous ranges: the items are first partitioned by
+ *         range, then each thread sorts one range with a histogram of the
+ *         range size. Auxiliary space: O(size + num_keys)
+ */
+template<typename T, typename R, typename KeyOp, typename ScatterOp>
+void parallel_counting_sort(size_t size, size_t num_keys, const KeyOp& key,
+                            const ScatterOp& scatter, T* counts, R* offsets,
+                            int num_threads = xlib::num_threads());
+
+/**
+ * @brief Number of threads used by parallel_counting_sort() (and by
+ *        parallel_counting_scatter()) for the given input
+ */
+int counting_sort_threads(size_t size, size_t num_keys,
+                          int num_threads = xlib::num_threads()) noexcept;
+
+/**
+ * @brief Number of bins of the per-thread histograms of
+ *        parallel_counting_sort(): `num_keys`, or `num_threads` key ranges if
+ *        the histograms of all keys would exceed `size` elements
+ */
+size_t counting_sort_bins(size_t size, size_t num_keys, int num_threads)
+                          noexcept;
+
+///@brief Histogram bin of `key` (see counting_sort_bins())
+size_t counting_sort_bin(size_t key, size_t num_keys, size_t num_bins)
+                         noexcept;
+
+/**
+ * @brief Second phase of parallel_counting_sort(): global offsets and stable
+ *        scatter from precomputed per-thread histograms
+ * @details `histograms` holds `num_threads * num_bins` elements, where
+ *          `num_bins` is counting_sort_bins() and the `t`-th histogram counts
+ *          the counting_sort_bin() of the keys of the `t`-th contiguous chunk
+ *          (thread_chunk()) of [0, size). `num_threads` must be the value of
+ *          counting_sort_threads(). The histograms are overwritten
+ */
+template<typename T, typename R, typename KeyOp, typename ScatterOp>
+void parallel_counting_scatter(size_t size, size_t num_keys, const KeyOp& key,
+                               const ScatterOp& scatter, R* histograms,
+                               T* counts, R* offsets, int num_threads);
+
+/**
+ * @brief Multi-threaded stable LSD radix sort of unsigned integer keys
+ * @details Only the lowest `num_bits` bits of the keys are considered.
+ *          `payload` (if not `nullptr`) is permuted along with the keys
+ * @remark required auxilary space: O(size) for the keys and the payload
+ */
+template<typename T, typename R>
+void parallel_radix_sort(T* keys, R* payload, size_t size,
+                         int num_bits    = static_cast<int>(sizeof(T) * 8),
+                         int num_threads = xlib::num_threads());
+
+template<typename T>
+void parallel_radix_sort(T* keys, size_t size,
+                         int num_bits    = static_cast<int>(sizeof(T) * 8),
+                         int num_threads = xlib::num_threads());
+
 /**
  * @brief return the old value if exits
  */
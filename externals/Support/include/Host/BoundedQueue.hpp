@@ -0,0 +1,95 @@
+/**
+ * @internal
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date April, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <atomic>   //std::atomic
+#include <cstddef>  //size_t
+
+namespace xlib {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ * @details Ring buffer where each slot holds a sequence number that tells
+ *          producers and consumers whether the slot is free or full
+ *          (D. Vyukov's algorithm). The capacity is rounded up to a power of
+ *          two
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity);
+    ~BoundedQueue() noexcept;
+
+    BoundedQueue(const BoundedQueue&)   = delete;
+    void operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @return `false` if the queue is full
+     */
+    bool try_push(const T& value) noexcept;
+
+    /**
+     * @return `false` if the queue is empty
+     */
+    bool try_pop(T& value) noexcept;
+
+    ///@brief spin (yielding the thread) until the queue is not full
+    void push(const T& value) noexcept;
+
+    ///@brief spin (yielding the thread) until the queue is not empty
+    T pop() noexcept;
+
+    size_t capacity() const noexcept;
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T                   value;
+    };
+    //producers and consumers update different cache lines
+    static const size_t CACHE_LINE = 64;
+
+    Slot*  _slots { nullptr };
+    size_t _mask  { 0 };
+    alignas(CACHE_LINE) std::atomic<size_t> _tail { 0 };
+    alignas(CACHE_LINE) std::atomic<size_t> _head { 0 };
+};
+
+} // namespace xlib
+
+#include "impl/BoundedQueue.i.hpp"
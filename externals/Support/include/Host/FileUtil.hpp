@@ -38,9 +38,12 @@
  */
 #pragma once
 
+#include "Host/Algorithm.hpp" //xlib::num_threads
 #include <cstddef>  //size_t
 #include <fstream>  //std::ifstream
+#include <istream>  //std::istream
 #include <string>   //std::string
+#include <vector>   //std::vector
 
 namespace xlib {
 
@@ -79,6 +82,20 @@ public:
     template<typename T, typename... Ts>
     void write_noprint(const T* data, size_t size, Ts... args);
 
+    /**
+     * @brief Access the next `size` elements of the mapped file without
+     *        copying them
+     * @warning the pointer is valid only during the object lifetime
+     */
+    template<typename T>
+    const T* read_ptr(size_t size) noexcept;
+
+    /**
+     * @brief Drop the sequential access hint of the constructor. Useful when
+     *        the mapping is kept alive and accessed randomly
+     */
+    void normal_access() const noexcept;
+
 private:
     void read() const noexcept;
     void read_noprint() const noexcept;
@@ -96,6 +113,31 @@ private:
 
 #endif
 
+/**
+ * @brief Read-only `std::istream` on a memory buffer (no copy)
+ */
+class MemoryStream : public std::istream {
+public:
+    explicit MemoryStream(const char* start, const char* end);
+
+    /**
+     * @brief Pointer to the next character to read
+     */
+    const char* current() const noexcept;
+private:
+    class Buffer : public std::streambuf {
+    public:
+        explicit Buffer(const char* start, const char* end) noexcept;
+        const char* current() const noexcept;
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction,
+                         std::ios_base::openmode mode) override;
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode)
+                         override;
+    };
+    Buffer _buffer;
+};
+
 void        check_regular_file(const char* filename);
 void        check_regular_file(std::ifstream& fin, const char* filename = "");
 size_t      file_size(const char* filename);
@@ -108,6 +150,117 @@ std::string extract_filepath_noextension(const std::string& str) noexcept;
 void        skip_lines(std::istream& fin, int num_lines = 1);
 void        skip_words(std::istream& fin, int num_words = 1);
 
+/**
+ * @brief Content of `fin` from the current position to the end of the file
+ */
+std::vector<char> read_remaining(std::istream& fin);
+
+//------------------------------------------------------------------------------
+//  In-memory text scanning (no locale, no allocation)
+
+/**
+ * @brief Skip blank characters (space, tab, carriage return) and commas
+ * @return pointer to the first non-blank character or `end`
+ */
+const char* skip_blanks(const char* ptr, const char* end) noexcept;
+
+/**
+ * @brief Search the end of the current line
+ * @return pointer to the next newline character or `end`
+ */
+const char* end_of_line(const char* ptr, const char* end) noexcept;
+
+/**
+ * @brief Parse a decimal integer after optional blanks
+ * @return pointer to the first character after the number. The input pointer
+ *         (after blanks) is returned if no digit is found
+ */
+template<typename T>
+const char* parse_integer(const char* ptr, const char* end, T& value)
+                          noexcept;
+
+/**
+ * @brief Parse a decimal floating-point number (optional fraction and
+ *        exponent) after optional blanks
+ * @return pointer to the first character after the number
+ */
+template<typename T>
+const char* parse_real(const char* ptr, const char* end, T& value) noexcept;
+
+/**
+ * @brief Parse an integral or floating-point number depending on `T`
+ */
+template<typename T>
+const char* parse_number(const char* ptr, const char* end, T& value) noexcept;
+
+/**
+ * @brief Split [start, end) in `num_chunks` ranges which begin at the start of
+ *        a line
+ * @param[out] chunks array of `num_chunks + 1` boundaries
+ */
+void split_lines(const char* start, const char* end, int num_chunks,
+                 const char** chunks) noexcept;
+
+/**
+ * @brief Parse a text buffer in parallel, one thread for each newline-aligned
+ *        byte range
+ * @details The buffer is visited twice. In the first pass
+ *          `count(line_start, line_end)` returns the number of items stored in
+ *          the line, or a negative value for lines to skip (comments). In the
+ *          second pass `parse(line_start, line_end, line_id, item_id)` is
+ *          called for every non-skipped line, where `line_id` and `item_id`
+ *          are the global indices (in file order) of the line and of its first
+ *          item
+ * @return total number of items
+ */
+template<typename CountOp, typename ParseOp>
+size_t parallel_parse(const char* start, const char* end,
+                      const CountOp& count, const ParseOp& parse,
+                      int num_chunks = xlib::num_threads());
+
+//------------------------------------------------------------------------------
+//  In-memory text formatting and parallel output
+
+/**
+ * @brief Write the decimal representation of an integer
+ * @return pointer to the first character after the number
+ */
+template<typename T>
+char* format_integer(char* ptr, T value) noexcept;
+
+/**
+ * @brief Write a number as `std::ostream::operator<<` with the default
+ *        flags: integers as format_integer(), floating-points as `%g`
+ * @return pointer to the first character after the number
+ */
+template<typename T>
+char* format_number(char* ptr, T value) noexcept;
+
+#if defined(__linux__)
+
+/**
+ * @brief Write a text file in parallel. Each thread formats the items of its
+ *        range in a private buffer and stores it at its own offset of the
+ *        preallocated file (`::pwrite`)
+ * @details The items are formatted twice: the first pass computes the byte
+ *          size of each thread range, which are then prefix-summed into the
+ *          file offsets
+ * @param[in] header text written before the items
+ * @param[in] max_bytes `size_t max_bytes(i)`: upper bound to the size of the
+ *            i-th item
+ * @param[in] format `char* format(i, ptr)`: write the i-th item at `ptr` and
+ *            return the end of the text
+ * @param[in] partition `num_threads + 1` item boundaries of the thread ranges,
+ *            uniform ranges if `nullptr`
+ */
+template<typename SizeOp, typename FormatOp>
+void parallel_write(const std::string& filename, const std::string& header,
+                    size_t num_items, const SizeOp& max_bytes,
+                    const FormatOp& format, const size_t* partition = nullptr,
+                    int num_threads = xlib::num_threads());
+
+#endif
+
 } // namespace xlib
 
 #include "impl/FileUtil.i.hpp"
@@ -64,6 +64,12 @@ protected:
 
     virtual T&   extract()          noexcept = 0;
     virtual void insert(T value)    noexcept final;
+    /**
+     * @brief Reserve `count` items at the tail of the queue (bulk insertion,
+     *        e.g. by multiple threads)
+     * @return pointer to the first reserved item
+     */
+    virtual T*   append(size_t count) noexcept final;
     virtual void clear()            noexcept final;
     virtual void sort()             noexcept final;
 
@@ -94,6 +100,7 @@ public:
     using detail::QueueBase<T>::free;
     using detail::QueueBase<T>::clear;
     using detail::QueueBase<T>::insert;
+    using detail::QueueBase<T>::append;
     using detail::QueueBase<T>::sort;
     using detail::QueueBase<T>::empty;
     using detail::QueueBase<T>::size;
@@ -34,9 +34,12 @@
  * </blockquote>}
  */
 #include "Host/Basic.hpp"   //ERROR
-#include <algorithm>                //std::transform, std::sort, std::equal
+#include <algorithm>                //std::transform, std::sort, std::fill
 #include <cassert>                  //assert
+#include <numeric>                  //std::iota, std::partial_sum
 #include <thread>                   //std::thread
+#include <type_traits>              //std::is_unsigned
+#include <utility>                  //std::swap
 
 namespace xlib {
 
@@ -98,6 +101,276 @@ inline void Funtion_TO_multiThreads(bool MultiCore, FUN_T FUN, T... Args) {
         FUN(Args..., 0, 1);
 }
 
+inline int num_threads() noexcept {
+    auto concurrency = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(concurrency, 1);
+}
+
+template<typename Lambda>
+void parallel_run(const Lambda& fun, int num_threads) {
+    assert(num_threads > 0);
+    if (num_threads == 1) {
+        fun(0, 1);
+        return;
+    }
+    auto threads = new std::thread[num_threads - 1];
+    for (int i = 1; i < num_threads; i++)
+        threads[i - 1] = std::thread([&fun, i, num_threads]{
+                                        fun(i, num_threads);
+                                     });
+    fun(0, num_threads);
+    for (int i = 0; i < num_threads - 1; i++)
+        threads[i].join();
+    delete[] threads;
+}
+
+template<typename T>
+T thread_chunk(T size, int thread_id, int num_threads) noexcept {
+    assert(thread_id >= 0 && thread_id <= num_threads);
+    return static_cast<T>((static_cast<uint64_t>(size) *
+                           static_cast<uint64_t>(thread_id)) /
+                           static_cast<uint64_t>(num_threads));
+}
+
+template<typename T, typename R>
+void parallel_prefix_sum(const T* input, size_t size, R* output,
+                         int num_threads) {
+    const size_t MIN_CHUNK = 4096;
+    num_threads = static_cast<int>(std::min(static_cast<size_t>(num_threads),
+                                   std::max(size / MIN_CHUNK, size_t(1))));
+    auto block_sums = new R[num_threads + 1];
+    block_sums[0]   = 0;
+
+    parallel_run([&](int thread_id, int n) {
+                    auto start = thread_chunk(size, thread_id, n);
+                    auto   end = thread_chunk(size, thread_id + 1, n);
+                    R sum = 0;
+                    for (auto i = start; i < end; i++)
+                        sum += input[i];
+                    block_sums[thread_id + 1] = sum;
+                 }, num_threads);
+
+    std::partial_sum(block_sums, block_sums + num_threads + 1, block_sums);
+
+    parallel_run([&](int thread_id, int n) {
+                    auto start = thread_chunk(size, thread_id, n);
+                    auto   end = thread_chunk(size, thread_id + 1, n);
+                    R sum = block_sums[thread_id];
+                    for (auto i = start; i < end; i++) {
+                        sum      += input[i];
+                        output[i] = sum;
+                    }
+                 }, num_threads);
+    delete[] block_sums;
+}
+
+inline int counting_sort_threads(size_t size, size_t, int num_threads)
+                                 noexcept {
+    const size_t MIN_CHUNK = 4096;
+    return static_cast<int>(std::min(static_cast<size_t>(num_threads),
+                                     std::max(size / MIN_CHUNK, size_t(1))));
+}
+
+inline size_t counting_sort_bins(size_t size, size_t num_keys,
+                                 int num_threads) noexcept {
+    auto threads = static_cast<size_t>(num_threads);
+    return (threads == 1 || threads * num_keys <= size) ? num_keys : threads;
+}
+
+inline size_t counting_sort_bin(size_t key, size_t num_keys, size_t num_bins)
+                                noexcept {
+    //inverse of thread_chunk(num_keys, bin, num_bins)
+    return num_bins == num_keys ? key : ((key + 1) * num_bins - 1) / num_keys;
+}
+
+namespace detail {
+
+template<typename T, typename R, typename KeyOp, typename ScatterOp>
+void counting_sort_by_range(size_t size, size_t num_keys, const KeyOp& key,
+                            const ScatterOp& scatter, R* histograms,
+                            T* counts, R* offsets, int num_threads) {
+    //histograms[t * num_threads + b]: items of the t-th chunk whose key is in
+    //the b-th key range
+    auto num_bins = static_cast<size_t>(num_threads);
+    auto bin_offsets = new R[num_bins + 1];
+    R sum = 0;
+    for (size_t b = 0; b < num_bins; b++) {
+        bin_offsets[b] = sum;
+        for (size_t t = 0; t < num_bins; t++) {
+            auto tmp = histograms[t * num_bins + b];
+            histograms[t * num_bins + b] = sum;
+            sum += tmp;
+        }
+    }
+    bin_offsets[num_bins] = sum;
+    //--------------------------------------------------------------------------
+    // stable partition of the item indices by key range
+    auto ranges = new size_t[size];
+    parallel_run([&](int thread_id, int n) {
+                    auto positions = histograms + thread_id * num_bins;
+                    auto start = thread_chunk(size, thread_id, n);
+                    auto   end = thread_chunk(size, thread_id + 1, n);
+                    for (auto i = start; i < end; i++) {
+                        auto k = static_cast<size_t>(key(i));
+                        ranges[positions[counting_sort_bin(k, num_keys,
+                                                           num_bins)]++] = i;
+                    }
+                 }, num_threads);
+    //--------------------------------------------------------------------------
+    // each thread sorts its key range with a histogram of the range size
+    offsets[0] = 0;
+    parallel_run([&](int thread_id, int n) {
+                    auto key_start = thread_chunk(num_keys, thread_id, n);
+                    auto   key_end = thread_chunk(num_keys, thread_id + 1, n);
+                    size_t first = bin_offsets[thread_id],
+                            last = bin_offsets[thread_id + 1];
+                    std::fill(counts + key_start, counts + key_end, 0);
+                    for (auto j = first; j < last; j++)
+                        counts[ static_cast<size_t>(key(ranges[j])) ]++;
+
+                    auto positions = new R[key_end - key_start];
+                    R position = bin_offsets[thread_id];
+                    for (auto k = key_start; k < key_end; k++) {
+                        positions[k - key_start] = position;
+                        position      += static_cast<R>(counts[k]);
+                        offsets[k + 1] = position;
+                    }
+                    for (auto j = first; j < last; j++) {
+                        auto k = static_cast<size_t>(key(ranges[j]));
+                        scatter(ranges[j], positions[k - key_start]++);
+                    }
+                    delete[] positions;
+                 }, num_threads);
+    delete[] ranges;
+    delete[] bin_offsets;
+}
+
+} // namespace detail
+
+template<typename T, typename R, typename KeyOp, typename ScatterOp>
+void parallel_counting_sort(size_t size, size_t num_keys, const KeyOp& key,
+                            const ScatterOp& scatter, T* counts, R* offsets,
+                            int num_threads) {
+    num_threads     = counting_sort_threads(size, num_keys, num_threads);
+    auto num_bins   = counting_sort_bins(size, num_keys, num_threads);
+    auto histograms = new R[static_cast<size_t>(num_threads) * num_bins];
+    //--------------------------------------------------------------------------
+    // per-thread histograms of contiguous chunks
+    parallel_run([&](int thread_id, int n) {
+                    auto histogram = histograms + thread_id * num_bins;
+                    std::fill(histogram, histogram + num_bins, 0);
+                    auto start = thread_chunk(size, thread_id, n);
+                    auto   end = thread_chunk(size, thread_id + 1, n);
+                    for (auto i = start; i < end; i++) {
+                        auto k = static_cast<size_t>(key(i));
+                        histogram[counting_sort_bin(k, num_keys, num_bins)]++;
+                    }
+                 }, num_threads);
+    parallel_counting_scatter(size, num_keys, key, scatter, histograms, counts,
+                              offsets, num_threads);
+    delete[] histograms;
+}
+
+template<typename T, typename R, typename KeyOp, typename ScatterOp>
+void parallel_counting_scatter(size_t size, size_t num_keys, const KeyOp& key,
+                               const ScatterOp& scatter, R* histograms,
+                               T* counts, R* offsets, int num_threads) {
+    auto num_bins = counting_sort_bins(size, num_keys, num_threads);
+    if (num_bins != num_keys) {
+        detail::counting_sort_by_range(size, num_keys, key, scatter,
+                                       histograms, counts, offsets,
+                                       num_threads);
+        return;
+    }
+    //--------------------------------------------------------------------------
+    // global histogram and offsets
+    const auto& key_range_op = [&](const auto& op) {
+            parallel_run([&](int thread_id, int n) {
+                            auto start = thread_chunk(num_keys, thread_id, n);
+                            auto   end = thread_chunk(num_keys, thread_id + 1,
+                                                      n);
+                            for (auto k = start; k < end; k++)
+                                op(k);
+                         });
+        };
+    key_range_op([&](size_t k) {
+                    R sum = 0;
+                    for (int t = 0; t < num_threads; t++)
+                        sum += histograms[t * num_keys + k];
+                    counts[k] = static_cast<T>(sum);
+                 });
+    offsets[0] = 0;
+    parallel_prefix_sum(counts, num_keys, offsets + 1);
+    //--------------------------------------------------------------------------
+    // histograms to per-thread write positions
+    key_range_op([&](size_t k) {
+                    R position = offsets[k];
+                    for (int t = 0; t < num_threads; t++) {
+                        auto tmp = histograms[t * num_keys + k];
+                        histograms[t * num_keys + k] = position;
+                        position += tmp;
+                    }
+                 });
+    //--------------------------------------------------------------------------
+    // stable scatter: each thread preserves the order of its chunk
+    parallel_run([&](int thread_id, int n) {
+                    auto positions = histograms + thread_id * num_keys;
+                    auto start = thread_chunk(size, thread_id, n);
+                    auto   end = thread_chunk(size, thread_id + 1, n);
+                    for (auto i = start; i < end; i++)
+                        scatter(i, positions[ static_cast<size_t>(key(i)) ]++);
+                 }, num_threads);
+}
+
+template<typename T, typename R>
+void parallel_radix_sort(T* keys, R* payload, size_t size, int num_bits,
+                         int num_threads) {
+    static_assert(std::is_unsigned<T>::value, "keys must be unsigned");
+    const int    RADIX_BITS = 8;
+    const size_t      RADIX = size_t(1) << RADIX_BITS;
+    size_t counts[RADIX], offsets[RADIX + 1];
+
+    auto tmp_keys    = new T[size];
+    auto tmp_payload = payload != nullptr ? new R[size] : nullptr;
+    T* src_keys    = keys;
+    T* dst_keys    = tmp_keys;
+    R* src_payload = payload;
+    R* dst_payload = tmp_payload;
+    for (int shift = 0; shift < num_bits; shift += RADIX_BITS) {
+        parallel_counting_sort(size, RADIX,
+                        [&](size_t i) {
+                            return (src_keys[i] >> shift) & (RADIX - 1);
+                        },
+                        [&](size_t i, size_t pos) {
+                            dst_keys[pos] = src_keys[i];
+                            if (payload != nullptr)
+                                dst_payload[pos] = src_payload[i];
+                        }, counts, offsets, num_threads);
+        std::swap(src_keys, dst_keys);
+        std::swap(src_payload, dst_payload);
+    }
+    if (src_keys != keys) {
+        parallel_run([&](int thread_id, int n) {
+                        auto start = thread_chunk(size, thread_id, n);
+                        auto   end = thread_chunk(size, thread_id + 1, n);
+                        std::copy(src_keys + start, src_keys + end,
+                                  keys + start);
+                        if (payload != nullptr) {
+                            std::copy(src_payload + start, src_payload + end,
+                                      payload + start);
+                        }
+                     }, num_threads);
+    }
+    delete[] tmp_keys;
+    delete[] tmp_payload;
+}
+
+template<typename T>
+void parallel_radix_sort(T* keys, size_t size, int num_bits, int num_threads) {
+    parallel_radix_sort(keys, static_cast<T*>(nullptr), size, num_bits,
+                        num_threads);
+}
+
 namespace detail {
 
 template<typename S, typename R>
@@ -0,0 +1,122 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date April, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include <thread>   //std::this_thread::yield
+
+namespace xlib {
+
+template<typename T>
+BoundedQueue<T>::BoundedQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity)
+        size *= 2;
+    _slots = new Slot[size];
+    _mask  = size - 1;
+    for (size_t i = 0; i < size; i++)
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+BoundedQueue<T>::~BoundedQueue() noexcept {
+    delete[] _slots;
+}
+
+template<typename T>
+bool BoundedQueue<T>::try_push(const T& value) noexcept {
+    auto position = _tail.load(std::memory_order_relaxed);
+    while (true) {
+        auto& slot = _slots[position & _mask];
+        auto  diff = static_cast<std::ptrdiff_t>(
+                        slot.sequence.load(std::memory_order_acquire) -
+                        position);
+        if (diff == 0) {
+            if (_tail.compare_exchange_weak(position, position + 1,
+                                            std::memory_order_relaxed)) {
+                slot.value = value;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+            return false;
+        else
+            position = _tail.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool BoundedQueue<T>::try_pop(T& value) noexcept {
+    auto position = _head.load(std::memory_order_relaxed);
+    while (true) {
+        auto& slot = _slots[position & _mask];
+        auto  diff = static_cast<std::ptrdiff_t>(
+                        slot.sequence.load(std::memory_order_acquire) -
+                        (position + 1));
+        if (diff == 0) {
+            if (_head.compare_exchange_weak(position, position + 1,
+                                            std::memory_order_relaxed)) {
+                value = slot.value;
+                slot.sequence.store(position + _mask + 1,
+                                    std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+            return false;
+        else
+            position = _head.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+void BoundedQueue<T>::push(const T& value) noexcept {
+    while (!try_push(value))
+        std::this_thread::yield();
+}
+
+template<typename T>
+T BoundedQueue<T>::pop() noexcept {
+    T value;
+    while (!try_pop(value))
+        std::this_thread::yield();
+    return value;
+}
+
+template<typename T>
+size_t BoundedQueue<T>::capacity() const noexcept {
+    return _mask + 1;
+}
+
+} // namespace xlib
@@ -33,11 +33,16 @@
  * POSSIBILITY OF SUCH DAMAGE.
  * </blockquote>}
  */
+#include "Host/Algorithm.hpp" //xlib::parallel_run
 #include "Host/Basic.hpp"
 #include "Host/Numeric.hpp" //xlib::per_cent
 #include <cassert>                  //assert
-#include <cmath>                    //std::round
+#include <algorithm>                //std::max
+#include <cmath>                    //std::round, std::pow
+#include <cstdio>                   //std::snprintf
 #include <iomanip>                  //std::setw
+#include <numeric>                  //std::partial_sum
+#include <type_traits>              //std::is_integral
 
 #if defined(__linux__)
     #include <fcntl.h>          //::open
@@ -83,10 +88,239 @@ inline void Progress::per_cent(size_t progress) const noexcept {
 }
 
 //==============================================================================
+
+template<typename T>
+inline const char* parse_integer(const char* ptr, const char* end, T& value)
+                                 noexcept {
+    ptr = xlib::skip_blanks(ptr, end);
+    bool negative = false;
+    if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+        negative = *ptr == '-';
+        ptr++;
+    }
+    T result = 0;
+    for (; ptr < end && static_cast<unsigned>(*ptr - '0') < 10u; ptr++)
+        result = result * 10 + static_cast<T>(*ptr - '0');
+    value = negative ? static_cast<T>(-result) : result;
+    return ptr;
+}
+
+template<typename T>
+inline const char* parse_real(const char* ptr, const char* end, T& value)
+                              noexcept {
+    ptr = xlib::skip_blanks(ptr, end);
+    bool negative = false;
+    if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+        negative = *ptr == '-';
+        ptr++;
+    }
+    double result = 0.0;
+    for (; ptr < end && static_cast<unsigned>(*ptr - '0') < 10u; ptr++)
+        result = result * 10.0 + (*ptr - '0');
+    if (ptr < end && *ptr == '.') {
+        double scale = 0.1;
+        for (ptr++; ptr < end && static_cast<unsigned>(*ptr - '0') < 10u;
+             ptr++) {
+            result += (*ptr - '0') * scale;
+            scale  *= 0.1;
+        }
+    }
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+        int exponent;
+        ptr     = xlib::parse_integer(ptr + 1, end, exponent);
+        result *= std::pow(10.0, exponent);
+    }
+    value = static_cast<T>(negative ? -result : result);
+    return ptr;
+}
+
+namespace detail {
+
+template<typename T>
+inline const char* parse_number_aux(const char* ptr, const char* end,
+                                    T& value, std::true_type) noexcept {
+    return xlib::parse_integer(ptr, end, value);
+}
+
+template<typename T>
+inline const char* parse_number_aux(const char* ptr, const char* end,
+                                    T& value, std::false_type) noexcept {
+    return xlib::parse_real(ptr, end, value);
+}
+
+} // namespace detail
+
+template<typename T>
+inline const char* parse_number(const char* ptr, const char* end, T& value)
+                                noexcept {
+    return detail::parse_number_aux(ptr, end, value,
+                                    std::is_integral<T>());
+}
+
+template<typename CountOp, typename ParseOp>
+size_t parallel_parse(const char* start, const char* end,
+                      const CountOp& count, const ParseOp& parse,
+                      int num_chunks) {
+    auto chunks      = new const char*[num_chunks + 1];
+    auto line_counts = new size_t[num_chunks + 1]();
+    auto item_counts = new size_t[num_chunks + 1]();
+    xlib::split_lines(start, end, num_chunks, chunks);
+
+    const auto& count_lambda = [&](int chunk_id, int) {
+        size_t num_lines = 0, num_items = 0;
+        const char* chunk_end = chunks[chunk_id + 1];
+        for (auto ptr = chunks[chunk_id]; ptr < chunk_end; ) {
+            auto line_end = xlib::end_of_line(ptr, chunk_end);
+            auto    items = count(ptr, line_end);
+            if (items >= 0) {
+                num_lines++;
+                num_items += static_cast<size_t>(items);
+            }
+            ptr = line_end + 1;
+        }
+        line_counts[chunk_id + 1] = num_lines;
+        item_counts[chunk_id + 1] = num_items;
+    };
+    xlib::parallel_run(count_lambda, num_chunks);
+
+    std::partial_sum(line_counts, line_counts + num_chunks + 1, line_counts);
+    std::partial_sum(item_counts, item_counts + num_chunks + 1, item_counts);
+
+    const auto& parse_lambda = [&](int chunk_id, int) {
+        size_t line_id = line_counts[chunk_id];
+        size_t item_id = item_counts[chunk_id];
+        const char* chunk_end = chunks[chunk_id + 1];
+        for (auto ptr = chunks[chunk_id]; ptr < chunk_end; ) {
+            auto line_end = xlib::end_of_line(ptr, chunk_end);
+            auto    items = count(ptr, line_end);
+            if (items >= 0) {
+                parse(ptr, line_end, line_id++, item_id);
+                item_id += static_cast<size_t>(items);
+            }
+            ptr = line_end + 1;
+        }
+    };
+    xlib::parallel_run(parse_lambda, num_chunks);
+
+    size_t total_items = item_counts[num_chunks];
+    delete[] chunks;
+    delete[] line_counts;
+    delete[] item_counts;
+    return total_items;
+}
+
 //==============================================================================
 
+template<typename T>
+inline char* format_integer(char* ptr, T value) noexcept {
+    using unsigned_t = typename std::make_unsigned<T>::type;
+    auto number = static_cast<unsigned_t>(value);
+    if (value < 0) {
+        *ptr++ = '-';
+        number = static_cast<unsigned_t>(0) - number;
+    }
+    int num_digits = 1;
+    for (auto tmp = number; tmp >= 10; tmp /= 10)
+        num_digits++;
+    ptr += num_digits;
+    auto digit = ptr;
+    do {
+        *--digit = static_cast<char>('0' + number % 10);
+        number  /= 10;
+    } while (number != 0);
+    return ptr;
+}
+
+namespace detail {
+
+template<typename T>
+inline char* format_number_aux(char* ptr, T value, std::true_type) noexcept {
+    return xlib::format_integer(ptr, value);
+}
+
+template<typename T>
+inline char* format_number_aux(char* ptr, T value, std::false_type) noexcept {
+    return ptr + std::snprintf(ptr, 32, "%g", static_cast<double>(value));
+}
+
+} // namespace detail
+
+template<typename T>
+inline char* format_number(char* ptr, T value) noexcept {
+    return detail::format_number_aux(ptr, value, std::is_integral<T>());
+}
+
 #if defined(__linux__)
 
+template<typename SizeOp, typename FormatOp>
+void parallel_write(const std::string& filename, const std::string& header,
+                    size_t num_items, const SizeOp& max_bytes,
+                    const FormatOp& format, const size_t* partition,
+                    int num_threads) {
+    const size_t BUFFER_SIZE = 4 * 1024 * 1024;
+    const auto& range = [&](int thread_id) {
+        return partition != nullptr ? partition[thread_id] :
+                          xlib::thread_chunk(num_items, thread_id, num_threads);
+    };
+    //first pass: byte size of each thread range
+    auto offsets = new size_t[num_threads + 1];
+    offsets[0]   = header.size();
+    xlib::parallel_run([&](int thread_id, int) {
+            std::string buffer;
+            size_t bytes = 0;
+            for (auto i = range(thread_id); i < range(thread_id + 1); i++) {
+                buffer.resize(std::max(buffer.size(), max_bytes(i)));
+                bytes += static_cast<size_t>(format(i, &buffer[0]) -
+                                             &buffer[0]);
+            }
+            offsets[thread_id + 1] = bytes;
+        }, num_threads);
+    std::partial_sum(offsets, offsets + num_threads + 1, offsets);
+
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                    S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd == -1)
+        ERROR("::open ", filename)
+    if (::ftruncate(fd, static_cast<off_t>(offsets[num_threads])) == -1)
+        ERROR("::ftruncate")
+    const auto& pwrite_all = [fd](const char* data, size_t size,
+                                  size_t offset) {
+        while (size > 0) {
+            auto written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+            if (written <= 0)
+                ERROR("::pwrite")
+            data   += written;
+            size   -= static_cast<size_t>(written);
+            offset += static_cast<size_t>(written);
+        }
+    };
+    pwrite_all(header.data(), header.size(), 0);
+
+    //second pass: format and write
+    xlib::parallel_run([&](int thread_id, int) {
+            std::string buffer(BUFFER_SIZE, '\0');
+            size_t offset = offsets[thread_id], used = 0;
+            for (auto i = range(thread_id); i < range(thread_id + 1); i++) {
+                auto item_bytes = max_bytes(i);
+                if (used + item_bytes > buffer.size()) {
+                    pwrite_all(buffer.data(), used, offset);
+                    offset += used;
+                    used    = 0;
+                    buffer.resize(std::max(buffer.size(), item_bytes));
+                }
+                used = static_cast<size_t>(format(i, &buffer[used]) -
+                                           &buffer[0]);
+            }
+            pwrite_all(buffer.data(), used, offset);
+            assert(offset + used == offsets[thread_id + 1]);
+        }, num_threads);
+
+    ::close(fd);
+    delete[] offsets;
+}
+
+//==============================================================================
+
 inline MemoryMapped::MemoryMapped(const char* filename, size_t file_size,
                                   Enum mode, bool print) noexcept :
                                     _progress(file_size),
@@ -178,6 +412,21 @@ void MemoryMapped::write_noprint(const T* data, size_t size, Ts... args) {
 
 inline void MemoryMapped::write_noprint() const noexcept {}
 
+//------------------------------------------------------------------------------
+
+inline void MemoryMapped::normal_access() const noexcept {
+    if (::madvise(_mmap_ptr, _file_size, MADV_NORMAL) == -1)
+        ERROR("::madvise");
+}
+
+template<typename T>
+const T* MemoryMapped::read_ptr(size_t size) noexcept {
+    auto ptr = reinterpret_cast<const T*>(_mmap_ptr + _partial);      //NOLINT
+    _partial += size * sizeof(T);
+    assert(_partial <= _file_size);
+    return ptr;
+}
+
 #pragma clang diagnostic pop
 #endif
 
@@ -86,6 +86,14 @@ void QueueBase<T>::insert(T value) noexcept {
     _array[_right++] = value;
 }
 
+template<typename T>
+T* QueueBase<T>::append(size_t count) noexcept {
+    assert(_right + count <= _size && "Queue::append(n) : right + n <= size");
+    auto ptr = _array + _right;
+    _right  += count;
+    return ptr;
+}
+
 template<typename T>
 void QueueBase<T>::sort() noexcept {
     assert(_right - _left > 0);
@@ -35,7 +35,9 @@
  */
 #include "Host/FileUtil.hpp"
 #include "Host/Basic.hpp" //ERROR
+#include <algorithm>              //std::max
 #include <cassert>                //assert
+#include <cstring>                //std::memchr
 #include <fstream>                //std::ifstream
 #include <limits>                 //std::numeric_limits
 
@@ -101,4 +103,79 @@ void skip_words(std::istream& fin, int num_words) {
          fin.ignore(std::numeric_limits<std::streamsize>::max(), ' ');
 }
 
+std::vector<char> read_remaining(std::istream& fin) {
+    auto start_pos = fin.tellg();
+    fin.seekg(0, std::ios::end);
+    auto size = static_cast<size_t>(fin.tellg() - start_pos);
+    fin.seekg(start_pos);
+    std::vector<char> buffer(size);
+    fin.read(buffer.data(), static_cast<std::streamsize>(size));
+    return buffer;
+}
+
+//------------------------------------------------------------------------------
+
+MemoryStream::Buffer::Buffer(const char* start, const char* end) noexcept {
+    auto ptr = const_cast<char*>(start);
+    setg(ptr, ptr, const_cast<char*>(end));
+}
+
+const char* MemoryStream::Buffer::current() const noexcept {
+    return gptr();
+}
+
+MemoryStream::Buffer::pos_type
+MemoryStream::Buffer::seekoff(off_type offset, std::ios_base::seekdir direction,
+                              std::ios_base::openmode) {
+    char* base = direction == std::ios_base::beg ? eback() :
+                 direction == std::ios_base::cur ? gptr() : egptr();
+    if (base + offset < eback() || base + offset > egptr())
+        return pos_type(off_type(-1));
+    setg(eback(), base + offset, egptr());
+    return pos_type(gptr() - eback());
+}
+
+MemoryStream::Buffer::pos_type
+MemoryStream::Buffer::seekpos(pos_type position, std::ios_base::openmode mode) {
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+}
+
+MemoryStream::MemoryStream(const char* start, const char* end) :
+                                std::istream(&_buffer), _buffer(start, end) {}
+
+const char* MemoryStream::current() const noexcept {
+    return _buffer.current();
+}
+
+//------------------------------------------------------------------------------
+
+const char* skip_blanks(const char* ptr, const char* end) noexcept {
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' ||
+                         *ptr == ','))
+        ptr++;
+    return ptr;
+}
+
+const char* end_of_line(const char* ptr, const char* end) noexcept {
+    if (ptr >= end)
+        return end;
+    auto newline = std::memchr(ptr, '\n', static_cast<size_t>(end - ptr));
+    return newline == nullptr ? end : static_cast<const char*>(newline);
+}
+
+void split_lines(const char* start, const char* end, int num_chunks,
+                 const char** chunks) noexcept {
+    auto size = static_cast<size_t>(end - start);
+    chunks[0]          = start;
+    chunks[num_chunks] = end;
+    for (int i = 1; i < num_chunks; i++) {
+        auto ptr = start + (size * static_cast<size_t>(i)) /
+                            static_cast<size_t>(num_chunks);
+        ptr = std::max(ptr, chunks[i - 1]);
+        if (ptr != start && ptr < end && *(ptr - 1) != '\n')
+            ptr = std::min(xlib::end_of_line(ptr, end) + 1, end);
+        chunks[i] = ptr;
+    }
+}
+
 } // namespace xlib
@@ -41,41 +41,157 @@
 #include "Host/Bitmask.hpp"
 #include "Host/Queue.hpp"
 #include <array>
+#include <atomic>
+#include <limits>
 #include <vector>
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
+///@brief BFS::Mode, shared by the BFS of every graph type
+enum class BFSMode { TOP_DOWN, DIRECTION_OPTIMIZING };
+
+/**
+ * @brief Breadth-first search on GraphStd or on GraphCompressed (`graph_t`).
+ *        The adjacency lists are accessed with `for_each_out()`,
+ *        `for_each_in()` and `find_in()` of the graph
+ */
+template<typename vid_t, typename eoff_t,
+         typename graph_t = GraphStd<vid_t, eoff_t>>
 class BFS {
 public:
     using dist_t = int;
     enum { PARENT = 0, PEER = 1, VALID = 2, NOT_VALID = 3 };
+    /**
+     * @brief Traversal strategy of run()
+     * @details `DIRECTION_OPTIMIZING`: Beamer's hybrid BFS. A level is
+     *          expanded bottom-up (every unvisited vertex looks for a parent
+     *          among its incoming edges in the frontier bitmap) when the
+     *          edges of the frontier exceed the unexplored edges / `ALPHA`,
+     *          and top-down again when the frontier is smaller than
+     *          V / `BETA`. The reverse CSR of directed graphs is built on
+     *          demand, undirected graphs must store both directions of
+     *          each edge
+     */
+    using Mode = BFSMode;
+    static const int ALPHA = 15;
+    static const int BETA  = 18;
 
-    explicit BFS(const GraphStd<vid_t, eoff_t>& graph) noexcept;
+    /**
+     * @param[in] num_threads with more than one thread, run() is a
+     *            level-synchronous parallel BFS (same distances): atomic
+     *            visited bitmap, per-thread frontier buffers merged at the
+     *            end of each level, top-down levels split by edges such that
+     *            the high-degree vertices are shared among the threads. The
+     *            small levels are expanded by the calling thread, the threads
+     *            are started once at the first large level and synchronized
+     *            by a barrier at each of the following levels. At most
+     *            xlib::num_threads() threads are used
+     */
+    explicit BFS(const graph_t& graph, Mode mode = Mode::TOP_DOWN,
+                 int num_threads = 1) noexcept;
     ~BFS() noexcept;
 
-    void run(vid_t source) noexcept;
-    void run(const vid_t* sources, int num_sources) noexcept;
+    /**
+     * @details Mode::DIRECTION_OPTIMIZING builds the reverse CSR of directed
+     *          graphs on first access: the allocation may throw
+     */
+    void run(vid_t source);
+    /**
+     * @brief Multi-source BFS (MS-BFS): the sources are visited in batches
+     *        of 64, each batch with a single traversal in which every vertex
+     *        holds 64-bit seen/visit/next masks (one bit per source), such
+     *        that an adjacency list is scanned once per level for all the
+     *        sources of the batch
+     * @details result() is the distance from the nearest source. The
+     *          per-source results are eccentricities(), reached_nodes() and
+     *          distance_sums() (closeness). The batches are traversed in
+     *          parallel by the threads of the object (top-down for every
+     *          Mode), each thread with its own masks (24 bytes per vertex)
+     * @param[in] max_distance the visit stops at this depth (k-hop
+     *            reachability)
+     */
+    void run(const vid_t* sources, int num_sources,
+             dist_t max_distance = std::numeric_limits<dist_t>::max())
+             noexcept;
     void reset() noexcept;
 
     const dist_t* result() const noexcept;
 
+    ///@brief largest distance from each source of the last multi-source run
+    const dist_t*   eccentricities() const noexcept;
+    ///@brief vertices reached by each source (itself included)
+    const vid_t*    reached_nodes()  const noexcept;
+    ///@brief sum of the distances from each source to the reached vertices
+    const uint64_t* distance_sums()  const noexcept;
+
     vid_t  visited_nodes() const noexcept;
+    ///@brief edges examined by the last run
     eoff_t visited_edges() const noexcept;
     dist_t eccentricity()  const noexcept;
 
-    std::vector<std::array<vid_t, 4>> statistics(vid_t source) noexcept;
+    /**
+     * @brief PARENT, PEER, VALID (first edge to a vertex of the next level)
+     *        and NOT_VALID edges of each level, but the last one
+     * @details parallel with the threads of the object
+     */
+    std::vector<std::array<vid_t, 4>> statistics(vid_t source);
 
-    vid_t radius() noexcept;
-    vid_t diameter() noexcept;
+    /**
+     * @brief Smallest eccentricity of the vertices of the largest weakly
+     *        connected component (the other components are ignored)
+     * @details Takes-Kosters bounding algorithm on undirected graphs,
+     *          multi-source BFS on directed graphs. Replaces the results of
+     *          the last run
+     */
+    vid_t radius();
+    ///@brief Largest eccentricity (see radius())
+    vid_t diameter();
+    ///@brief traversals of the last radius() or diameter()
+    int   bfs_runs() const noexcept;
 private:
+    using degree_t = int;
     const dist_t INF = std::numeric_limits<dist_t>::max();
 
-    const GraphStd<vid_t, eoff_t>&  _graph;
+    const graph_t&                  _graph;
     xlib::Bitmask                   _bitmask;
+    ///@brief frontier of the bottom-up steps (Mode::DIRECTION_OPTIMIZING)
+    xlib::Bitmask                   _frontier;
     xlib::Queue<vid_t>              _queue;
-    dist_t*                         _distances { nullptr };
-    bool                            _reset     { false };
+    dist_t*                         _distances     { nullptr };
+    eoff_t                          _visited_edges { 0 };
+    Mode                            _mode;
+    int                             _num_threads;
+    bool                            _reset         { false };
+    ///@brief visited and frontier bitmaps of the parallel run (64-bit words)
+    std::atomic<uint64_t>*          _visited_words    { nullptr };
+    std::atomic<uint64_t>*          _frontier_words   { nullptr };
+    ///@brief prefix sum of the out-degrees of the frontier (parallel run)
+    eoff_t*                         _frontier_offsets { nullptr };
+    std::vector<std::vector<vid_t>> _local_frontiers;
+    ///@brief seen/visit/next source masks of the multi-source run
+    uint64_t*                       _seen_masks       { nullptr };
+    uint64_t*                       _visit_masks      { nullptr };
+    uint64_t*                       _next_masks       { nullptr };
+    std::vector<dist_t>             _eccentricities;
+    std::vector<vid_t>              _reached_nodes;
+    std::vector<uint64_t>           _distance_sums;
+    int                             _bfs_runs         { 0 };
+    ///@brief workers of the allocated multi-source masks
+    int                             _mask_workers     { 0 };
+
+    void runTopDown(vid_t source) noexcept;
+    void runDirectionOptimizing(vid_t source);
+    void runParallel(vid_t source);
+    void runAllSources() noexcept;
+    dist_t boundEccentricities(bool radius);
+    ///@brief vertices of the largest weakly connected component
+    std::vector<vid_t> largestComponent() noexcept;
+    std::vector<std::array<vid_t, 4>> statisticsParallel(vid_t source);
+    /**
+     * @brief Weakly connected component of each vertex (smallest vertex id
+     *        of the component): parallel union-find over the out-edges
+     */
+    void weakComponents(std::vector<vid_t>& labels) noexcept;
 };
 
 } // namespace graph
@@ -0,0 +1,213 @@
+/**
+ * @internal
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstddef>  //size_t
+#include <cstdint>  //uint64_t
+#include <fstream>  //std::ofstream
+#include <mutex>    //std::mutex
+#include <string>   //std::string
+#include <vector>   //std::vector
+
+namespace graph {
+namespace binary {
+
+/**
+ * @brief Sections of the binary graph format v2
+ */
+enum class Section : uint32_t { OUT_OFFSETS = 0, OUT_EDGES,   OUT_DEGREES,
+                                IN_OFFSETS,      IN_EDGES,    IN_DEGREES,
+                                OUT_WEIGHTS,     IN_WEIGHTS,
+                                ORIGINAL_IDS,    SOURCE_KEY };
+
+const int      NUM_SECTIONS = 10;
+const uint32_t VERSION      = 2;
+const uint32_t CHECKSUM     = 1;      ///< Header::flags
+const char     MAGIC[8]     = { 'H', 'O', 'R', 'N', 'E', 'T', 'G', 'R' };
+
+/**
+ * @brief File header, followed by the table of contents
+ *        (`num_sections` SectionEntry) and by the sections. Every section
+ *        starts at a page-aligned offset
+ */
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    char     vid_type[16];
+    char     eoff_type[16];
+    char     weight_type[16];       ///< empty for unweighted graphs
+    uint64_t num_vertices;
+    uint64_t num_edges;
+    uint32_t structure;             ///< detail::StructureEnum flags
+    uint32_t num_sections;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t element_size;
+    uint64_t offset;
+    uint64_t size;                  ///< bytes
+    uint64_t checksum;              ///< 0 if Header::flags has no CHECKSUM
+};
+
+struct SectionData {
+    Section     id;
+    const void* data;
+    size_t      num_items;
+    size_t      element_size;
+};
+
+/**
+ * @brief Content of Section::SOURCE_KEY in binary cache files
+ *        (parsing_prop::CACHE). The cache is valid only if the text file
+ *        still has the same identity, size and modification time
+ */
+struct SourceKey {
+    uint64_t options;               ///< input path, types and properties
+    uint64_t file_size;
+    uint64_t inode;
+    int64_t  mtime;                 ///< nanoseconds
+};
+
+/**
+ * @brief 64-bit FNV-1a hash on 8-byte words, computed incrementally
+ */
+class Checksum {
+public:
+    void     update(const void* data, size_t size) noexcept;
+    uint64_t value() const noexcept;
+private:
+    uint64_t      _hash { 0xCBF29CE484222325 };
+    unsigned char _pending[8];
+    size_t        _num_pending { 0 };
+};
+
+uint64_t checksum(const void* data, size_t size) noexcept;
+
+/**
+ * @brief `true` if the file starts with the v2 magic number
+ */
+bool is_v2(const char* filename);
+
+/**
+ * @brief Key of the text file `filename` for the cache options `options`
+ * @return `false` if the file cannot be accessed
+ */
+bool source_key(const char* filename, uint64_t options, SourceKey& key)
+                noexcept;
+
+/**
+ * @brief Write a v2 file
+ * @param[in] header `magic`, `version` and `num_sections` are filled by the
+ *            function
+ */
+void write(const std::string& filename, Header header,
+           const std::vector<SectionData>& sections, bool checksum,
+           bool print);
+
+/**
+ * @brief Streaming v2 writer: sections are appended one at a time (in any
+ *        order), the header and the table of contents are written by close()
+ */
+class Writer {
+public:
+    explicit Writer(const std::string& filename, bool checksum);
+
+    Writer(const Writer&)         = delete;
+    void operator=(const Writer&) = delete;
+
+    void begin_section(Section id, size_t element_size);
+    void append(const void* data, size_t size);
+    void end_section();
+
+    /**
+     * @param[in] header as write()
+     */
+    void close(Header header, bool print);
+private:
+    std::ofstream             _fout;
+    std::string               _filename;
+    std::vector<SectionEntry> _entries;
+    Checksum                  _checksum;
+    bool                      _use_checksum;
+};
+
+/**
+ * @brief Read-only v2 file. Sections are memory-mapped on demand: the first
+ *        map() of a section maps it (and verifies its checksum), the other
+ *        sections are never touched
+ */
+class File {
+public:
+    explicit File(const char* filename);
+    ~File() noexcept;
+
+    File(const File&)           = delete;
+    void operator=(const File&) = delete;
+
+    const Header& header() const noexcept;
+    bool          has(Section id) const noexcept;
+
+    /**
+     * @brief Table of contents entry of a stored section
+     */
+    const SectionEntry& section(Section id) const noexcept;
+
+    /**
+     * @brief Pointer to the section content (thread-safe)
+     * @return `nullptr` if the section is not stored or it is empty
+     */
+    const void* map(Section id) const;
+
+    /**
+     * @brief Release the mapping of a section (e.g. after copying it)
+     */
+    void unmap(Section id) const noexcept;
+private:
+    Header             _header;
+    SectionEntry       _entries[NUM_SECTIONS];
+    bool               _present[NUM_SECTIONS] {};
+    mutable void*      _mapped[NUM_SECTIONS]  {};
+    mutable std::mutex _mutex;
+    int                _fd { -1 };
+};
+
+} // namespace binary
+} // namespace graph
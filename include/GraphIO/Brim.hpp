@@ -51,7 +51,7 @@ public:
 
     ~Brim() noexcept;
 
-    void run() noexcept;
+    void run();
 
     void reset() noexcept;
 
@@ -38,14 +38,31 @@
 #pragma once
 
 #include "GraphIO/GraphWeight.hpp"
-#include "Host/Queue.hpp"
-#include <set>
+#include <limits>
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+/**
+ * @brief Priority queue of Dijkstra
+ * @remark the stale entries of the lazy queues are skipped at extraction
+ */
+enum class DijkstraQueue {
+    SET,            ///< std::set: erase + insert on decrease-key
+    INDEXED_HEAP,   ///< indexed 4-ary heap with in-place decrease-key
+    RADIX_HEAP,     ///< monotone radix heap, lazy (integral weights only)
+    LAZY_HEAP       ///< binary heap, lazy (a new entry per decrease-key)
+};
+
+namespace detail {
+
+template<typename vid_t, typename weight_t, DijkstraQueue queue_t>
+class DijkstraPQ;
+
+} // namespace detail
+
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t = DijkstraQueue::INDEXED_HEAP>
 class Dijkstra {
-    using SetNode = std::pair<weight_t, vid_t>;
 public:
     explicit Dijkstra(const GraphWeight<vid_t, eoff_t, weight_t>& graph)
                          noexcept;
@@ -58,12 +75,10 @@ public:
 private:
     const weight_t INF = std::numeric_limits<weight_t>::max();
 
-    const GraphWeight<vid_t, eoff_t, weight_t>& _graph;
-    std::set<SetNode> _queue;
-    weight_t*         _distances { nullptr };
-    bool              _reset     { false };
-
-    bool relax(vid_t u, vid_t v, weight_t weight) noexcept;
+    const GraphWeight<vid_t, eoff_t, weight_t>&    _graph;
+    detail::DijkstraPQ<vid_t, weight_t, queue_t>* _queue     { nullptr };
+    weight_t*                                      _distances { nullptr };
+    bool                                           _reset     { false };
 };
 
 } // namespace graph
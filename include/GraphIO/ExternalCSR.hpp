@@ -0,0 +1,69 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstddef>  //size_t
+#include <string>   //std::string
+
+namespace graph {
+
+/**
+ * @brief Out-of-core CSR construction. The edge list is streamed from the
+ *        input file, sorted runs of at most `memory_budget` bytes are spilled
+ *        to temporary files, and the runs are k-way merged directly into a
+ *        binary graph file (format v2) which can be then memory-mapped with
+ *        parsing_prop::MMAP
+ * @details Supported inputs: Matrix Market (`.mtx`, `symmetric` files are
+ *          undirected, the entries beyond the count of the header are
+ *          ignored) and plain edge lists (any other extension): one
+ *          0-based `source destination` pair per line, `#` and `%` comments.
+ *          The vertex ids are not relabeled and must be lower than 2^32.
+ *          Only the O(V) offsets and degrees are kept in memory
+ * @param[in] filename input graph
+ * @param[in] bin_file output binary file
+ * @param[in] memory_budget bytes of the edge buffers
+ * @param[in] reverse store the reverse CSR of directed graphs
+ * @param[in] tmp_dir directory of the sorted runs (default: the directory of
+ *            `bin_file`)
+ */
+template<typename vid_t = int, typename eoff_t = int>
+void buildBinaryExternal(const char* filename, const std::string& bin_file,
+                         size_t memory_budget, bool reverse = true,
+                         const std::string& tmp_dir = "", bool print = true);
+
+} // namespace graph
@@ -0,0 +1,162 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstddef>  //size_t
+#include <cstdint>  //uint64_t
+#include <string>   //std::string
+#include <utility>  //std::pair
+
+namespace graph {
+
+/**
+ * @brief Parameters of a synthetic graph built in memory by
+ *        GraphStd::generate(). Use the factories of `graph::generator`
+ * @details The number of vertices is `2^scale` and the number of generated
+ *          edges is `edge_factor * 2^scale` (expected value for G(n,p)).
+ *          Undirected edges are counted once, as in Graph500
+ */
+struct GeneratorProp {
+    enum class Type { RMAT, KRONECKER, GNP, GNM, CHUNG_LU };
+
+    Type     type;
+    int      scale;
+    int      edge_factor;
+    double   a { 0.57 }, b { 0.19 }, c { 0.19 }; ///< R-MAT probabilities
+    double   exponent   { 2.5 };                 ///< Chung-Lu power law
+    double   max_weight { 100.0 };               ///< GraphWeight only
+    uint64_t seed;
+
+    size_t      num_vertices() const noexcept;
+    std::string name()         const;
+};
+
+namespace generator {
+
+const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15;
+
+/**
+ * @brief R-MAT: each edge descends `scale` levels of the adjacency matrix
+ *        and picks the quadrant with probabilities a, b, c, 1 - a - b - c
+ */
+GeneratorProp rmat(int scale, int edge_factor = 16, double a = 0.57,
+                   double b = 0.19, double c = 0.19,
+                   uint64_t seed = DEFAULT_SEED);
+/**
+ * @brief Graph500 Kronecker generator: R-MAT with the Graph500 initiator
+ *        followed by a pseudo-random permutation of the vertex ids
+ */
+GeneratorProp kronecker(int scale, int edge_factor = 16,
+                        uint64_t seed = DEFAULT_SEED);
+/**
+ * @brief Erdős–Rényi G(n, p): every vertex pair is an edge with probability
+ *        p = edge_factor * n / (number of pairs), no self-loops
+ */
+GeneratorProp gnp(int scale, int edge_factor = 16,
+                  uint64_t seed = DEFAULT_SEED);
+/**
+ * @brief Erdős–Rényi G(n, m): m = edge_factor * n uniform random pairs, no
+ *        self-loops (duplicated edges are not removed)
+ */
+GeneratorProp gnm(int scale, int edge_factor = 16,
+                  uint64_t seed = DEFAULT_SEED);
+/**
+ * @brief Chung-Lu power-law graph: the endpoints are drawn proportionally
+ *        to the expected degrees `w_i ~ (i + 1)^(-1 / (exponent - 1))`
+ *        (vertex 0 has the largest degree)
+ */
+GeneratorProp chung_lu(int scale, int edge_factor = 16, double exponent = 2.5,
+                       uint64_t seed = DEFAULT_SEED);
+
+} // namespace generator
+
+//==============================================================================
+
+/**
+ * @brief Parallel and deterministic edge generation: the edges are produced
+ *        in fixed-size blocks, each one with its own random generator seeded
+ *        by (seed, block index). The output does not depend on the number of
+ *        threads
+ */
+template<typename vid_t>
+class EdgeGenerator {
+    using coo_t = std::pair<vid_t, vid_t>;
+public:
+    explicit EdgeGenerator(const GeneratorProp& prop, bool directed);
+    ~EdgeGenerator() noexcept;
+    EdgeGenerator(const EdgeGenerator&)            = delete;
+    EdgeGenerator& operator=(const EdgeGenerator&) = delete;
+
+    size_t num_vertices() const noexcept;
+    ///@brief number of generated edges (lines)
+    size_t num_edges()    const noexcept;
+
+    /**
+     * @param[out] coo_edges array of num_edges() edges
+     */
+    void generate(coo_t* coo_edges) const;
+
+    /**
+     * @brief `num_edges` weights, uniform in [1, max_weight] for integral
+     *        types and in [0, max_weight) for floating-point types
+     */
+    template<typename weight_t>
+    void generate_weights(weight_t* weights, size_t num_edges) const;
+
+private:
+    const GeneratorProp _prop;
+    const size_t        _num_vertices;
+    const bool          _directed;
+    size_t              _num_edges     { 0 };
+    ///@brief G(n, p) only: vertex rows of each block and edge offsets
+    size_t              _rows_per_block { 0 };
+    size_t*             _block_offsets  { nullptr };
+    size_t              _num_blocks     { 0 };
+
+    void countGnp();
+    void generateGnp(coo_t* coo_edges) const;
+
+    /**
+     * @brief G(n, p) skip sampling of the vertex pairs of a block
+     * @param[in] emit `void emit(vid_t src, vid_t dst)`
+     */
+    template<typename Lambda>
+    void visitGnpBlock(size_t block, const Lambda& emit) const;
+};
+
+} // namespace graph
@@ -39,12 +39,18 @@
 #pragma once
 
 #include "Host/Basic.hpp"   //xlib::PropertyClass
+#include <cstdint>                  //uint64_t
+#include <istream>                  //std::istream
 #include <string>                   //std::string
 
 namespace graph {
 
 namespace detail {
-    enum class ParsingEnum { RANDOMIZE = 1, SORT = 2, PRINT_INFO = 4 };
+    enum class ParsingEnum { RANDOMIZE = 1, SORT = 2, PRINT_INFO = 4,
+                             MMAP = 8, PIPELINE = 16, CACHE = 32,
+                             DEGREE_ORDER = 64, RCM_ORDER = 128,
+                             BFS_ORDER = 256, COMMUNITY_ORDER = 512,
+                             LOW_MEMORY = 1024 };
 } // namespace detail
 
 class ParsingProp : public xlib::PropertyClass<detail::ParsingEnum,
@@ -59,6 +65,10 @@ private:
     bool is_sort()              const noexcept;
     bool is_randomize()         const noexcept;
     bool is_print()             const noexcept;
+    bool is_mmap()              const noexcept;
+    bool is_pipeline()          const noexcept;
+    bool is_cache()             const noexcept;
+    bool is_low_memory()        const noexcept;
 };
 
 namespace parsing_prop {
@@ -66,9 +76,69 @@ namespace parsing_prop {
 const ParsingProp  RANDOMIZE( detail::ParsingEnum::RANDOMIZE );
 const ParsingProp       SORT( detail::ParsingEnum::SORT );
 const ParsingProp PRINT_INFO( detail::ParsingEnum::PRINT_INFO );
+/**
+ * @brief Memory-map the whole text file and parse it in place (no iostream,
+ *        no intermediate copy). Binary files stay mapped and the CSR arrays
+ *        point directly into the mapping (zero-copy, read-only)
+ */
+const ParsingProp       MMAP( detail::ParsingEnum::MMAP );
+/**
+ * @brief Overlap the parsing with the first pass of the CSR construction:
+ *        num_threads() - 1 parser threads push chunks of edges through a
+ *        bounded queue to a thread which counts the degrees.
+ *        Supported: Market files (and Konect, same line layout) of directed
+ *        graphs. Ignored with SORT, RANDOMIZE, LOW_MEMORY, undirected
+ *        (symmetric) inputs and direction conversions
+ */
+const ParsingProp   PIPELINE( detail::ParsingEnum::PIPELINE );
+/**
+ * @brief Keep a binary copy of text inputs (cache_directory()). The next
+ *        read() of the same file, with the same types and properties, loads
+ *        the copy zero-copy (MMAP). The copy is rebuilt when the text file
+ *        changes (identity, size or modification time). Ignored with
+ *        RANDOMIZE and with the COO structure
+ */
+const ParsingProp      CACHE( detail::ParsingEnum::CACHE );
+/**
+ * @brief Relabel the vertices after the CSR construction to improve the
+ *        locality of the traversals (GraphStd::reorder(), Reordering)
+ */
+const ParsingProp    DEGREE_ORDER( detail::ParsingEnum::DEGREE_ORDER );
+const ParsingProp       RCM_ORDER( detail::ParsingEnum::RCM_ORDER );
+const ParsingProp       BFS_ORDER( detail::ParsingEnum::BFS_ORDER );
+const ParsingProp COMMUNITY_ORDER( detail::ParsingEnum::COMMUNITY_ORDER );
+/**
+ * @brief Build the CSR in place of the COO staging array: no second edge
+ *        array is allocated and the COO is never held together with the
+ *        CSR. The peak memory of the construction is the COO plus O(V), the
+ *        CSR of directed graphs with REVERSE takes exactly the COO memory.
+ *        The adjacency lists are not in input order (use SORT for a
+ *        deterministic order). Combine with MMAP to avoid the copy of the
+ *        text file. Unweighted graphs only (GraphWeight ignores it with a
+ *        warning), ignored with the COO structure
+ */
+const ParsingProp  LOW_MEMORY( detail::ParsingEnum::LOW_MEMORY );
 
 } // namespace parsing_prop
 
+/**
+ * @brief Directory of the binary cache files (parsing_prop::CACHE). Empty
+ *        (default): the directory of the input file
+ */
+void set_cache_directory(const std::string& directory);
+
+const std::string& cache_directory() noexcept;
+
+namespace detail {
+
+///@brief ERROR if a text file has fewer entries than declared in its header
+///       (the entries beyond the declared count are ignored)
+void check_lines(const char* format, size_t expected, size_t found);
+///@brief ERROR if the adjacency lists do not fill the COO array exactly
+void check_edges(const char* format, size_t expected, size_t found);
+
+} // namespace detail
+
 //==============================================================================
 namespace detail {
     enum class StructureEnum { DIRECTED = 1, UNDIRECTED = 2, REVERSE = 4,
@@ -124,7 +194,7 @@ public:
                             ParsingProp(parsing_prop::PRINT_INFO)) final;    //NOLINT
 
     virtual void print()     const noexcept = 0;
-    virtual void print_raw() const noexcept = 0;
+    virtual void print_raw() const = 0;
 
     GraphBase(const GraphBase&)      = delete;
     void operator=(const GraphBase&) = delete;
@@ -137,6 +207,9 @@ protected:
     bool          _directed_to_undirected { false };
     bool          _undirected_to_directed { false };
     bool          _stored_undirected      { false };
+    ///@brief the edge weights are interleaved with the destinations
+    ///       (Dimacs10th `fmt` 1)
+    bool          _stored_weights         { false };
 
     explicit GraphBase() = default;
     explicit GraphBase(StructureProp structure) noexcept;
@@ -155,13 +228,40 @@ protected:
     virtual void   readMPG      (std::ifstream& fin, bool print)   = 0;
     virtual void   readBinary   (const char* filename, bool print) = 0;
 
-    virtual GInfo  getMarketHeader   (std::ifstream& fin) final;
-    virtual GInfo  getDimacs9Header  (std::ifstream& fin) final;
-    virtual GInfo  getDimacs10Header (std::ifstream& fin) final;
-    virtual GInfo  getKonectHeader   (std::ifstream& fin) final;
-    virtual void   getNetRepoHeader  (std::ifstream& fin) final;
-    virtual GInfo  getSnapHeader     (std::ifstream& fin) final;
-    virtual GInfo  getMPGHeader      (std::ifstream& fin) final;
+    /**
+     * @brief Memory-mapped readers (parsing_prop::MMAP)
+     * @details [start, end) is the whole file content
+     */
+    virtual void   readMarket   (const char* start, const char* end,
+                                 bool print) = 0;
+    virtual void   readDimacs9  (const char* start, const char* end,
+                                 bool print) = 0;
+    virtual void   readDimacs10 (const char* start, const char* end,
+                                 bool print) = 0;
+    virtual void   readSnap     (const char* start, const char* end,
+                                 bool print) = 0;
+    virtual void   readKonect   (const char* start, const char* end,
+                                 bool print) = 0;
+    virtual void   readNetRepo  (const char* start, const char* end) = 0;
+
+    virtual GInfo  getMarketHeader   (std::istream& fin) final;
+    virtual GInfo  getDimacs9Header  (std::istream& fin) final;
+    virtual GInfo  getDimacs10Header (std::istream& fin) final;
+    virtual GInfo  getKonectHeader   (std::istream& fin) final;
+    virtual void   getNetRepoHeader  (std::istream& fin) final;
+    virtual GInfo  getSnapHeader     (std::istream& fin) final;
+    virtual GInfo  getMPGHeader      (std::istream& fin) final;
+
+    /**
+     * @brief Binary cache of text inputs (parsing_prop::CACHE)
+     * @details cacheKey() is computed before the parsing: it depends on the
+     *          structure requested by the user, not on the one of the file
+     * @return cacheKey(): 0 if the graph cannot be cached. readCache():
+     *         `true` if the graph has been loaded from a valid cache file
+     */
+    virtual uint64_t cacheKey  (const char* filename) const       = 0;
+    virtual bool     readCache (const char* filename, uint64_t key) = 0;
+    virtual void     writeCache(const char* filename, uint64_t key) = 0;
 
     virtual void COOtoCSR() noexcept = 0;
     //virtual void CSRtoCOO() noexcept = 0;
@@ -0,0 +1,256 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date April, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include "GraphIO/GraphStd.hpp"
+#include <atomic>   //std::atomic
+#include <cstdint>  //uint8_t
+#include <iterator> //std::iterator
+#include <mutex>    //std::mutex
+
+namespace graph {
+
+/**
+ * @brief Read-only compressed CSR. Each adjacency list is sorted and stored
+ *        as gap-encoded varints (LEB128): the first neighbor id followed by
+ *        the differences between consecutive neighbors. Vertices are
+ *        addressed by per-vertex byte offsets
+ * @remark the iteration interface (`V`, `vertex()`, `Vertex::begin()`,
+ *         `Edge::dst_id()`) and the adjacency access (`for_each_out()`,
+ *         `for_each_in()`, `find_in()`) match GraphStd, such that BFS, WCC
+ *         and SCC run on both representations
+ */
+template<typename vid_t = int, typename eoff_t = int>
+class GraphCompressed {
+    using degree_t = int;
+public:
+    class Edge;
+    class EdgeIt;
+
+    //--------------------------------------------------------------------------
+    class Vertex {
+        template<typename T, typename R> friend class GraphCompressed;
+    public:
+        vid_t    id()         const noexcept;
+        degree_t out_degree() const noexcept;
+
+        /**
+         * @brief Decode the whole adjacency list
+         * @param[out] neighbors array of (at least) out_degree() elements
+         */
+        void decode(vid_t* neighbors) const noexcept;
+
+        EdgeIt begin() const noexcept;
+        EdgeIt end()   const noexcept;
+    private:
+        const GraphCompressed& _graph;
+        const vid_t            _id;
+        explicit Vertex(vid_t id, const GraphCompressed& graph) noexcept;
+    };
+
+    class VertexIt : public std::iterator<std::forward_iterator_tag, vid_t> {
+        template<typename T, typename R> friend class GraphCompressed;
+    public:
+        VertexIt& operator++()                   noexcept;
+        Vertex    operator*()                    const noexcept;
+        bool      operator!=(const VertexIt& it) const noexcept;
+    private:
+        const GraphCompressed& _graph;
+        vid_t                  _current;
+        explicit VertexIt(vid_t current, const GraphCompressed& graph) noexcept;
+    };
+
+    class VerticesContainer {
+        template<typename T, typename R> friend class GraphCompressed;
+    public:
+        VertexIt begin() const noexcept;
+        VertexIt end()   const noexcept;
+    private:
+        const GraphCompressed& _graph;
+        explicit VerticesContainer(const GraphCompressed& graph) noexcept;
+    };
+    //--------------------------------------------------------------------------
+
+    class Edge {
+        template<typename T, typename R> friend class GraphCompressed;
+    public:
+        Vertex src()    const noexcept;
+        Vertex dst()    const noexcept;
+        vid_t  src_id() const noexcept;
+        vid_t  dst_id() const noexcept;
+    private:
+        const GraphCompressed& _graph;
+        const vid_t            _src_id;
+        const vid_t            _dst_id;
+        explicit Edge(vid_t src_id, vid_t dst_id,
+                      const GraphCompressed& graph) noexcept;
+    };
+
+    /**
+     * @brief Decode the adjacency list on the fly
+     */
+    class EdgeIt : public std::iterator<std::forward_iterator_tag, vid_t> {
+        template<typename T, typename R> friend class GraphCompressed;
+    public:
+        EdgeIt& operator++()                 noexcept;
+        Edge    operator*()                  const noexcept;
+        bool    operator!=(const EdgeIt& it) const noexcept;
+    private:
+        const GraphCompressed& _graph;
+        const uint8_t*         _ptr;
+        degree_t               _remaining;
+        vid_t                  _src_id;
+        vid_t                  _dst_id { 0 };
+        explicit EdgeIt(const uint8_t* ptr, degree_t remaining, vid_t src_id,
+                        const GraphCompressed& graph) noexcept;
+    };
+    //==========================================================================
+
+    VerticesContainer V { *this };
+
+    ///@brief same direction of `graph`
+    explicit GraphCompressed(const GraphStd<vid_t, eoff_t>& graph) noexcept;
+
+    ///@brief undirected graph, as the GraphStd raw CSR constructor
+    explicit GraphCompressed(const eoff_t* csr_offsets, vid_t nV,
+                             const vid_t* csr_edges, eoff_t nE) noexcept;
+
+    ~GraphCompressed() noexcept;
+
+    GraphCompressed(const GraphCompressed&) = delete;
+    void operator=(const GraphCompressed&)  = delete;
+    //--------------------------------------------------------------------------
+
+    vid_t    nV() const noexcept;
+    eoff_t   nE() const noexcept;
+    Vertex   vertex(vid_t index)     const noexcept;
+    degree_t out_degree(vid_t index) const noexcept;
+    degree_t in_degree (vid_t index) const;
+
+    const degree_t* out_degrees_ptr() const noexcept;
+
+    vid_t max_out_degree_id() const noexcept;
+
+    bool  is_directed()       const noexcept;
+    bool  is_undirected()     const noexcept;
+
+    ///@brief `op(dst)` for each out-neighbor of `index`, in ascending order
+    template<typename Lambda>
+    void for_each_out(vid_t index, const Lambda& op) const noexcept;
+
+    /**
+     * @brief for_each_out() on the neighbors in positions [first, last). The
+     *        neighbors before `first` are decoded and skipped
+     */
+    template<typename Lambda>
+    void for_each_out(vid_t index, degree_t first, degree_t last,
+                      const Lambda& op) const noexcept;
+
+    /**
+     * @brief `op(src)` for each in-neighbor of `index`. The compressed
+     *        incoming lists of directed graphs are built on first access
+     *        (thread-safe): they allocate and may throw
+     */
+    template<typename Lambda>
+    void for_each_in(vid_t index, const Lambda& op) const;
+
+    /**
+     * @brief Position of the first in-neighbor of `index` that satisfies
+     *        `predicate`, in_degree(index) if none
+     */
+    template<typename Lambda>
+    degree_t find_in(vid_t index, const Lambda& predicate) const;
+
+    /**
+     * @brief Bytes of the compressed representation (adjacency data, byte
+     *        offsets and degrees), incoming lists included if built
+     */
+    size_t memory_bytes() const noexcept;
+
+    /**
+     * @brief Bytes of the adjacency data of the outgoing lists
+     */
+    size_t data_bytes() const noexcept;
+private:
+    uint8_t*  _data         { nullptr };
+    size_t*   _byte_offsets { nullptr };
+    degree_t* _degrees      { nullptr };
+    vid_t     _nV           { 0 };
+    eoff_t    _nE           { 0 };
+    bool      _directed     { false };
+    ///@brief incoming lists of directed graphs (lazy_reverse())
+    mutable uint8_t*          _in_data         { nullptr };
+    mutable size_t*           _in_byte_offsets { nullptr };
+    mutable degree_t*         _in_degrees      { nullptr };
+    mutable std::atomic<bool> _reverse_ready   { false };
+    mutable std::mutex        _reverse_mutex;
+
+    /**
+     * @brief Gap-encode the sorted (or sorted on the fly) adjacency lists of
+     *        a CSR in parallel
+     */
+    void compress(const eoff_t* csr_offsets, const vid_t* csr_edges,
+                  uint8_t*& data, size_t*& byte_offsets, degree_t*& degrees)
+                  const noexcept;
+
+    ///@brief Make the incoming lists available, if not already
+    void lazy_reverse() const;
+
+    /**
+     * @brief slow path of lazy_reverse(): the outgoing lists are decoded and
+     *        transposed with a counting sort, then compressed
+     */
+    void loadReverse() const;
+
+    static const uint8_t* decode_varint(const uint8_t* ptr, uint64_t& value)
+                                        noexcept;
+
+    /**
+     * @brief Decode the first `degree` neighbors of the list at `ptr` until
+     *        `predicate(neighbor)` is true
+     * @return position of the neighbor that satisfies `predicate`, `degree`
+     *         if none
+     */
+    template<typename Lambda>
+    static degree_t scan(const uint8_t* ptr, degree_t degree,
+                         const Lambda& predicate) noexcept;
+};
+
+} // namespace graph
+
+#include "GraphCompressed.i.hpp"
@@ -0,0 +1,358 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date April, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include <algorithm> //std::max_element
+#include <cassert>
+
+namespace graph {
+
+template<typename vid_t, typename eoff_t>
+inline const uint8_t* GraphCompressed<vid_t, eoff_t>
+::decode_varint(const uint8_t* ptr, uint64_t& value) noexcept {
+    value = *ptr & 0x7F;
+    for (int shift = 7; *ptr++ & 0x80; shift += 7)
+        value |= static_cast<uint64_t>(*ptr & 0x7F) << shift;
+    return ptr;
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline typename GraphCompressed<vid_t, eoff_t>::degree_t
+GraphCompressed<vid_t, eoff_t>::scan(const uint8_t* ptr, degree_t degree,
+                                     const Lambda& predicate) noexcept {
+    uint64_t value = 0;
+    for (degree_t i = 0; i < degree; i++) {
+        uint64_t gap;
+        ptr    = decode_varint(ptr, gap);
+        value += gap;
+        if (predicate(static_cast<vid_t>(value)))
+            return i;
+    }
+    return degree;
+}
+
+////////////////////////////////
+///         Vertex           ///
+////////////////////////////////
+template<typename vid_t, typename eoff_t>
+inline GraphCompressed<vid_t, eoff_t>::Vertex
+::Vertex(vid_t id, const GraphCompressed& graph) noexcept : _graph(graph),
+                                                           _id(id) {}
+
+template<typename vid_t, typename eoff_t>
+inline vid_t GraphCompressed<vid_t, eoff_t>::Vertex::id() const noexcept {
+    return _id;
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::degree_t
+GraphCompressed<vid_t, eoff_t>::Vertex::out_degree() const noexcept {
+    return _graph._degrees[_id];
+}
+
+template<typename vid_t, typename eoff_t>
+inline void GraphCompressed<vid_t, eoff_t>::Vertex
+::decode(vid_t* neighbors) const noexcept {
+    const uint8_t* ptr = _graph._data + _graph._byte_offsets[_id];
+    uint64_t value = 0;
+    for (degree_t i = 0; i < _graph._degrees[_id]; i++) {
+        uint64_t gap;
+        ptr          = decode_varint(ptr, gap);
+        value       += gap;
+        neighbors[i] = static_cast<vid_t>(value);
+    }
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::EdgeIt
+GraphCompressed<vid_t, eoff_t>::Vertex::begin() const noexcept {
+    return EdgeIt(_graph._data + _graph._byte_offsets[_id],
+                  _graph._degrees[_id], _id, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::EdgeIt
+GraphCompressed<vid_t, eoff_t>::Vertex::end() const noexcept {
+    return EdgeIt(nullptr, 0, _id, _graph);
+}
+
+//==============================================================================
+////////////////////////////////
+///         VertexIt         ///
+////////////////////////////////
+template<typename vid_t, typename eoff_t>
+inline GraphCompressed<vid_t, eoff_t>::VertexIt
+::VertexIt(vid_t current, const GraphCompressed& graph) noexcept :
+                                        _graph(graph), _current(current) {}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::VertexIt&
+GraphCompressed<vid_t, eoff_t>::VertexIt::operator++() noexcept {
+    _current++;
+    return *this;
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::Vertex
+GraphCompressed<vid_t, eoff_t>::VertexIt::operator*() const noexcept {
+    return Vertex(_current, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline bool GraphCompressed<vid_t, eoff_t>::VertexIt
+::operator!=(const VertexIt& it) const noexcept {
+    return _current != it._current;
+}
+
+//==============================================================================
+////////////////////////////////
+///  VerticesContainer       ///
+////////////////////////////////
+template<typename vid_t, typename eoff_t>
+inline GraphCompressed<vid_t, eoff_t>::VerticesContainer
+::VerticesContainer(const GraphCompressed& graph) noexcept : _graph(graph) {}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::VertexIt
+GraphCompressed<vid_t, eoff_t>::VerticesContainer::begin() const noexcept {
+    return VertexIt(0, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::VertexIt
+GraphCompressed<vid_t, eoff_t>::VerticesContainer::end() const noexcept {
+    return VertexIt(_graph._nV, _graph);
+}
+
+//==============================================================================
+////////////////////////////////
+///           Edge           ///
+////////////////////////////////
+template<typename vid_t, typename eoff_t>
+inline GraphCompressed<vid_t, eoff_t>::Edge
+::Edge(vid_t src_id, vid_t dst_id, const GraphCompressed& graph) noexcept :
+                        _graph(graph), _src_id(src_id), _dst_id(dst_id) {}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::Vertex
+GraphCompressed<vid_t, eoff_t>::Edge::src() const noexcept {
+    return Vertex(_src_id, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::Vertex
+GraphCompressed<vid_t, eoff_t>::Edge::dst() const noexcept {
+    return Vertex(_dst_id, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline vid_t GraphCompressed<vid_t, eoff_t>::Edge::src_id() const noexcept {
+    return _src_id;
+}
+
+template<typename vid_t, typename eoff_t>
+inline vid_t GraphCompressed<vid_t, eoff_t>::Edge::dst_id() const noexcept {
+    return _dst_id;
+}
+
+//==============================================================================
+////////////////////////////////
+///         EdgeIt           ///
+////////////////////////////////
+template<typename vid_t, typename eoff_t>
+inline GraphCompressed<vid_t, eoff_t>::EdgeIt
+::EdgeIt(const uint8_t* ptr, degree_t remaining, vid_t src_id,
+         const GraphCompressed& graph) noexcept : _graph(graph),
+                                                  _ptr(ptr),
+                                                  _remaining(remaining),
+                                                  _src_id(src_id) {
+    if (_remaining > 0) {
+        uint64_t value;
+        _ptr    = decode_varint(_ptr, value);
+        _dst_id = static_cast<vid_t>(value);
+    }
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::EdgeIt&
+GraphCompressed<vid_t, eoff_t>::EdgeIt::operator++() noexcept {
+    if (--_remaining > 0) {
+        uint64_t gap;
+        _ptr     = decode_varint(_ptr, gap);
+        _dst_id += static_cast<vid_t>(gap);
+    }
+    return *this;
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::Edge
+GraphCompressed<vid_t, eoff_t>::EdgeIt::operator*() const noexcept {
+    return Edge(_src_id, _dst_id, _graph);
+}
+
+template<typename vid_t, typename eoff_t>
+inline bool GraphCompressed<vid_t, eoff_t>::EdgeIt
+::operator!=(const EdgeIt& it) const noexcept {
+    return _remaining != it._remaining;
+}
+
+//==============================================================================
+
+template<typename vid_t, typename eoff_t>
+inline vid_t GraphCompressed<vid_t, eoff_t>::nV() const noexcept {
+    return _nV;
+}
+
+template<typename vid_t, typename eoff_t>
+inline eoff_t GraphCompressed<vid_t, eoff_t>::nE() const noexcept {
+    return _nE;
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::Vertex
+GraphCompressed<vid_t, eoff_t>::vertex(vid_t index) const noexcept {
+    assert(index >= 0 && index < _nV);
+    return Vertex(index, *this);
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::degree_t
+GraphCompressed<vid_t, eoff_t>::out_degree(vid_t index) const noexcept {
+    assert(index >= 0 && index < _nV);
+    return _degrees[index];
+}
+
+template<typename vid_t, typename eoff_t>
+inline const typename GraphCompressed<vid_t, eoff_t>::degree_t*
+GraphCompressed<vid_t, eoff_t>::out_degrees_ptr() const noexcept {
+    return _degrees;
+}
+
+template<typename vid_t, typename eoff_t>
+inline typename GraphCompressed<vid_t, eoff_t>::degree_t
+GraphCompressed<vid_t, eoff_t>::in_degree(vid_t index) const {
+    assert(index >= 0 && index < _nV);
+    if (_directed) {
+        lazy_reverse();
+        return _in_degrees[index];
+    }
+    return _degrees[index];
+}
+
+template<typename vid_t, typename eoff_t>
+inline vid_t GraphCompressed<vid_t, eoff_t>::max_out_degree_id()
+                                                const noexcept {
+    return std::distance(_degrees, std::max_element(_degrees, _degrees + _nV));
+}
+
+template<typename vid_t, typename eoff_t>
+inline bool GraphCompressed<vid_t, eoff_t>::is_directed() const noexcept {
+    return _directed;
+}
+
+template<typename vid_t, typename eoff_t>
+inline bool GraphCompressed<vid_t, eoff_t>::is_undirected() const noexcept {
+    return !_directed;
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphCompressed<vid_t, eoff_t>::for_each_out(vid_t index,
+                                                         const Lambda& op)
+                                                         const noexcept {
+    scan(_data + _byte_offsets[index], _degrees[index],
+         [&](vid_t dst) { op(dst); return false; });
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphCompressed<vid_t, eoff_t>::for_each_out(vid_t index,
+                                                         degree_t first,
+                                                         degree_t last,
+                                                         const Lambda& op)
+                                                         const noexcept {
+    degree_t position = 0;
+    scan(_data + _byte_offsets[index], last,
+         [&](vid_t dst) {
+             if (position++ >= first)
+                 op(dst);
+             return false;
+         });
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphCompressed<vid_t, eoff_t>::for_each_in(vid_t index,
+                                                        const Lambda& op)
+                                                        const {
+    find_in(index, [&](vid_t src) { op(src); return false; });
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline typename GraphCompressed<vid_t, eoff_t>::degree_t
+GraphCompressed<vid_t, eoff_t>::find_in(vid_t index, const Lambda& predicate)
+                                        const {
+    if (!_directed) {
+        return scan(_data + _byte_offsets[index], _degrees[index],
+                    predicate);
+    }
+    lazy_reverse();
+    return scan(_in_data + _in_byte_offsets[index], _in_degrees[index],
+                predicate);
+}
+
+template<typename vid_t, typename eoff_t>
+inline void GraphCompressed<vid_t, eoff_t>::lazy_reverse() const {
+    if (!_reverse_ready.load(std::memory_order_acquire))
+        loadReverse();
+}
+
+template<typename vid_t, typename eoff_t>
+inline size_t GraphCompressed<vid_t, eoff_t>::data_bytes() const noexcept {
+    return _byte_offsets[_nV];
+}
+
+template<typename vid_t, typename eoff_t>
+inline size_t GraphCompressed<vid_t, eoff_t>::memory_bytes() const noexcept {
+    auto index_bytes = (static_cast<size_t>(_nV) + 1) * sizeof(size_t) +
+                       static_cast<size_t>(_nV) * sizeof(degree_t);
+    auto       bytes = data_bytes() + index_bytes;
+    if (_reverse_ready.load(std::memory_order_acquire) && _directed)
+        bytes += _in_byte_offsets[_nV] + index_bytes;
+    return bytes;
+}
+
+} // namespace graph
@@ -0,0 +1,91 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstdint>  //uint64_t
+
+namespace graph {
+
+/**
+ * @brief Degree statistics of a graph (GraphStd::profile())
+ * @details The degrees count the self-loops. Singletons and leaves do not:
+ *          a singleton has no edge apart from self-loops, a leaf exactly one.
+ *          For undirected graphs the in-degree fields are equal to the
+ *          out-degree fields and the reciprocity is one
+ */
+struct GraphProfile {
+    ///@brief log2 histograms: bucket `i` counts the degrees in [2^i, 2^(i+1))
+    static const int NUM_BUCKETS = 64;
+
+    uint64_t num_vertices       { 0 };
+    uint64_t num_edges          { 0 };
+    bool     directed           { true };
+
+    double   average_degree     { 0.0 };
+    double   std_deviation      { 0.0 };    ///< of the out-degrees
+    double   variation_coeff    { 0.0 };
+    double   gini               { 0.0 };    ///< of the out-degrees
+    double   density            { 0.0 };    ///< E / V^2
+
+    uint64_t max_out_degree     { 0 };
+    uint64_t max_in_degree      { 0 };
+    uint64_t out_degree_0       { 0 };
+    uint64_t in_degree_0        { 0 };
+    uint64_t out_degree_1       { 0 };
+    uint64_t in_degree_1        { 0 };
+
+    uint64_t self_loops         { 0 };      ///< edges (u, u)
+    uint64_t self_loop_vertices { 0 };      ///< vertices with a self-loop
+    uint64_t singletons         { 0 };
+    uint64_t out_leaves         { 0 };
+    uint64_t in_leaves          { 0 };
+    ///@brief edges (u, v), u != v, such that (v, u) is also an edge
+    uint64_t reciprocal_edges   { 0 };
+    double   reciprocity        { 0.0 };    ///< over the edges u != v
+
+    uint64_t out_vertices[NUM_BUCKETS] {};  ///< vertices by out-degree
+    uint64_t out_edges[NUM_BUCKETS]    {};  ///< edges by source out-degree
+    uint64_t in_vertices[NUM_BUCKETS]  {};  ///< vertices by in-degree
+
+    ///@brief summary table (GraphStd::print_degree_analysis())
+    void print() const;
+    ///@brief out-degree histograms (GraphStd::print_degree_distrib())
+    void print_histogram() const;
+};
+
+} // namespace graph
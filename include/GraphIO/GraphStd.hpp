@@ -37,28 +37,28 @@
  */
 #pragma once
 
+#include "GraphIO/BinaryFormat.hpp"
 #include "GraphIO/GraphBase.hpp"
+#include "GraphIO/Generator.hpp"
+#include "GraphIO/GraphProfile.hpp"
+#include "GraphIO/IdMap.hpp"
+#include "GraphIO/Reordering.hpp"
 #include "Host/Bitmask.hpp"   //xlib::Bitmask
+#include <atomic>   //std::atomic
+#include <mutex>    //std::mutex
 #include <utility>  //std::pair
+#include <vector>   //std::vector
 
-namespace graph {
-
-template<typename vid_t, typename eoff_t>
-class BFS;
-
-template<typename vid_t, typename eoff_t>
-class WCC;
+namespace xlib {
+    class MemoryMapped;
+} // namespace xlib
 
-template<typename vid_t, typename eoff_t>
-class SCC;
+namespace graph {
 
 template<typename vid_t = int, typename eoff_t = int>
 class GraphStd : public GraphBase<vid_t, eoff_t> {
     using    coo_t = typename std::pair<vid_t, vid_t>;
     using degree_t = int;
-    friend class BFS<vid_t, eoff_t>;
-    friend class WCC<vid_t, eoff_t>;
-    friend class SCC<vid_t, eoff_t>;
 
 public:
     class Edge;
@@ -72,7 +72,7 @@ public:
         vid_t    id()                   const noexcept;
         vid_t    neighbor_id(int index) const noexcept;
         degree_t out_degree()           const noexcept;
-        degree_t in_degree()            const noexcept;
+        degree_t in_degree()            const;
         Edge     edge(int index)        const noexcept;
 
         friend inline std::ostream& operator<<(std::ostream& os,
@@ -209,32 +209,115 @@ public:
     virtual ~GraphStd() noexcept;                                       //NOLINT
     //--------------------------------------------------------------------------
 
+    /**
+     * @brief Build the graph in memory with a synthetic generator instead of
+     *        reading a file, e.g.
+     *        `graph.generate(graph::generator::kronecker(20))`
+     * @details The edges are generated in parallel and the result depends
+     *          only on the generator parameters and seed. The graph is
+     *          undirected unless the structure is `DIRECTED`
+     */
+    void generate(const GeneratorProp& generator,
+                  const ParsingProp& property
+                        = ParsingProp(parsing_prop::PRINT_INFO));
+
+    /**
+     * @brief Relabel the vertices of the CSR with the ordering `type`
+     *        (reorder_permutation()). The adjacency lists are sorted again
+     *        with parsing_prop::SORT, the id map is updated
+     * @return new id of each old vertex id
+     */
+    std::vector<vid_t> reorder(Reordering type);
+    //--------------------------------------------------------------------------
+    //the incoming-edge accessors (in_*) of directed graphs build the reverse
+    //CSR on first access (lazy_reverse()): they allocate and may throw
+
     Vertex   vertex(vid_t index)     const noexcept;
     Edge     edge  (eoff_t index)    const noexcept;
     degree_t out_degree(vid_t index) const noexcept;
-    degree_t in_degree (vid_t index) const noexcept;
+    degree_t in_degree (vid_t index) const;
+
+    /**
+     * @brief Adjacency access shared with GraphCompressed (BFS, WCC, SCC):
+     *        `op(dst)` for each out-neighbor of `index`, in list order
+     */
+    template<typename Lambda>
+    void for_each_out(vid_t index, const Lambda& op) const noexcept;
+
+    ///@brief for_each_out() on the neighbors in positions [first, last)
+    template<typename Lambda>
+    void for_each_out(vid_t index, degree_t first, degree_t last,
+                      const Lambda& op) const noexcept;
+
+    ///@brief `op(src)` for each in-neighbor of `index`
+    template<typename Lambda>
+    void for_each_in(vid_t index, const Lambda& op) const;
+
+    /**
+     * @brief Position of the first in-neighbor of `index` that satisfies
+     *        `predicate`, in_degree(index) if none
+     */
+    template<typename Lambda>
+    degree_t find_in(vid_t index, const Lambda& predicate) const;
 
     const coo_t*    coo_array()       const noexcept;
     const eoff_t*   out_offsets_ptr() const noexcept;
-    const eoff_t*   in_offsets_ptr()  const noexcept;
+    const eoff_t*   in_offsets_ptr()  const;
     const vid_t*    out_edges_ptr()   const noexcept;
-    const vid_t*    in_edges_ptr()    const noexcept;
+    const vid_t*    in_edges_ptr()    const;
     const degree_t* out_degrees_ptr() const noexcept;
-    const degree_t* in_degrees_ptr()  const noexcept;
+    const degree_t* in_degrees_ptr()  const;
+
+    /**
+     * @brief Free the reverse CSR (incoming edges) of a directed graph. It is
+     *        built again from the out-CSR on the next access
+     * @warning not thread-safe with respect to concurrent accesses to the
+     *          incoming edges
+     */
+    virtual void release_reverse() noexcept;
 
     degree_t  max_out_degree()    const noexcept;
-    degree_t  max_in_degree()     const noexcept;
+    degree_t  max_in_degree()     const;
     vid_t     max_out_degree_id() const noexcept;
-    vid_t     max_in_degree_id()  const noexcept;
+    vid_t     max_in_degree_id()  const;
 
     bool      is_directed()       const noexcept;
     bool      is_undirected()     const noexcept;
 
+    /**
+     * @brief Mapping between the ids of the file and the graph ids, empty if
+     *        the ids have not been relabeled (only SNAP and Network
+     *        Repository files are relabeled)
+     */
+    const IdMap<vid_t>& id_map() const noexcept;
+
     void print()     const noexcept override;
-    void print_raw() const noexcept override;
-    void print_degree_distrib()  const noexcept;
-    void print_degree_analysis() const noexcept;
-    void writeBinary(const std::string& filename, bool print = true) const;
+    void print_raw() const override;
+    /**
+     * @brief Degree statistics of the graph computed in one parallel pass
+     *        over the vertices and the edges
+     * @details the in-degrees of directed graphs without the reverse CSR are
+     *          counted on the fly. The reciprocal edges are searched in the
+     *          out-adjacency lists (a sorted copy is built if the lists are
+     *          not sorted)
+     */
+    GraphProfile profile() const;
+
+    void print_degree_distrib()  const;
+    void print_degree_analysis() const;
+    /**
+     * @brief Write the graph in the sectioned binary format (v2). Each CSR
+     *        array is stored in a page-aligned section
+     * @param[in] checksum store a checksum for each section, verified when
+     *            the section is loaded
+     */
+    void writeBinary(const std::string& filename, bool print = true,
+                     bool checksum = false) const;
+    /**
+     * @brief Write the graph in the Matrix Market (`pattern general`) or
+     *        Dimacs10th text format. The file is formatted and written in
+     *        parallel (xlib::parallel_write())
+     */
     void writeMarket(const std::string& filename, bool print = true) const;
     void writeDimacs10th(const std::string& filename, bool print = true)
                          const;
@@ -243,14 +326,50 @@ public:
 protected:
     xlib::Bitmask _bitmask;
     eoff_t*   _out_offsets { nullptr };
-    eoff_t*   _in_offsets  { nullptr };
     vid_t*    _out_edges   { nullptr };
-    vid_t*    _in_edges    { nullptr };
     degree_t* _out_degrees { nullptr };
-    degree_t* _in_degrees  { nullptr };
+    /**
+     * @brief the reverse CSR of v2 binary files is loaded on first access,
+     *        the one of directed graphs without structure_prop::REVERSE is
+     *        built on first access (lazy_reverse())
+     */
+    mutable eoff_t*   _in_offsets  { nullptr };
+    mutable vid_t*    _in_edges    { nullptr };
+    mutable degree_t* _in_degrees  { nullptr };
     coo_t*    _coo_edges   { nullptr };
     size_t    _coo_size    { 0 };
+    /**
+     * @brief Binary file mapping which the CSR arrays point into
+     *        (parsing_prop::MMAP on legacy `.bin` files), `nullptr` otherwise
+     */
+    xlib::MemoryMapped* _memory_mapped { nullptr };
+    ///@brief v2 binary file which the sections are loaded from
+    binary::File*       _binary_file   { nullptr };
+    ///@brief the reverse CSR is available (loaded, built or aliased)
+    mutable std::atomic<bool> _reverse_ready { false };
+    mutable std::mutex        _reverse_mutex;
+    ///@brief the reverse CSR has been built by buildReverse()
+    mutable bool              _reverse_on_demand { false };
+    /**
+     * @brief Per-thread key histograms of the counting sort, filled during
+     *        the parsing (parsing_prop::PIPELINE) and consumed by COOtoCSR()
+     */
+    eoff_t* _out_histograms { nullptr };
+    eoff_t* _in_histograms  { nullptr };
+    IdMap<vid_t> _id_map;
+    ///@brief text file identity when the parsing started (parsing_prop::CACHE)
+    binary::SourceKey _source_key {};
+    ///@brief offsets and edges (and degrees) are not owned by the graph
+    bool _mapped_csr     { false };
+    bool _mapped_degrees { false };
+    /**
+     * @brief The out and in edges share the COO staging array (allocated as
+     *        `coo_t[]`, parsing_prop::LOW_MEMORY)
+     */
+    bool _packed_edges   { false };
     static const uint64_t _seed { 0xA599AC3F0FD21B92 };
+    ///@brief alignment of the CSR arrays in binary files
+    static const size_t   _binary_alignment { 8 };
 
     using GraphBase<vid_t, eoff_t>::_structure;
     using GraphBase<vid_t, eoff_t>::_prop;
@@ -260,6 +379,7 @@ protected:
     using GraphBase<vid_t, eoff_t>::_directed_to_undirected;
     using GraphBase<vid_t, eoff_t>::_undirected_to_directed;
     using GraphBase<vid_t, eoff_t>::_stored_undirected;
+    using GraphBase<vid_t, eoff_t>::_stored_weights;
 
     virtual void allocate(const GInfo& ginfo) noexcept;
 
@@ -271,8 +391,149 @@ protected:
     void readNetRepo (std::ifstream& fin)               override;
     void readMPG     (std::ifstream&, bool)             override;
     void readBinary  (const char* filename, bool print) override;
+    void readBinaryV2(const char* filename, bool print);
+
+    void readMarket  (const char* start, const char* end, bool print)
+                      override;
+    void readDimacs9 (const char* start, const char* end, bool print)
+                      override;
+    void readDimacs10(const char* start, const char* end, bool print)
+                      override;
+    void readSnap    (const char* start, const char* end, bool print)
+                      override;
+    void readKonect  (const char* start, const char* end, bool print)
+                      override;
+    void readNetRepo (const char* start, const char* end) override;
+
+    void parseMarket (const char* start, const char* end, size_t num_lines);
+    void parseNetRepo(const char* start, const char* end);
+
+    /**
+     * @brief Dense relabeling of the first `num_edges` COO edges in order of
+     *        first appearance of the ids (SNAP)
+     */
+    void relabelCOO(size_t num_edges);
+
+    /**
+     * @brief Relabel the ids of `coo_edges` in ascending order, allocate the
+     *        graph with the number of unique ids and copy the edges
+     *        (Network Repository)
+     */
+    void allocateRelabeled(const coo_t* coo_edges, size_t num_lines);
+
+    /**
+     * @brief parseMarket() which overlaps the degree counting with the
+     *        parsing (parsing_prop::PIPELINE)
+     */
+    void parseMarketPipelined(const char* start, const char* end,
+                              size_t num_lines);
+
+    bool is_pipeline_enabled() const noexcept;
+
+    bool is_low_memory_enabled() const noexcept;
+
+    /**
+     * @brief COOtoCSR() with parsing_prop::LOW_MEMORY: in-place permutation
+     *        of the COO by source, compaction of the destinations into the
+     *        first half of the array and, for the reverse CSR, transposition
+     *        into the second half
+     */
+    void buildCSRInPlace();
+
+    ///@brief free the CSR arrays which are owned by the graph
+    void freeCSR() noexcept;
+
+    /**
+     * @brief Fill the weights of the first `num_lines` COO edges (generate()),
+     *        nothing for unweighted graphs
+     */
+    virtual void generateWeights(const EdgeGenerator<vid_t>& generator,
+                                 size_t num_lines);
+
+    /**
+     * @brief Make the reverse CSR available, if not already (thread-safe):
+     *        load the sections of a v2 binary file or, for directed graphs
+     *        without structure_prop::REVERSE, build it (buildReverse())
+     */
+    void lazy_reverse() const;
+
+    ///@brief slow path of lazy_reverse()
+    void loadReverse() const;
+
+    virtual void readReverseSections() const;
+
+    ///@brief transposeCSR() and the incoming edge data (weights)
+    virtual void buildReverse() const;
+
+    /**
+     * @brief Build the reverse CSR from the out-CSR in parallel. The
+     *        incoming lists are sorted by source
+     * @param[out] edge_map out-CSR position of each incoming edge (optional)
+     */
+    void transposeCSR(eoff_t* edge_map) const;
+
+    uint64_t cacheKey  (const char* filename) const       override;
+    bool     readCache (const char* filename, uint64_t key) override;
+    void     writeCache(const char* filename, uint64_t key) override;
+
+    ///@brief type names of the graph, part of the cache key
+    virtual std::string class_id() const;
+
+    /**
+     * @brief Sections and header fields written by writeBinary()
+     */
+    virtual void binary_sections(binary::Header& header,
+                                 std::vector<binary::SectionData>& sections)
+                                 const;
+    /**
+     * @brief Content of a v2 binary section: a pointer into the file mapping
+     *        with parsing_prop::MMAP, a new array otherwise
+     */
+    template<typename T>
+    T* readSection(binary::Section id, size_t num_items) const;
+
+    /**
+     * @brief Sort the COO edges by (source, destination) with a parallel
+     *        radix sort on packed 64-bit keys
+     * @return number of edges after the (optional) duplicate removal
+     */
+    eoff_t sortCOO(bool remove_duplicates) noexcept;
 
     void COOtoCSR() noexcept override;
+
+    ///@brief reorder() requested by the parsing properties, if any
+    void reorderByProperty();
+
+    /**
+     * @brief Move the edge data (weights) to the relabeled CSR
+     * @param[in] out_map old position of each out-edge, `in_map` of each
+     *            in-edge (`nullptr` without the reverse CSR)
+     */
+    virtual void permuteEdgeData(const eoff_t* out_map, const eoff_t* in_map);
+
+    /**
+     * @brief `num_threads + 1` vertex boundaries which split the vertices
+     *        and the edges evenly among the threads
+     */
+    std::vector<size_t> balanced_partition(int num_threads) const noexcept;
+
+    /**
+     * @brief Text writers (xlib::parallel_write()). The items are pieces of
+     *        WRITE_PIECE tokens, a token is an out-edge or the end of an
+     *        adjacency list: the buffer of an item is bounded and the lists
+     *        of the high-degree vertices are split among the threads
+     * @param[in] token_bytes upper bound to the text of a token
+     * @param[in] edge_op `char* edge_op(char* ptr, vid_t source, eoff_t j)`:
+     *            write the j-th edge
+     * @param[in] end_op `char* end_op(char* ptr, vid_t source)`: end of the
+     *            adjacency list of `source`
+     */
+    template<typename EdgeOp, typename EndOp>
+    void writeText(const std::string& filename, const std::string& header,
+                   size_t token_bytes, const EdgeOp& edge_op,
+                   const EndOp& end_op) const;
+
+    static const size_t WRITE_PIECE = 4096;
 };
 
 } // namespace graph
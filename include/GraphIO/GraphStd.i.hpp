@@ -33,6 +33,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  * </blockquote>}
  */
+#include "Host/Algorithm.hpp"  //xlib::num_threads
+#include "Host/FileUtil.hpp"   //xlib::parallel_write
+#include "Host/Numeric.hpp"    //xlib::ceil_div
 #include <algorithm>
 #include <cassert>
 
@@ -59,7 +62,8 @@ GraphStd<vid_t, eoff_t>::Vertex::out_degree() const noexcept {
 
 template<typename vid_t, typename eoff_t>
 inline typename GraphStd<vid_t, eoff_t>::degree_t
-GraphStd<vid_t, eoff_t>::Vertex::in_degree() const noexcept {
+GraphStd<vid_t, eoff_t>::Vertex::in_degree() const {
+    _graph.lazy_reverse();
     return _graph._in_degrees[_id];
 }
 
@@ -224,13 +228,26 @@ GraphStd<vid_t, eoff_t>::EdgesContainer::end() const noexcept {
 ///         GRAPHSTD         ///
 ////////////////////////////////
 
+template<typename vid_t, typename eoff_t>
+inline const typename GraphStd<vid_t, eoff_t>::coo_t*
+GraphStd<vid_t, eoff_t>::coo_array() const noexcept {
+    return _coo_edges;
+}
+
+template<typename vid_t, typename eoff_t>
+inline const IdMap<vid_t>&
+GraphStd<vid_t, eoff_t>::id_map() const noexcept {
+    return _id_map;
+}
+
 template<typename vid_t, typename eoff_t>
 inline const eoff_t* GraphStd<vid_t, eoff_t>::out_offsets_ptr() const noexcept {
     return _out_offsets;
 }
 
 template<typename vid_t, typename eoff_t>
-inline const eoff_t* GraphStd<vid_t, eoff_t>::in_offsets_ptr() const noexcept {
+inline const eoff_t* GraphStd<vid_t, eoff_t>::in_offsets_ptr() const {
+    lazy_reverse();
     return _in_offsets;
 }
 
@@ -240,7 +257,8 @@ inline const vid_t* GraphStd<vid_t, eoff_t>::out_edges_ptr() const noexcept {
 }
 
 template<typename vid_t, typename eoff_t>
-inline const vid_t* GraphStd<vid_t, eoff_t>::in_edges_ptr() const noexcept {
+inline const vid_t* GraphStd<vid_t, eoff_t>::in_edges_ptr() const {
+    lazy_reverse();
     return _in_edges;
 }
 
@@ -252,7 +270,8 @@ GraphStd<vid_t, eoff_t>::out_degrees_ptr() const noexcept {
 
 template<typename vid_t, typename eoff_t>
 inline const typename GraphStd<vid_t, eoff_t>::degree_t*
-GraphStd<vid_t, eoff_t>::in_degrees_ptr() const noexcept {
+GraphStd<vid_t, eoff_t>::in_degrees_ptr() const {
+    lazy_reverse();
     return _in_degrees;
 }
 
@@ -271,7 +290,8 @@ GraphStd<vid_t, eoff_t>::max_out_degree() const noexcept {
 
 template<typename vid_t, typename eoff_t>
 inline typename GraphStd<vid_t, eoff_t>::degree_t
-GraphStd<vid_t, eoff_t>::max_in_degree() const noexcept {
+GraphStd<vid_t, eoff_t>::max_in_degree() const {
+    lazy_reverse();
     return *std::max_element(_in_degrees, _in_degrees + _nV);
 }
 
@@ -282,7 +302,8 @@ inline vid_t GraphStd<vid_t, eoff_t>::max_out_degree_id() const noexcept {
 }
 
 template<typename vid_t, typename eoff_t>
-inline vid_t GraphStd<vid_t, eoff_t>::max_in_degree_id() const noexcept {
+inline vid_t GraphStd<vid_t, eoff_t>::max_in_degree_id() const {
+    lazy_reverse();
     return std::distance(_in_degrees,
                          std::max_element(_in_degrees, _in_degrees + _nV));
 }
@@ -290,11 +311,52 @@ inline vid_t GraphStd<vid_t, eoff_t>::max_in_degree_id() const noexcept {
 
 template<typename vid_t, typename eoff_t>
 inline typename GraphStd<vid_t, eoff_t>::degree_t
-GraphStd<vid_t, eoff_t>::in_degree(vid_t index) const noexcept {
+GraphStd<vid_t, eoff_t>::in_degree(vid_t index) const {
     assert(index >= 0 && index < _nV);
+    lazy_reverse();
     return _in_degrees[index];
 }
 
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphStd<vid_t, eoff_t>::for_each_out(vid_t index,
+                                                  const Lambda& op)
+                                                  const noexcept {
+    for (auto i = _out_offsets[index]; i < _out_offsets[index + 1]; i++)
+        op(_out_edges[i]);
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphStd<vid_t, eoff_t>::for_each_out(vid_t index,
+                                                  degree_t first,
+                                                  degree_t last,
+                                                  const Lambda& op)
+                                                  const noexcept {
+    const vid_t* edges = _out_edges + _out_offsets[index];
+    for (auto i = first; i < last; i++)
+        op(edges[i]);
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline void GraphStd<vid_t, eoff_t>::for_each_in(vid_t index,
+                                                 const Lambda& op) const {
+    lazy_reverse();
+    for (auto i = _in_offsets[index]; i < _in_offsets[index + 1]; i++)
+        op(_in_edges[i]);
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename Lambda>
+inline typename GraphStd<vid_t, eoff_t>::degree_t
+GraphStd<vid_t, eoff_t>::find_in(vid_t index, const Lambda& predicate) const {
+    lazy_reverse();
+    const vid_t* start = _in_edges + _in_offsets[index];
+    const vid_t*   end = _in_edges + _in_offsets[index + 1];
+    return static_cast<degree_t>(std::find_if(start, end, predicate) - start);
+}
+
 template<typename vid_t, typename eoff_t>
 inline typename GraphStd<vid_t, eoff_t>::Vertex
 GraphStd<vid_t, eoff_t>::vertex(vid_t index) const noexcept {
@@ -311,4 +373,74 @@ inline bool GraphStd<vid_t, eoff_t>::is_undirected() const noexcept {
     return _structure.is_undirected();
 }
 
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+inline void GraphStd<vid_t, eoff_t>::lazy_reverse() const {
+    if (!_reverse_ready.load(std::memory_order_acquire))
+        loadReverse();
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename T>
+T* GraphStd<vid_t, eoff_t>::readSection(binary::Section id, size_t num_items)
+                                        const {
+    if (!_binary_file->has(id))
+        ERROR("Binary graph: missing section ", static_cast<int>(id))
+    if (_binary_file->section(id).size != num_items * sizeof(T))
+        ERROR("Binary graph: wrong size of section ", static_cast<int>(id))
+
+    auto ptr = static_cast<const T*>(_binary_file->map(id));
+    if (_prop.is_mmap())
+        return const_cast<T*>(ptr);
+    auto array = new T[num_items];
+    std::copy(ptr, ptr + num_items, array);
+    _binary_file->unmap(id);
+    return array;
+}
+
+template<typename vid_t, typename eoff_t>
+template<typename EdgeOp, typename EndOp>
+void GraphStd<vid_t, eoff_t>::writeText(const std::string& filename,
+                                        const std::string& header,
+                                        size_t token_bytes,
+                                        const EdgeOp& edge_op,
+                                        const EndOp& end_op) const {
+    //the edges of `u` are the tokens [_out_offsets[u] + u, _out_offsets[u + 1]
+    //+ u), the end of its list is the token _out_offsets[u + 1] + u
+    auto nV         = static_cast<size_t>(_nV);
+    auto num_tokens = static_cast<size_t>(_nE) + nV;
+    auto num_pieces = xlib::ceil_div(num_tokens, WRITE_PIECE);
+    const auto& first_token = [&](size_t u) {
+                                  return static_cast<size_t>(_out_offsets[u])
+                                         + u;
+                              };
+    const auto& max_bytes = [&](size_t) { return WRITE_PIECE * token_bytes; };
+    const auto& format = [&](size_t piece, char* ptr) {
+            auto token = piece * WRITE_PIECE;
+            auto  stop = std::min(token + WRITE_PIECE, num_tokens);
+            //vertex of the first token: the last u with first_token(u) <= token
+            size_t low = 0, high = nV;
+            while (high - low > 1) {
+                auto mid = low + (high - low) / 2;
+                if (first_token(mid) <= token)
+                    low = mid;
+                else
+                    high = mid;
+            }
+            for (auto u = low; token < stop; token++) {
+                auto end_token = static_cast<size_t>(_out_offsets[u + 1]) + u;
+                if (token < end_token) {
+                    ptr = edge_op(ptr, static_cast<vid_t>(u),
+                                  static_cast<eoff_t>(token - u));
+                }
+                else
+                    ptr = end_op(ptr, static_cast<vid_t>(u++));
+            }
+            return ptr;
+        };
+    xlib::parallel_write(filename, header, num_pieces, max_bytes, format,
+                         nullptr, xlib::num_threads());
+}
+
 } //namespace graph
@@ -38,20 +38,15 @@
 #pragma once
 
 #include "GraphIO/GraphStd.hpp"
-#include <tuple>
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
-class BFS;
-
-template<typename vid_t, typename eoff_t>
-class WCC;
-
 template<typename vid_t, typename eoff_t, typename weight_t>
 class BellmanFord;
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+enum class DijkstraQueue;
+
+template<typename vid_t, typename eoff_t, typename weight_t, DijkstraQueue>
 class Dijkstra;
 
 template<typename vid_t, typename eoff_t, typename weight_t>
@@ -59,12 +54,10 @@ class Brim;
 
 template<typename vid_t = int, typename eoff_t = int, typename weight_t = int>
 class GraphWeight : public GraphStd<vid_t, eoff_t> {
-    using    coo_t = typename std::tuple<vid_t, vid_t, weight_t>;
     using degree_t = int;
-    friend class BFS<vid_t, eoff_t>;
-    friend class WCC<vid_t, eoff_t>;
     friend class BellmanFord<vid_t, eoff_t, weight_t>;
-    friend class Dijkstra<vid_t, eoff_t, weight_t>;
+    template<typename, typename, typename, DijkstraQueue>
+    friend class Dijkstra;
     friend class Brim<vid_t, eoff_t, weight_t>;
 
 public:
@@ -93,9 +86,11 @@ public:
     using GraphStd<vid_t, eoff_t>::out_degrees_ptr;
     using GraphStd<vid_t, eoff_t>::in_degrees_ptr;
 
-    const coo_t*    coo_array()         const noexcept;
+    using GraphStd<vid_t, eoff_t>::coo_array;
+    ///@brief weights of the coo_array() edges
+    const weight_t* coo_weights_array() const noexcept;
     const weight_t* out_weights_array() const noexcept;
-    const weight_t* in_weights_array()  const noexcept;
+    const weight_t* in_weights_array()  const;
 
     using GraphStd<vid_t, eoff_t>::max_out_degree;
     using GraphStd<vid_t, eoff_t>::max_in_degree;
@@ -103,9 +98,17 @@ public:
     using GraphStd<vid_t, eoff_t>::max_in_degree_id;
     using GraphStd<vid_t, eoff_t>::is_directed;
 
+    ///@brief GraphStd::release_reverse() and the incoming weights
+    void release_reverse() noexcept override;
+
     void print()     const noexcept override;
-    void print_raw() const noexcept override;
-    void toBinary(const std::string& filename, bool print = true) const;
+    void print_raw() const override;
+    /**
+     * @brief Write the graph in the sectioned binary format (v2), weights
+     *        included
+     */
+    void toBinary(const std::string& filename, bool print = true,
+                  bool checksum = false) const;
     void toMarket(const std::string& filename) const;
 
     using GraphBase<vid_t, eoff_t>::set_structure;
@@ -117,12 +120,25 @@ private:
     using GraphStd<vid_t, eoff_t>::_in_edges;
     using GraphStd<vid_t, eoff_t>::_out_degrees;
     using GraphStd<vid_t, eoff_t>::_in_degrees;
+    using GraphStd<vid_t, eoff_t>::_coo_edges;
     using GraphStd<vid_t, eoff_t>::_coo_size;
     using GraphStd<vid_t, eoff_t>::_seed;
-
-    coo_t*     _coo_edges    { nullptr };
+    using GraphStd<vid_t, eoff_t>::_binary_file;
+    using GraphStd<vid_t, eoff_t>::_mapped_csr;
+    using GraphStd<vid_t, eoff_t>::_id_map;
+    using GraphStd<vid_t, eoff_t>::lazy_reverse;
+    using GraphStd<vid_t, eoff_t>::_reverse_on_demand;
+    using GraphStd<vid_t, eoff_t>::relabelCOO;
+    using GraphStd<vid_t, eoff_t>::allocateRelabeled;
+    using GraphStd<vid_t, eoff_t>::reorderByProperty;
+
+    /**
+     * @brief Weights of the inherited `_coo_edges`, staged as a separate
+     *        array: the passes on (source, destination) only do not load them
+     */
+    weight_t*  _coo_weights  { nullptr };
     weight_t*  _out_weights  { nullptr };
-    weight_t*  _in_weights   { nullptr };
+    mutable weight_t* _in_weights { nullptr };
 
     using GraphBase<vid_t, eoff_t>::_structure;
     using GraphBase<vid_t, eoff_t>::_prop;
@@ -132,8 +148,11 @@ private:
     using GraphBase<vid_t, eoff_t>::_directed_to_undirected;
     using GraphBase<vid_t, eoff_t>::_undirected_to_directed;
     using GraphBase<vid_t, eoff_t>::_stored_undirected;
+    using GraphBase<vid_t, eoff_t>::_stored_weights;
 
     void allocate(const GInfo& ginfo) noexcept override;
+    void generateWeights(const EdgeGenerator<vid_t>& generator,
+                         size_t num_lines) override;
 
     void readMarket  (std::ifstream& fin, bool print)   override;
     void readDimacs9 (std::ifstream& fin, bool print)   override;
@@ -143,8 +162,43 @@ private:
     void readNetRepo (std::ifstream& fin)               override;
     void readMPG     (std::ifstream& fin, bool print)   override;
     void readBinary  (const char* filename, bool print) override;
+    void readReverseSections() const override;
+    void buildReverse() const override;
+    std::string class_id() const override;
+    void binary_sections(binary::Header& header,
+                         std::vector<binary::SectionData>& sections)
+                         const override;
+
+    void readMarket  (const char* start, const char* end, bool print)
+                      override;
+    void readDimacs9 (const char* start, const char* end, bool print)
+                      override;
+    void readDimacs10(const char* start, const char* end, bool print)
+                      override;
+    void readSnap    (const char* start, const char* end, bool print)
+                      override;
+    void readKonect  (const char* start, const char* end, bool print)
+                      override;
+    void readNetRepo (const char* start, const char* end) override;
+
+    void parseDimacs9 (const char* start, const char* end, size_t num_lines);
+    void parseKonect  (const char* start, const char* end, size_t num_lines);
+    void parseDimacs10(const char* start, const char* end, size_t num_lines,
+                       size_t num_edges);
+    ///@brief also allocates the graph (the vertices are relabeled)
+    void parseNetRepo (const char* start, const char* end);
+
+    /**
+     * @brief Sort the COO edges by (source, destination, weight). The weights
+     *        are the payload of the radix sort on (source, destination)
+     * @return number of edges after the (optional) duplicate removal
+     */
+    eoff_t sortCOO(bool remove_duplicates) noexcept;
 
     void COOtoCSR() noexcept override;
+
+    void permuteEdgeData(const eoff_t* out_map, const eoff_t* in_map)
+                         override;
 };
 
 } // namespace graph
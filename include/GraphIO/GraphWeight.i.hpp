@@ -42,6 +42,12 @@ namespace graph {
 ///        GRAPH WEIGHTS     ///
 ////////////////////////////////
 
+template<typename vid_t, typename eoff_t, typename weight_t>
+inline const weight_t*
+GraphWeight<vid_t, eoff_t, weight_t>::coo_weights_array() const noexcept {
+    return _coo_weights;
+}
+
 template<typename vid_t, typename eoff_t, typename weight_t>
 inline const weight_t*
 GraphWeight<vid_t, eoff_t, weight_t>::out_weights_array() const noexcept {
@@ -50,7 +56,8 @@ GraphWeight<vid_t, eoff_t, weight_t>::out_weights_array() const noexcept {
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 inline const weight_t*
-GraphWeight<vid_t, eoff_t, weight_t>::in_weights_array() const noexcept {
+GraphWeight<vid_t, eoff_t, weight_t>::in_weights_array() const {
+    lazy_reverse();
     return _in_weights;
 }
 
@@ -0,0 +1,117 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstddef>  //size_t
+#include <limits>   //std::numeric_limits
+
+namespace graph {
+
+/**
+ * @brief Dense relabeling of sparse vertex ids (SNAP, Network Repository).
+ *        Stores both directions of the mapping: original id → relabeled id
+ *        and relabeled id → original id
+ * @details The map is built with a parallel radix sort of the (id, position)
+ *          pairs followed by a parallel compaction, no hash table is
+ *          involved
+ */
+template<typename vid_t>
+class IdMap {
+public:
+    /**
+     * @brief relabeled_id() of an id which is not in the graph: the largest
+     *        value of `vid_t` for both signed and unsigned ids
+     */
+    static const vid_t NOT_FOUND = std::numeric_limits<vid_t>::max();
+
+    IdMap() = default;
+    ~IdMap() noexcept;
+    IdMap(const IdMap&)            = delete;
+    IdMap& operator=(const IdMap&) = delete;
+
+    /**
+     * @brief Relabel `num_keys` ids in the range [0, number of unique ids)
+     * @param[in] key_op `vid_t key_op(size_t i)`: i-th original id
+     * @param[in] write_op `void write_op(size_t i, vid_t new_id)`: store the
+     *            relabeled id of the i-th key. Called once for each key, in
+     *            parallel
+     * @param[in] first_appearance assign the new ids in order of first
+     *            appearance of the keys (stream order), otherwise in
+     *            ascending order of the original ids. The second one keeps
+     *            dense inputs unchanged
+     */
+    template<typename KeyOp, typename WriteOp>
+    void build(size_t num_keys, const KeyOp& key_op, const WriteOp& write_op,
+               bool first_appearance);
+
+    /**
+     * @brief Relabeled ids become `permutation[relabeled id]`
+     */
+    void permute(const vid_t* permutation) noexcept;
+
+    void clear() noexcept;
+
+    ///@brief number of unique ids
+    size_t size()  const noexcept;
+    ///@brief `true` if the ids have not been relabeled
+    bool   empty() const noexcept;
+
+    vid_t original_id(vid_t relabeled_id) const noexcept;
+    /**
+     * @return relabeled id of `original_id`, NOT_FOUND if it is not in the
+     *         graph
+     */
+    vid_t relabeled_id(vid_t original_id) const noexcept;
+
+    ///@brief original ids indexed by relabeled id
+    const vid_t* original_ids() const noexcept;
+
+private:
+    vid_t* _sorted_ids    { nullptr };  ///< original ids, ascending order
+    vid_t* _relabeled_ids { nullptr };  ///< relabeled id of `_sorted_ids[i]`
+    vid_t* _original_ids  { nullptr };  ///< indexed by relabeled id
+    size_t _size          { 0 };
+
+    template<typename pos_t, typename KeyOp, typename WriteOp>
+    void buildAux(size_t num_keys, const KeyOp& key_op,
+                  const WriteOp& write_op, bool first_appearance);
+};
+
+} // namespace graph
+
+#include "IdMap.i.hpp"
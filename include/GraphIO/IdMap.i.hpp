@@ -0,0 +1,156 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date April, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "Host/Algorithm.hpp"   //xlib::parallel_radix_sort, xlib::parallel_run
+#include "Host/Numeric.hpp"     //xlib::ceil_log2, xlib::check_overflow
+#include <algorithm>            //std::max, std::max_element
+#include <cstdint>              //uint32_t
+#include <limits>               //std::numeric_limits
+#include <numeric>              //std::iota, std::partial_sum
+#include <type_traits>          //std::make_unsigned
+#include <vector>               //std::vector
+
+namespace graph {
+
+template<typename vid_t>
+template<typename KeyOp, typename WriteOp>
+void IdMap<vid_t>::build(size_t num_keys, const KeyOp& key_op,
+                         const WriteOp& write_op, bool first_appearance) {
+    clear();
+    if (num_keys == 0)
+        return;
+    //32-bit positions halve the payload traffic of the radix sort
+    if (num_keys <= std::numeric_limits<uint32_t>::max())
+        buildAux<uint32_t>(num_keys, key_op, write_op, first_appearance);
+    else
+        buildAux<size_t>(num_keys, key_op, write_op, first_appearance);
+}
+
+template<typename vid_t>
+template<typename pos_t, typename KeyOp, typename WriteOp>
+void IdMap<vid_t>::buildAux(size_t num_keys, const KeyOp& key_op,
+                            const WriteOp& write_op, bool first_appearance) {
+    using unsigned_t = typename std::make_unsigned<vid_t>::type;
+    int  num_threads = xlib::num_threads();
+    auto keys        = new unsigned_t[num_keys];
+    auto positions   = new pos_t[num_keys];
+    std::vector<unsigned_t> thread_max(num_threads, 0);
+    xlib::parallel_run([&](int thread_id, int n) {
+            auto start = xlib::thread_chunk(num_keys, thread_id, n);
+            auto   end = xlib::thread_chunk(num_keys, thread_id + 1, n);
+            unsigned_t max_key = 0;
+            for (auto i = start; i < end; i++) {
+                keys[i]      = static_cast<unsigned_t>(key_op(i));
+                positions[i] = static_cast<pos_t>(i);
+                max_key      = std::max(max_key, keys[i]);
+            }
+            thread_max[thread_id] = max_key;
+        }, num_threads);
+    auto max_key = *std::max_element(thread_max.begin(), thread_max.end());
+    //the sort is stable: the first position of each id is its first
+    //appearance
+    xlib::parallel_radix_sort(keys, positions, num_keys,
+                              xlib::log2(std::max(max_key, unsigned_t(1))) + 1);
+
+    //compaction: one segment of the sorted keys for each unique id
+    const auto& is_head = [&](size_t i) {
+                                return i == 0 || keys[i] != keys[i - 1];
+                            };
+    std::vector<size_t> thread_offsets(num_threads + 1, 0);
+    xlib::parallel_run([&](int thread_id, int n) {
+            auto start = xlib::thread_chunk(num_keys, thread_id, n);
+            auto   end = xlib::thread_chunk(num_keys, thread_id + 1, n);
+            size_t count = 0;
+            for (auto i = start; i < end; i++)
+                count += is_head(i);
+            thread_offsets[thread_id + 1] = count;
+        }, num_threads);
+    std::partial_sum(thread_offsets.begin(), thread_offsets.end(),
+                     thread_offsets.begin());
+    _size = thread_offsets[num_threads];
+    xlib::check_overflow<vid_t>(_size);
+
+    _sorted_ids    = new vid_t[_size];
+    _relabeled_ids = new vid_t[_size];
+    _original_ids  = new vid_t[_size];
+    auto first_positions = new pos_t[_size];
+    //`op(i, segment)` for each sorted key
+    const auto& segment_run = [&](const auto& op) {
+        xlib::parallel_run([&](int thread_id, int n) {
+                auto start = xlib::thread_chunk(num_keys, thread_id, n);
+                auto   end = xlib::thread_chunk(num_keys, thread_id + 1, n);
+                auto  next = thread_offsets[thread_id];
+                auto  segment = next - 1;   //valid if keys[start] is no head
+                for (auto i = start; i < end; i++) {
+                    if (is_head(i))
+                        segment = next++;
+                    op(i, segment);
+                }
+            }, num_threads);
+    };
+    segment_run([&](size_t i, size_t segment) {
+                    if (is_head(i)) {
+                        _sorted_ids[segment]      = static_cast<vid_t>(keys[i]);
+                        first_positions[segment] = positions[i];
+                    }
+                });
+
+    if (first_appearance) {
+        auto order = new vid_t[_size];
+        std::iota(order, order + _size, 0);
+        xlib::parallel_radix_sort(first_positions, order, _size,
+                                  std::max(xlib::ceil_log2(num_keys), 1));
+        xlib::parallel_run([&](int thread_id, int n) {
+                auto start = xlib::thread_chunk(_size, thread_id, n);
+                auto   end = xlib::thread_chunk(_size, thread_id + 1, n);
+                for (auto i = start; i < end; i++)
+                    _relabeled_ids[order[i]] = static_cast<vid_t>(i);
+            }, num_threads);
+        delete[] order;
+    }
+    else
+        std::iota(_relabeled_ids, _relabeled_ids + _size, 0);
+
+    for (size_t i = 0; i < _size; i++)
+        _original_ids[_relabeled_ids[i]] = _sorted_ids[i];
+    segment_run([&](size_t i, size_t segment) {
+                    write_op(positions[i], _relabeled_ids[segment]);
+                });
+    delete[] first_positions;
+    delete[] positions;
+    delete[] keys;
+}
+
+} // namespace graph
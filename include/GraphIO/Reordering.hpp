@@ -0,0 +1,78 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 Hornet. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ *
+ * @file
+ */
+#pragma once
+
+#include <cstddef>  //size_t
+
+namespace graph {
+
+/**
+ * @brief Vertex orderings which improve the locality of the graph
+ *        traversals (GraphStd::reorder())
+ */
+enum class Reordering {
+    DEGREE,     ///< decreasing out-degree
+    RCM,        ///< Reverse Cuthill-McKee
+    BFS,        ///< breadth-first visit order
+    COMMUNITY   ///< Rabbit-order-style community grouping
+};
+
+/**
+ * @brief Permutation of the vertices for the ordering `type`, computed on the
+ *        out-edges CSR
+ * @details
+ * - DEGREE: stable parallel radix sort of the degrees
+ * - BFS, RCM: level-synchronous parallel visit which returns the same order
+ *   of the sequential visit. Each connected component starts from the
+ *   unvisited vertex of largest (BFS) or smallest (RCM) degree. RCM visits
+ *   the children of a vertex by increasing degree and reverses the order
+ * - COMMUNITY: vertices in increasing degree order join the neighbor
+ *   community of largest modularity gain (as the merge phase of Rabbit
+ *   order, without edge aggregation). The communities are laid out by root
+ *   id, the vertices of a community by joining order. The sweep is
+ *   sequential
+ *
+ * The result does not depend on the number of threads
+ * @param[out] permutation new id of each vertex (`num_vertices` items)
+ */
+template<typename vid_t, typename eoff_t>
+void reorder_permutation(Reordering type, const eoff_t* offsets,
+                         const vid_t* edges, size_t num_vertices,
+                         vid_t* permutation);
+
+} // namespace graph
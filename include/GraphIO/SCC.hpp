@@ -44,10 +44,12 @@
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
+///@brief runs on GraphStd or on GraphCompressed (`graph_t`), see BFS
+template<typename vid_t, typename eoff_t,
+         typename graph_t = GraphStd<vid_t, eoff_t>>
 class SCC {
 public:
-    explicit SCC(const GraphStd<vid_t, eoff_t>& _graph) noexcept;
+    explicit SCC(const graph_t& _graph) noexcept;
     ~SCC() noexcept;
 
     void run() noexcept;
@@ -86,8 +88,8 @@ private:
     const   vid_t NO_INDEX = std::numeric_limits<vid_t>::max();
     const   vid_t MAX_LINK = std::numeric_limits<vid_t>::max();
 
-    const GraphStd<vid_t, eoff_t>& _graph;
-    std::vector<vid_t>             _scc_vector;
+    const graph_t&     _graph;
+    std::vector<vid_t> _scc_vector;
 
     xlib::Bitmask                               _in_stack;
     xlib::Queue<vid_t, xlib::QueuePolicy::LIFO> _queue;
@@ -44,14 +44,17 @@
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
+///@brief runs on GraphStd or on GraphCompressed (`graph_t`), see BFS
+template<typename vid_t, typename eoff_t,
+         typename graph_t = GraphStd<vid_t, eoff_t>>
 class WCC {
     using color_t = vid_t;
 public:
-    explicit WCC(const GraphStd<vid_t, eoff_t>& graph) noexcept;
+    explicit WCC(const graph_t& graph) noexcept;
     ~WCC() noexcept;
 
-    void run() noexcept;
+    ///@details directed graphs: the reverse CSR is built on first access
+    void run();
 
     const std::vector<vid_t>& list() const noexcept;
 
@@ -73,10 +76,10 @@ public:
 private:
     const color_t NO_COLOR = std::numeric_limits<color_t>::max();
 
-    const GraphStd<vid_t, eoff_t>& _graph;
-    xlib::Queue<vid_t>             _queue;
-    std::vector<vid_t>             _wcc_vector;
-    color_t*                       _color { nullptr };
+    const graph_t&     _graph;
+    xlib::Queue<vid_t> _queue;
+    std::vector<vid_t> _wcc_vector;
+    color_t*           _color { nullptr };
 };
 
 } // namespace graph
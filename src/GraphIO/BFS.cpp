@@ -34,94 +34,878 @@
  * </blockquote>}
  */
 #include "GraphIO/BFS.hpp"
+#include "GraphIO/GraphCompressed.hpp"
+#include "Host/Algorithm.hpp"  //xlib::parallel_run, xlib::thread_chunk
+#include "Host/Numeric.hpp"    //xlib::ceil_div
+#include <algorithm>           //std::upper_bound, std::min_element
+#include <thread>              //std::this_thread::yield
 
 namespace graph {
+namespace {
 
-template<typename vid_t, typename eoff_t>
-BFS<vid_t, eoff_t>::BFS(const GraphStd<vid_t, eoff_t>& graph) noexcept :
-                                            _graph(graph),
-                                            _bitmask(graph.nV()),
-                                            _queue(graph.nV()) {
-    _distances = new int[graph.nV()];
+/**
+ * @brief Top-down levels with fewer frontier edges are expanded by one
+ *        thread, the parallel region starts at the first larger level
+ * @details measured (1M vertices, 8M edges): ~90 edges/us of serial
+ *          expansion, ~1.7 us per barrier and ~13 us to start 4 threads.
+ *          A parallel level pays three barriers and the atomic visits
+ *          (about half the serial rate per thread): at 16K edges (~180 us
+ *          serial) the synchronization is a few percent of the level
+ */
+const size_t MIN_PARALLEL_EDGES = 16384;
+
+/**
+ * @brief Minimum number of visited vertices to update the eccentricity bounds
+ *        of boundEccentricities() in parallel
+ * @details the update is a few memory accesses per vertex: at 64K vertices
+ *          it takes some hundreds of us and starting the threads (~13 us) is
+ *          a small fraction of it
+ */
+const size_t MIN_PARALLEL_VERTICES = 65536;
+
+/**
+ * @brief Sense-reversing barrier of the persistent parallel region: the
+ *        threads spin and then yield
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int num_threads) noexcept :
+                                            _num_threads(num_threads) {}
+
+    void wait() noexcept {
+        bool sense = _sense.load(std::memory_order_relaxed);
+        if (_count.fetch_add(1, std::memory_order_acq_rel) ==
+                _num_threads - 1) {
+            _count.store(0, std::memory_order_relaxed);
+            _sense.store(!sense, std::memory_order_release);
+            return;
+        }
+        for (int i = 0; _sense.load(std::memory_order_acquire) == sense; i++) {
+            if (i >= SPIN_ITERATIONS)
+                std::this_thread::yield();
+        }
+    }
+private:
+    static const int SPIN_ITERATIONS = 1024;
+    std::atomic<int>  _count { 0 };
+    std::atomic<bool> _sense { false };
+    const int         _num_threads;
+};
+
+} // namespace
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+BFS<vid_t, eoff_t, graph_t>::BFS(const graph_t& graph, Mode mode,
+                                 int num_threads) noexcept :
+                                   _graph(graph),
+                                   _bitmask(graph.nV()),
+                                   _queue(graph.nV()),
+                                   _mode(mode),
+                                   _num_threads(std::max(std::min(num_threads,
+                                                    xlib::num_threads()), 1)) {
+    auto nV    = static_cast<size_t>(graph.nV());
+    _distances = new int[nV];
+    if (_num_threads > 1) {
+        auto num_words    = xlib::ceil_div<64>(nV);
+        _visited_words    = new std::atomic<uint64_t>[num_words];
+        _frontier_words   = new std::atomic<uint64_t>[num_words];
+        _frontier_offsets = new eoff_t[nV + 1];
+        _local_frontiers.resize(static_cast<size_t>(_num_threads));
+        //the bottom-up levels clear only the bits of their frontier
+        for (size_t i = 0; i < num_words; i++)
+            _frontier_words[i].store(0, std::memory_order_relaxed);
+    }
+    else if (mode == Mode::DIRECTION_OPTIMIZING)
+        _frontier.init(nV);
     reset();
 }
 
-template<typename vid_t, typename eoff_t>
-BFS<vid_t, eoff_t>::~BFS() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+BFS<vid_t, eoff_t, graph_t>::~BFS() noexcept {
     delete[] _distances;
+    delete[] _visited_words;
+    delete[] _frontier_words;
+    delete[] _frontier_offsets;
+    delete[] _seen_masks;
+    delete[] _visit_masks;
+    delete[] _next_masks;
 }
 
-template<typename vid_t, typename eoff_t>
-void BFS<vid_t, eoff_t>::run(vid_t source) noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::run(vid_t source) {
     if (!_reset)
         ERROR("BFS must be reset before the next run")
+    if (_num_threads > 1)
+        runParallel(source);
+    else if (_mode == Mode::DIRECTION_OPTIMIZING)
+        runDirectionOptimizing(source);
+    else
+        runTopDown(source);
+    _reset = false;
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::runTopDown(vid_t source) noexcept {
+    const auto out_degree = _graph.out_degrees_ptr();
     _queue.insert(source);
     _bitmask[source]   = true;
     _distances[source] = 0;
 
     while (!_queue.empty()) {
         auto current = _queue.extract();
-        for (eoff_t j = _graph._out_offsets[current];
-                j < _graph._out_offsets[current + 1]; j++) {
-            auto dest = _graph._out_edges[j];
-            if (!_bitmask[dest]) {
-                _bitmask[dest]   = true;
-                _distances[dest] = _distances[current] + 1;
-                _queue.insert(dest);
+        _visited_edges += out_degree[current];
+        _graph.for_each_out(current, [&](vid_t dest) {
+                if (!_bitmask[dest]) {
+                    _bitmask[dest]   = true;
+                    _distances[dest] = _distances[current] + 1;
+                    _queue.insert(dest);
+                }
+            });
+    }
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::runDirectionOptimizing(vid_t source) {
+    const auto out_degree = _graph.out_degrees_ptr();
+    const auto& in_frontier = [&](vid_t u) { return _frontier[u]; };
+    auto nV = static_cast<size_t>(_graph.nV());
+    _queue.insert(source);
+    _bitmask[source]   = true;
+    _distances[source] = 0;
+    //the queue holds the vertices of each level, in both directions
+    eoff_t frontier_edges   = out_degree[source];
+    eoff_t unexplored_edges = _graph.nE() - frontier_edges;
+    size_t previous_size    = 0;
+    bool   bottom_up        = false;
+
+    for (dist_t level = 0; !_queue.empty(); level++) {
+        auto frontier_size = _queue.size();
+        if (!bottom_up)
+            bottom_up = frontier_edges > unexplored_edges / ALPHA;
+        else {
+            bottom_up = frontier_size >= previous_size ||
+                        frontier_size > nV / BETA;
+        }
+        previous_size  = frontier_size;
+        frontier_edges = 0;
+        if (bottom_up) {
+            _frontier.clear();
+            for (size_t i = 0; i < frontier_size; i++)
+                _frontier[_queue.extract()] = true;
+            eoff_t examined = 0;
+            for (vid_t v = 0; v < _graph.nV(); v++) {
+                if (_bitmask[v])
+                    continue;
+                auto in_degree = _graph.in_degree(v);
+                auto  position = _graph.find_in(v, in_frontier);
+                if (position < in_degree) {
+                    _bitmask[v]     = true;
+                    _distances[v]   = level + 1;
+                    frontier_edges += out_degree[v];
+                    _queue.insert(v);
+                    examined += position + 1;
+                }
+                else
+                    examined += in_degree;
+            }
+            _visited_edges += examined;
+        }
+        else {
+            for (size_t i = 0; i < frontier_size; i++) {
+                auto current = _queue.extract();
+                _visited_edges += out_degree[current];
+                _graph.for_each_out(current, [&](vid_t dest) {
+                        if (!_bitmask[dest]) {
+                            _bitmask[dest]   = true;
+                            _distances[dest] = level + 1;
+                            frontier_edges  += out_degree[dest];
+                            _queue.insert(dest);
+                        }
+                    });
+            }
+        }
+        unexplored_edges -= frontier_edges;
+    }
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::runParallel(vid_t source) {
+    const bool direction_optimizing = _mode == Mode::DIRECTION_OPTIMIZING;
+    const auto out_degree = _graph.out_degrees_ptr();
+    auto nV        = static_cast<size_t>(_graph.nV());
+    auto num_words = xlib::ceil_div<64>(nV);
+    //the reverse CSR is built by the calling thread, not by the workers of
+    //a bottom-up level, such that an allocation failure reaches the caller
+    if (direction_optimizing)
+        _graph.in_degree(source);
+
+    const auto& visit = [&](vid_t vertex) {
+            auto& word = _visited_words[static_cast<size_t>(vertex) / 64];
+            auto  mask = uint64_t(1) << (static_cast<size_t>(vertex) % 64);
+            if (word.load(std::memory_order_relaxed) & mask)
+                return false;
+            return (word.fetch_or(mask, std::memory_order_relaxed) & mask) ==
+                   0;
+        };
+    //levels expanded by a single thread: no read-modify-write
+    const auto& visit_serial = [&](vid_t vertex) {
+            auto& word = _visited_words[static_cast<size_t>(vertex) / 64];
+            auto  mask = uint64_t(1) << (static_cast<size_t>(vertex) % 64);
+            auto value = word.load(std::memory_order_relaxed);
+            if (value & mask)
+                return false;
+            word.store(value | mask, std::memory_order_relaxed);
+            return true;
+        };
+    const auto& in_frontier = [&](vid_t vertex) {
+            auto u = static_cast<size_t>(vertex);
+            return (_frontier_words[u / 64].load(std::memory_order_relaxed) &
+                    (uint64_t(1) << (u % 64))) != 0;
+        };
+    visit_serial(source);
+    _distances[source] = 0;
+    _queue.insert(source);
+    vid_t* queue = &_queue.at(0);
+    _frontier_offsets[0] = 0;
+    _frontier_offsets[1] = out_degree[source];
+
+    //level state, each thread of the team holds a copy
+    struct LevelState {
+        dist_t level;
+        size_t begin, end, previous_size;
+        eoff_t frontier_edges, unexplored_edges;
+        bool   bottom_up;
+    };
+    LevelState state { 0, 0, 1, 0, out_degree[source],
+                       _graph.nE() - out_degree[source], false };
+
+    const auto& choose_direction = [&](LevelState& s) {
+            auto frontier_size = s.end - s.begin;
+            if (direction_optimizing) {
+                if (!s.bottom_up)
+                    s.bottom_up = s.frontier_edges > s.unexplored_edges / ALPHA;
+                else {
+                    s.bottom_up = frontier_size >= s.previous_size ||
+                                  frontier_size > nV / BETA;
+                }
+            }
+            s.previous_size = frontier_size;
+        };
+    const auto& is_parallel = [&](const LevelState& s) {
+            return s.bottom_up ||
+                   static_cast<size_t>(s.frontier_edges) >= MIN_PARALLEL_EDGES;
+        };
+    //the next frontier and the prefix sum of its out-degrees are written
+    //after the current one
+    const auto& expand_serial = [&](const LevelState& s, size_t& next_size,
+                                    eoff_t& next_edges, eoff_t& examined) {
+            next_size = 0, next_edges = 0, examined = 0;
+            for (auto i = s.begin; i < s.end; i++) {
+                auto u    = queue[i];
+                examined += out_degree[u];
+                _graph.for_each_out(u, [&](vid_t v) {
+                        if (visit_serial(v)) {
+                            _distances[v] = s.level + 1;
+                            next_edges   += out_degree[v];
+                            queue[s.end + next_size] = v;
+                            _frontier_offsets[++next_size] = next_edges;
+                        }
+                    });
+            }
+            _queue.append(next_size);
+        };
+    const auto& advance = [&](LevelState& s, size_t next_size,
+                              eoff_t next_edges) {
+            s.unexplored_edges -= next_edges;
+            s.frontier_edges    = next_edges;
+            s.begin             = s.end;
+            s.end              += next_size;
+            s.level++;
+            choose_direction(s);
+        };
+    choose_direction(state);
+    //the calling thread expands the levels until the first large one
+    while (state.begin < state.end && !is_parallel(state)) {
+        size_t next_size;
+        eoff_t next_edges, examined;
+        expand_serial(state, next_size, next_edges, examined);
+        _visited_edges += examined;
+        advance(state, next_size, next_edges);
+    }
+    if (state.begin == state.end)
+        return;
+    //--------------------------------------------------------------------------
+    //persistent parallel region up to the end of the visit. The per-thread
+    //partial results are double-buffered by level parity: they are read after
+    //the last barrier of a level and written before the first one of the next
+    auto num_partials = static_cast<size_t>(_num_threads) * 2;
+    std::vector<size_t> partial_sizes(num_partials);
+    std::vector<eoff_t> partial_edges(num_partials);
+    std::vector<eoff_t> partial_examined(num_partials);
+    SpinBarrier barrier(_num_threads);
+
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+        auto  s     = state;
+        auto& local = _local_frontiers[thread_id];
+        while (s.begin < s.end) {
+            auto frontier      = queue + s.begin;
+            auto frontier_size = s.end - s.begin;
+            auto parity        = static_cast<size_t>(s.level % 2) *
+                                 static_cast<size_t>(num_threads);
+            auto slot          = parity + static_cast<size_t>(thread_id);
+            bool team_level    = is_parallel(s);
+            local.clear();
+            if (!team_level) {
+                //small level: thread 0 writes the next frontier in place
+                partial_sizes[slot]    = 0;
+                partial_edges[slot]    = 0;
+                partial_examined[slot] = 0;
+                if (thread_id == 0) {
+                    expand_serial(s, partial_sizes[slot], partial_edges[slot],
+                                  partial_examined[slot]);
+                }
+            }
+            else if (s.bottom_up) {
+                auto start = xlib::thread_chunk(frontier_size, thread_id,
+                                                num_threads);
+                auto  stop = xlib::thread_chunk(frontier_size, thread_id + 1,
+                                                num_threads);
+                for (auto i = start; i < stop; i++) {
+                    auto vertex = static_cast<size_t>(frontier[i]);
+                    _frontier_words[vertex / 64].fetch_or(
+                                uint64_t(1) << (vertex % 64),
+                                std::memory_order_relaxed);
+                }
+                barrier.wait();
+                //each thread owns a range of visited words
+                eoff_t next_edges = 0, examined = 0;
+                auto first = xlib::thread_chunk(num_words, thread_id,
+                                                num_threads);
+                auto  last = xlib::thread_chunk(num_words, thread_id + 1,
+                                                num_threads);
+                for (auto i = first; i < last; i++) {
+                    auto unvisited = ~_visited_words[i].load(
+                                            std::memory_order_relaxed);
+                    if (i == num_words - 1 && nV % 64 != 0)
+                        unvisited &= (uint64_t(1) << (nV % 64)) - 1;
+                    uint64_t found = 0;
+                    for (; unvisited != 0; unvisited &= unvisited - 1) {
+                        auto bit = static_cast<size_t>(
+                                            __builtin_ctzll(unvisited));
+                        auto   v = static_cast<vid_t>(i * 64 + bit);
+                        auto in_degree = _graph.in_degree(v);
+                        auto  position = _graph.find_in(v, in_frontier);
+                        if (position < in_degree) {
+                            found        |= uint64_t(1) << bit;
+                            _distances[v] = s.level + 1;
+                            next_edges   += out_degree[v];
+                            local.push_back(v);
+                            examined     += position + 1;
+                        }
+                        else
+                            examined += in_degree;
+                    }
+                    if (found != 0) {
+                        _visited_words[i].fetch_or(found,
+                                                   std::memory_order_relaxed);
+                    }
+                }
+                partial_sizes[slot]    = local.size();
+                partial_edges[slot]    = next_edges;
+                partial_examined[slot] = examined;
+            }
+            else {
+                //each thread expands an equal range of frontier edges, such
+                //that the high-degree vertices are shared
+                eoff_t next_edges = 0;
+                auto first = xlib::thread_chunk(s.frontier_edges, thread_id,
+                                                num_threads);
+                auto  last = xlib::thread_chunk(s.frontier_edges,
+                                                thread_id + 1, num_threads);
+                auto     i = std::upper_bound(_frontier_offsets,
+                                              _frontier_offsets + frontier_size,
+                                              first) - _frontier_offsets - 1;
+                for (auto e = first; e < last; i++) {
+                    auto stop = std::min(last, _frontier_offsets[i + 1]);
+                    _graph.for_each_out(frontier[i],
+                            static_cast<degree_t>(e - _frontier_offsets[i]),
+                            static_cast<degree_t>(stop - _frontier_offsets[i]),
+                            [&](vid_t v) {
+                                if (visit(v)) {
+                                    _distances[v] = s.level + 1;
+                                    next_edges   += out_degree[v];
+                                    local.push_back(v);
+                                }
+                            });
+                    e = stop;
+                }
+                partial_sizes[slot]    = local.size();
+                partial_edges[slot]    = next_edges;
+                partial_examined[slot] = last - first;
+            }
+            barrier.wait();
+            size_t base_size = 0, next_size = 0;
+            eoff_t base_edges = 0, next_edges = 0, examined = 0;
+            for (int t = 0; t < num_threads; t++) {
+                auto k = parity + static_cast<size_t>(t);
+                if (t == thread_id) {
+                    base_size  = next_size;
+                    base_edges = next_edges;
+                }
+                next_size  += partial_sizes[k];
+                next_edges += partial_edges[k];
+                examined   += partial_examined[k];
+            }
+            if (team_level) {
+                //merge of the local frontiers at the tail of the queue
+                auto next = queue + s.end + base_size;
+                for (size_t j = 0; j < local.size(); j++) {
+                    auto v      = local[j];
+                    base_edges += out_degree[v];
+                    next[j]     = v;
+                    _frontier_offsets[base_size + j + 1] = base_edges;
+                }
+                if (s.bottom_up) {
+                    //only the words of the frontier are cleared
+                    auto start = xlib::thread_chunk(frontier_size, thread_id,
+                                                    num_threads);
+                    auto  stop = xlib::thread_chunk(frontier_size,
+                                                    thread_id + 1,
+                                                    num_threads);
+                    for (auto j = start; j < stop; j++) {
+                        auto vertex = static_cast<size_t>(frontier[j]);
+                        _frontier_words[vertex / 64].store(0,
+                                                    std::memory_order_relaxed);
+                    }
+                }
+                if (thread_id == 0)
+                    _queue.append(next_size);
+                barrier.wait();
+            }
+            if (thread_id == 0)
+                _visited_edges += examined;
+            advance(s, next_size, next_edges);
+        }
+    }, _num_threads);
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::run(const vid_t* sources, int num_sources,
+                                      dist_t max_distance) noexcept {
+    if (!_reset)
+        ERROR("BFS must be reset before the next run")
+    const auto out_degree = _graph.out_degrees_ptr();
+    auto nV          = static_cast<size_t>(_graph.nV());
+    auto size        = static_cast<size_t>(std::max(num_sources, 0));
+    auto num_workers = static_cast<int>(std::max(std::min(
+                            xlib::ceil_div<64>(size),
+                            static_cast<size_t>(_num_threads)), size_t(1)));
+    if (_mask_workers < num_workers) {
+        delete[] _seen_masks;
+        delete[] _visit_masks;
+        delete[] _next_masks;
+        auto num_masks = nV * static_cast<size_t>(num_workers);
+        _seen_masks   = new uint64_t[num_masks]();
+        _visit_masks  = new uint64_t[num_masks]();
+        _next_masks   = new uint64_t[num_masks]();
+        _mask_workers = num_workers;
+    }
+    _eccentricities.assign(size, 0);
+    _reached_nodes.assign(size, 1);
+    _distance_sums.assign(size, 0);
+    std::atomic<size_t> next_batch { 0 };
+    std::vector<eoff_t> partial_edges(static_cast<size_t>(num_workers));
+
+    //the batches of 64 sources are assigned dynamically to the workers, each
+    //worker with its own masks. `discover(vertex, distance)` records the
+    //distance from the nearest source
+    const auto& traverse = [&](int worker, const auto& discover) {
+        auto offset       = nV * static_cast<size_t>(worker);
+        auto seen_masks   = _seen_masks + offset;
+        auto visit_masks  = _visit_masks + offset;
+        auto next_masks   = _next_masks + offset;
+        eoff_t visited_edges = 0;
+        std::vector<vid_t> frontier, candidates, batch_vertices;
+
+        for (auto batch = next_batch.fetch_add(64); batch < size;
+             batch = next_batch.fetch_add(64)) {
+            auto batch_size = std::min(size - batch, size_t(64));
+            frontier.clear();
+            batch_vertices.clear();
+            for (size_t i = 0; i < batch_size; i++) {
+                auto source = sources[batch + i];
+                if (seen_masks[source] == 0) {
+                    frontier.push_back(source);
+                    batch_vertices.push_back(source);
+                }
+                seen_masks[source]  |= uint64_t(1) << i;
+                visit_masks[source] |= uint64_t(1) << i;
+                discover(source, 0);
+            }
+            for (dist_t level = 1; !frontier.empty() && level <= max_distance;
+                 level++) {
+                //the visit masks of the frontier are propagated to the
+                //neighbors
+                candidates.clear();
+                for (auto v : frontier) {
+                    auto visit     = visit_masks[v];
+                    visit_masks[v] = 0;
+                    visited_edges += out_degree[v];
+                    _graph.for_each_out(v, [&](vid_t dest) {
+                            if (next_masks[dest] == 0)
+                                candidates.push_back(dest);
+                            next_masks[dest] |= visit;
+                        });
+                }
+                //the sources not yet seen by a neighbor form the next
+                //frontier
+                frontier.clear();
+                for (auto v : candidates) {
+                    auto discovered = next_masks[v] & ~seen_masks[v];
+                    next_masks[v]   = 0;
+                    if (discovered == 0)
+                        continue;
+                    if (seen_masks[v] == 0)
+                        batch_vertices.push_back(v);
+                    seen_masks[v] |= discovered;
+                    visit_masks[v] = discovered;
+                    frontier.push_back(v);
+                    discover(v, level);
+                    for (; discovered != 0; discovered &= discovered - 1) {
+                        auto k = batch + static_cast<size_t>(
+                                                __builtin_ctzll(discovered));
+                        _eccentricities[k]  = level;
+                        _reached_nodes[k]++;
+                        _distance_sums[k]  += static_cast<uint64_t>(level);
+                    }
+                }
+            }
+            for (auto v : batch_vertices) {
+                seen_masks[v]  = 0;
+                visit_masks[v] = 0;
             }
         }
+        partial_edges[static_cast<size_t>(worker)] = visited_edges;
+    };
+
+    if (num_workers == 1) {
+        traverse(0, [&](vid_t vertex, dist_t distance) {
+                if (!_bitmask[vertex]) {
+                    _bitmask[vertex] = true;
+                    _queue.insert(vertex);
+                }
+                _distances[vertex] = std::min(_distances[vertex], distance);
+            });
+    }
+    else {
+        xlib::parallel_run([&](int worker, int) {
+                auto& reached = _local_frontiers[worker];
+                reached.clear();
+                traverse(worker, [&](vid_t vertex, dist_t distance) {
+                        auto& word = _visited_words[
+                                            static_cast<size_t>(vertex) / 64];
+                        auto  mask = uint64_t(1) <<
+                                     (static_cast<size_t>(vertex) % 64);
+                        if ((word.fetch_or(mask, std::memory_order_relaxed) &
+                                mask) == 0) {
+                            reached.push_back(vertex);
+                        }
+                        //atomic minimum
+                        auto ptr     = _distances + vertex;
+                        auto current = __atomic_load_n(ptr, __ATOMIC_RELAXED);
+                        while (distance < current &&
+                               !__atomic_compare_exchange_n(ptr, &current,
+                                        distance, true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {}
+                    });
+            }, num_workers);
+        for (int i = 0; i < num_workers; i++) {
+            const auto& reached = _local_frontiers[i];
+            std::copy(reached.begin(), reached.end(),
+                      _queue.append(reached.size()));
+        }
     }
+    for (auto edges : partial_edges)
+        _visited_edges += edges;
     _reset = false;
 }
 
-template<typename vid_t, typename eoff_t>
-void BFS<vid_t, eoff_t>::reset() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::runAllSources() noexcept {
+    auto sources = largestComponent();
+    reset();
+    run(sources.data(), static_cast<int>(sources.size()));
+    _bfs_runs = static_cast<int>(xlib::ceil_div<64>(sources.size()));
+}
+
+/**
+ * @details exact Takes-Kosters bounding algorithm (undirected graphs). Every
+ *          BFS from `v` bounds the eccentricity of each reached vertex `w` to
+ *          [max(ecc(v) - d(v, w), d(v, w)), ecc(v) + d(v, w)], the next
+ *          source is a vertex with extreme bounds and the vertices that
+ *          cannot change the result are discarded. The first BFS runs from
+ *          the highest-degree vertex of the component, the second from its
+ *          farthest vertex (double sweep). The components, the BFS runs and
+ *          the updates of the bounds use the threads of the object, the BFS
+ *          runs its Mode
+ */
+template<typename vid_t, typename eoff_t, typename graph_t>
+typename BFS<vid_t, eoff_t, graph_t>::dist_t
+BFS<vid_t, eoff_t, graph_t>::boundEccentricities(bool radius) {
+    const auto out_degree = _graph.out_degrees_ptr();
+    auto nV = static_cast<size_t>(_graph.nV());
+    //--------------------------------------------------------------------------
+    // initial bounds of the largest component: 1 <= ecc(w) <= |component| - 1
+    auto candidates = largestComponent();
+    _bfs_runs = 0;
+    if (candidates.size() <= 1)
+        return 0;
+    std::vector<dist_t> lower(nV, 1),
+                        upper(nV, static_cast<dist_t>(candidates.size() - 1));
+    //--------------------------------------------------------------------------
+    dist_t diameter_low = 0, radius_up = INF;
+    const auto& sweep = [&](vid_t source) {
+            reset();
+            run(source);
+            _bfs_runs++;
+            auto visited  = static_cast<size_t>(visited_nodes());
+            auto farthest = _queue.at(visited - 1);
+            auto ecc      = _distances[farthest];
+            auto queue    = &_queue.at(0);
+            auto threads  = visited < MIN_PARALLEL_VERTICES ? 1 : _num_threads;
+            xlib::parallel_run([&](int thread_id, int num_threads) {
+                    auto start = xlib::thread_chunk(visited, thread_id,
+                                                    num_threads);
+                    auto  stop = xlib::thread_chunk(visited, thread_id + 1,
+                                                    num_threads);
+                    for (auto i = start; i < stop; i++) {
+                        auto w   = queue[i];
+                        auto d   = _distances[w];
+                        lower[w] = std::max(lower[w], std::max(ecc - d, d));
+                        upper[w] = std::min(upper[w], ecc + d);
+                    }
+                }, threads);
+            diameter_low = std::max(diameter_low, ecc);
+            radius_up    = std::min(radius_up, ecc);
+            return farthest;
+        };
+    //double sweep from the highest-degree vertex of the component
+    sweep(sweep(*std::max_element(candidates.begin(), candidates.end(),
+                                  [&](vid_t a, vid_t b) {
+                                      return out_degree[a] < out_degree[b];
+                                  })));
+
+    for (bool largest_upper = true; ; largest_upper = !largest_upper) {
+        //the candidates which cannot change the result are discarded
+        size_t size = 0;
+        for (auto w : candidates) {
+            if (lower[w] == upper[w]) {
+                diameter_low = std::max(diameter_low, lower[w]);
+                radius_up    = std::min(radius_up, lower[w]);
+            }
+            else if (radius ? lower[w] < radius_up : upper[w] > diameter_low)
+                candidates[size++] = w;
+        }
+        candidates.resize(size);
+        if (candidates.empty())
+            break;
+        //next source: largest upper (diameter only) or smallest lower bound,
+        //the highest degree on ties
+        const auto& less = [&](vid_t a, vid_t b) {
+                auto key_a = largest_upper && !radius ? -upper[a] : lower[a];
+                auto key_b = largest_upper && !radius ? -upper[b] : lower[b];
+                return key_a < key_b ||
+                       (key_a == key_b && out_degree[a] > out_degree[b]);
+            };
+        sweep(*std::min_element(candidates.begin(), candidates.end(), less));
+    }
+    return radius ? radius_up : diameter_low;
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::weakComponents(std::vector<vid_t>& labels)
+                                                 noexcept {
+    auto nV = static_cast<size_t>(_graph.nV());
+    std::vector<std::atomic<vid_t>> parent(nV);
+    labels.resize(nV);
+    //path halving: a parent is replaced by one of its ancestors
+    const auto& find = [&](vid_t v) {
+            auto p = parent[v].load(std::memory_order_relaxed);
+            while (p != v) {
+                auto grandparent = parent[p].load(std::memory_order_relaxed);
+                parent[v].store(grandparent, std::memory_order_relaxed);
+                v = grandparent;
+                p = parent[v].load(std::memory_order_relaxed);
+            }
+            return v;
+        };
+    //the root with the larger id is linked to the other one
+    const auto& unite = [&](vid_t u, vid_t v) {
+            while (true) {
+                u = find(u);
+                v = find(v);
+                if (u == v)
+                    return;
+                if (u < v)
+                    std::swap(u, v);
+                if (parent[u].compare_exchange_weak(u, v,
+                                                    std::memory_order_relaxed))
+                    return;
+            }
+        };
+    const size_t BLOCK = 1024;
+    std::atomic<size_t> next_block { 0 };
+    SpinBarrier barrier(_num_threads);
+
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto  stop = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto v = start; v < stop; v++)
+                parent[v].store(static_cast<vid_t>(v),
+                                std::memory_order_relaxed);
+            barrier.wait();
+            //blocks of vertices are assigned dynamically (skewed degrees)
+            for (auto block = next_block.fetch_add(BLOCK); block < nV;
+                 block = next_block.fetch_add(BLOCK)) {
+                for (auto v = block; v < std::min(block + BLOCK, nV); v++) {
+                    auto u = static_cast<vid_t>(v);
+                    _graph.for_each_out(u, [&](vid_t dest) { unite(u, dest); });
+                }
+            }
+            barrier.wait();
+            for (auto v = start; v < stop; v++)
+                labels[v] = find(static_cast<vid_t>(v));
+        }, _num_threads);
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+std::vector<vid_t> BFS<vid_t, eoff_t, graph_t>::largestComponent() noexcept {
+    auto nV = static_cast<size_t>(_graph.nV());
+    std::vector<vid_t> labels, component_sizes(nV);
+    weakComponents(labels);
+    for (auto label : labels)
+        component_sizes[label]++;
+    //the component of the smallest vertex id on ties
+    auto largest = static_cast<vid_t>(
+                        std::max_element(component_sizes.begin(),
+                                         component_sizes.end()) -
+                        component_sizes.begin());
+    std::vector<vid_t> vertices;
+    vertices.reserve(nV == 0 ? 0 : component_sizes[largest]);
+    for (size_t v = 0; v < nV; v++) {
+        if (labels[v] == largest)
+            vertices.push_back(static_cast<vid_t>(v));
+    }
+    return vertices;
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t BFS<vid_t, eoff_t, graph_t>::radius() {
+    if (_graph.is_undirected())
+        return static_cast<vid_t>(boundEccentricities(true));
+    runAllSources();
+    //only the vertices which reach the most vertices of the component (all
+    //of them if any vertex does): a vertex whose out-edges lead only to sinks
+    //has eccentricity 1 and is not a center
+    vid_t max_reached = 0;
+    for (auto reached : _reached_nodes)
+        max_reached = std::max(max_reached, reached);
+    dist_t radius = INF;
+    for (size_t i = 0; i < _eccentricities.size(); i++) {
+        if (_reached_nodes[i] == max_reached && max_reached > 1)
+            radius = std::min(radius, _eccentricities[i]);
+    }
+    return radius == INF ? 0 : static_cast<vid_t>(radius);
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t BFS<vid_t, eoff_t, graph_t>::diameter() {
+    if (_graph.is_undirected())
+        return static_cast<vid_t>(boundEccentricities(false));
+    runAllSources();
+    return _eccentricities.empty() ? 0 : static_cast<vid_t>(
+                *std::max_element(_eccentricities.begin(),
+                                  _eccentricities.end()));
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+int BFS<vid_t, eoff_t, graph_t>::bfs_runs() const noexcept {
+    return _bfs_runs;
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+void BFS<vid_t, eoff_t, graph_t>::reset() noexcept {
     std::fill(_distances, _distances + _graph.nV(), INF);
     _queue.clear();
     _bitmask.clear();
+    if (_visited_words != nullptr) {
+        auto num_words = xlib::ceil_div<64>(static_cast<size_t>(_graph.nV()));
+        for (size_t i = 0; i < num_words; i++)
+            _visited_words[i].store(0, std::memory_order_relaxed);
+    }
+    _visited_edges = 0;
     _reset = true;
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t BFS<vid_t, eoff_t>::visited_nodes() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t BFS<vid_t, eoff_t, graph_t>::visited_nodes() const noexcept {
     if (_reset)
         ERROR("BFS not ready")
     return _queue.getTotalEnqueueItems();
 }
 
-template<typename vid_t, typename eoff_t>
-eoff_t BFS<vid_t, eoff_t>::visited_edges() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+eoff_t BFS<vid_t, eoff_t, graph_t>::visited_edges() const noexcept {
     if (_reset)
         ERROR("BFS not ready")
-    if (_queue.getTotalEnqueueItems() == _graph.nV())
-        return _graph.nE();
-    eoff_t sum = 0;
-    for (int i = 0; i < _queue.getTotalEnqueueItems(); i++)
-        sum += _graph._out_degrees[ _queue.at(i) ];
-    return sum;
+    return _visited_edges;
 }
 
-template<typename vid_t, typename eoff_t>
-const typename BFS<vid_t, eoff_t>::dist_t*
-BFS<vid_t, eoff_t>::result() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const typename BFS<vid_t, eoff_t, graph_t>::dist_t*
+BFS<vid_t, eoff_t, graph_t>::result() const noexcept {
     if (_reset)
         ERROR("BFS not ready")
     return _distances;
 }
 
-template<typename vid_t, typename eoff_t>
-typename BFS<vid_t, eoff_t>::dist_t
-BFS<vid_t, eoff_t>::eccentricity() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const typename BFS<vid_t, eoff_t, graph_t>::dist_t*
+BFS<vid_t, eoff_t, graph_t>::eccentricities() const noexcept {
+    if (_reset)
+        ERROR("BFS not ready")
+    return _eccentricities.data();
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+const vid_t* BFS<vid_t, eoff_t, graph_t>::reached_nodes() const noexcept {
+    if (_reset)
+        ERROR("BFS not ready")
+    return _reached_nodes.data();
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+const uint64_t* BFS<vid_t, eoff_t, graph_t>::distance_sums() const noexcept {
+    if (_reset)
+        ERROR("BFS not ready")
+    return _distance_sums.data();
+}
+
+template<typename vid_t, typename eoff_t, typename graph_t>
+typename BFS<vid_t, eoff_t, graph_t>::dist_t
+BFS<vid_t, eoff_t, graph_t>::eccentricity() const noexcept {
     if (_reset)
         ERROR("BFS not ready")
     return _distances[ _queue.tail() ] + 1;
 }
 
-template<typename vid_t, typename eoff_t>
+template<typename vid_t, typename eoff_t, typename graph_t>
 std::vector<std::array<vid_t, 4>>
-BFS<vid_t, eoff_t>::statistics(vid_t source) noexcept {
+BFS<vid_t, eoff_t, graph_t>::statistics(vid_t source) {
     if (!_reset)
         ERROR("BFS must be reset before the next run")
+    if (_num_threads > 1)
+        return statisticsParallel(source);
     std::vector<std::array<vid_t, 4>> statistics;
     std::array<vid_t, 4> counter = { { 0, 0, 0, 0 } };
 
@@ -138,27 +922,103 @@ BFS<vid_t, eoff_t>::statistics(vid_t source) noexcept {
             counter.fill(0);
         }
 
-        const auto& offset = _graph._out_offsets;
-        for (eoff_t i = offset[current]; i < offset[current + 1]; i++) {
-            vid_t dest = _graph._out_edges[i];
-
-            if (_distances[dest] < level)
-                counter[PARENT]++;
-            else if (_distances[dest] == level)
-                counter[PEER]++;
-            else if (_distances[dest] == INF) {
-                counter[VALID]++;
-                _distances[dest] = level + 1;
-                _queue.insert(dest);
-            } else
-                counter[NOT_VALID]++;
-        }
+        _visited_edges += _graph.out_degree(current);
+        _graph.for_each_out(current, [&](vid_t dest) {
+                if (_distances[dest] < level)
+                    counter[PARENT]++;
+                else if (_distances[dest] == level)
+                    counter[PEER]++;
+                else if (_distances[dest] == INF) {
+                    counter[VALID]++;
+                    _distances[dest] = level + 1;
+                    _queue.insert(dest);
+                } else
+                    counter[NOT_VALID]++;
+            });
     }
     _reset = false;
     return statistics;
 }
 
+/**
+ * @details the edges of the vertices of each level are classified after a
+ *          parallel run(): the VALID edges of a level are as many as the
+ *          vertices of the next level (the first edge that reaches each of
+ *          them), the other edges to the next level are NOT_VALID
+ */
+template<typename vid_t, typename eoff_t, typename graph_t>
+std::vector<std::array<vid_t, 4>>
+BFS<vid_t, eoff_t, graph_t>::statisticsParallel(vid_t source) {
+    run(source);
+    auto visited    = static_cast<size_t>(visited_nodes());
+    auto queue      = &_queue.at(0);
+    auto num_levels = static_cast<size_t>(_distances[queue[visited - 1]]) + 1;
+    //per thread and level: PARENT, PEER, edges to the next level (VALID),
+    //vertices of the level (NOT_VALID)
+    std::vector<std::array<vid_t, 4>> partials(
+                        num_levels * static_cast<size_t>(_num_threads),
+                        std::array<vid_t, 4> { { 0, 0, 0, 0 } });
+    std::vector<eoff_t> partial_edges(static_cast<size_t>(_num_threads));
+    const size_t BLOCK = 1024;
+    std::atomic<size_t> next_block { 0 };
+
+    xlib::parallel_run([&](int thread_id, int) {
+            auto  counters = partials.data() +
+                             num_levels * static_cast<size_t>(thread_id);
+            eoff_t   edges = 0;
+            for (auto block = next_block.fetch_add(BLOCK); block < visited;
+                 block = next_block.fetch_add(BLOCK)) {
+                for (auto i = block; i < std::min(block + BLOCK, visited);
+                     i++) {
+                    auto  current = queue[i];
+                    auto    level = _distances[current];
+                    auto& counter = counters[level];
+                    counter[NOT_VALID]++;
+                    edges += _graph.out_degree(current);
+                    _graph.for_each_out(current, [&](vid_t dest) {
+                            if (_distances[dest] < level)
+                                counter[PARENT]++;
+                            else if (_distances[dest] == level)
+                                counter[PEER]++;
+                            else
+                                counter[VALID]++;
+                        });
+                }
+            }
+            partial_edges[thread_id] = edges;
+        }, _num_threads);
+
+    std::vector<std::array<vid_t, 4>> statistics(num_levels - 1);
+    std::vector<vid_t> level_sizes(num_levels);
+    std::vector<vid_t> next_edges(num_levels);
+    for (size_t level = 0; level < num_levels; level++) {
+        for (int i = 0; i < _num_threads; i++) {
+            const auto& counter = partials[num_levels *
+                                           static_cast<size_t>(i) + level];
+            if (level + 1 < num_levels) {
+                statistics[level][PARENT] += counter[PARENT];
+                statistics[level][PEER]   += counter[PEER];
+            }
+            next_edges[level]  += counter[VALID];
+            level_sizes[level] += counter[NOT_VALID];
+        }
+    }
+    for (size_t level = 0; level + 1 < num_levels; level++) {
+        statistics[level][VALID]     = level_sizes[level + 1];
+        statistics[level][NOT_VALID] = next_edges[level] -
+                                       level_sizes[level + 1];
+    }
+    _visited_edges = 0;
+    for (auto edges : partial_edges)
+        _visited_edges += edges;
+    return statistics;
+}
+
 template class BFS<int, int>;
+template class BFS<int, int64_t>;
 template class BFS<int64_t, int64_t>;
+template class BFS<int, int, GraphCompressed<int, int>>;
+template class BFS<int, int64_t, GraphCompressed<int, int64_t>>;
+template class BFS<int64_t, int64_t, GraphCompressed<int64_t, int64_t>>;
 
 } // namespace graph
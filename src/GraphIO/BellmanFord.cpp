@@ -71,7 +71,7 @@ void BELLMANFORD::run(vid_t source) noexcept {
 
     while (_queue.size() > 0) {
         vid_t next = _queue.extract();
-        for (int i = _graph._out_offsets[next];
+        for (auto i = _graph._out_offsets[next];
              i < _graph._out_offsets[next + 1]; i++) {
             vid_t dest = _graph._out_edges[i];
             if (relax(next, dest, _graph._out_weights[i]))
@@ -93,6 +93,8 @@ bool BELLMANFORD::relax(vid_t u, vid_t v, weight_t weight) noexcept {
 template class BellmanFord<int, int, int>;
 template class BellmanFord<int64_t, int64_t, int>;
 template class BellmanFord<int, int, float>;
+template class BellmanFord<int, int64_t, int>;
+template class BellmanFord<int, int64_t, float>;
 template class BellmanFord<int64_t, int64_t, float>;
 
 } // namespace graph
@@ -0,0 +1,280 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "GraphIO/BinaryFormat.hpp"
+#include "Host/Basic.hpp"     //ERROR
+#include <algorithm>          //std::fill_n
+#include <cstring>            //std::memcpy, std::memcmp
+#include <fstream>            //std::ofstream
+#include <iterator>           //std::ostreambuf_iterator
+#include <iostream>           //std::cout
+#include <fcntl.h>            //::open
+#include <sys/mman.h>         //::mmap
+#include <sys/stat.h>         //::fstat, ::stat
+#include <unistd.h>           //::pread, ::sysconf
+
+namespace graph {
+namespace binary {
+namespace {
+
+size_t page_size() noexcept {
+    return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+size_t align(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+void Checksum::update(const void* data, size_t size) noexcept {
+    const uint64_t PRIME = 0x100000001B3;
+    auto bytes = static_cast<const unsigned char*>(data);
+    while (size > 0 && (_num_pending > 0 || size < sizeof(uint64_t))) {
+        _pending[_num_pending++] = *bytes++;
+        size--;
+        if (_num_pending == sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, _pending, sizeof(uint64_t));
+            _hash        = (_hash ^ word) * PRIME;
+            _num_pending = 0;
+        }
+    }
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(uint64_t));
+        _hash  = (_hash ^ word) * PRIME;
+        bytes += sizeof(uint64_t);
+    }
+    for (; size > 0; size--)
+        _pending[_num_pending++] = *bytes++;
+}
+
+uint64_t Checksum::value() const noexcept {
+    const uint64_t PRIME = 0x100000001B3;
+    uint64_t hash = _hash;
+    for (size_t i = 0; i < _num_pending; i++)
+        hash = (hash ^ _pending[i]) * PRIME;
+    return hash;
+}
+
+uint64_t checksum(const void* data, size_t size) noexcept {
+    Checksum checksum;
+    checksum.update(data, size);
+    return checksum.value();
+}
+
+bool is_v2(const char* filename) {
+    char magic[sizeof(MAGIC)] = {};
+    std::ifstream fin(filename, std::ios::binary);
+    fin.read(magic, sizeof(MAGIC));
+    return fin.good() && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool source_key(const char* filename, uint64_t options, SourceKey& key)
+                noexcept {
+    struct stat file_stat;
+    if (::stat(filename, &file_stat) == -1)
+        return false;
+    key = SourceKey();
+    key.options   = options;
+    key.file_size = static_cast<uint64_t>(file_stat.st_size);
+    key.inode     = static_cast<uint64_t>(file_stat.st_ino);
+    key.mtime     = static_cast<int64_t>(file_stat.st_mtim.tv_sec) *
+                    1000000000 + file_stat.st_mtim.tv_nsec;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void write(const std::string& filename, Header header,
+           const std::vector<SectionData>& sections, bool checksum,
+           bool print) {
+    Writer writer(filename, checksum);
+    for (const auto& section : sections) {
+        writer.begin_section(section.id, section.element_size);
+        writer.append(section.data, section.num_items * section.element_size);
+        writer.end_section();
+    }
+    writer.close(header, print);
+}
+
+//------------------------------------------------------------------------------
+
+Writer::Writer(const std::string& filename, bool checksum) :
+                                                _fout(filename,
+                                                      std::ios::binary),
+                                                _filename(filename),
+                                                _use_checksum(checksum) {
+    if (!_fout.is_open())
+        ERROR("Unable to open the file ", filename)
+    //space for the header and the largest table of contents
+    auto size = sizeof(Header) + NUM_SECTIONS * sizeof(SectionEntry);
+    std::fill_n(std::ostreambuf_iterator<char>(_fout), size, '\0');
+}
+
+void Writer::begin_section(Section id, size_t element_size) {
+    if (_entries.size() == static_cast<size_t>(NUM_SECTIONS))
+        ERROR("Binary graph: too many sections")
+    auto position = static_cast<size_t>(_fout.tellp());
+    auto   offset = align(position, page_size());
+    std::fill_n(std::ostreambuf_iterator<char>(_fout), offset - position,
+                '\0');
+    _entries.push_back({ static_cast<uint32_t>(id),
+                         static_cast<uint32_t>(element_size), offset, 0, 0 });
+    _checksum = Checksum();
+}
+
+void Writer::append(const void* data, size_t size) {
+    _fout.write(static_cast<const char*>(data),
+                static_cast<std::streamsize>(size));
+    _entries.back().size += size;
+    if (_use_checksum)
+        _checksum.update(data, size);
+}
+
+void Writer::end_section() {
+    _entries.back().checksum = _use_checksum ? _checksum.value() : 0;
+}
+
+void Writer::close(Header header, bool print) {
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version      = VERSION;
+    header.flags        = _use_checksum ? CHECKSUM : 0;
+    header.num_sections = static_cast<uint32_t>(_entries.size());
+    auto file_size      = static_cast<size_t>(_fout.tellp());
+
+    _fout.seekp(0);
+    _fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    _fout.write(reinterpret_cast<const char*>(_entries.data()),
+                static_cast<std::streamsize>(_entries.size() *
+                                             sizeof(SectionEntry)));
+    _fout.close();
+    if (_fout.fail())
+        ERROR("Unable to write the file ", _filename)
+    if (print) {
+        std::cout << "Graph to binary file (v2): " << _filename
+                  << " (" << (file_size >> 20) << " MB)" << std::endl;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+File::File(const char* filename) {
+    _fd = ::open(filename, O_RDONLY);
+    if (_fd == -1)
+        ERROR("::open ", filename)
+    if (::pread(_fd, &_header, sizeof(Header), 0) !=
+            static_cast<ssize_t>(sizeof(Header)) ||
+            std::memcmp(_header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        ERROR("Not a binary graph file (v2): ", filename)
+    }
+    if (_header.version != VERSION)
+        ERROR("Unsupported binary graph version: ", _header.version)
+    if (_header.num_sections > static_cast<uint32_t>(NUM_SECTIONS))
+        ERROR("Wrong binary graph table of contents")
+
+    struct stat file_stat;
+    if (::fstat(_fd, &file_stat) == -1)
+        ERROR("::fstat ", filename)
+    auto file_size = static_cast<uint64_t>(file_stat.st_size);
+
+    for (uint32_t i = 0; i < _header.num_sections; i++) {
+        SectionEntry entry;
+        auto offset = static_cast<off_t>(sizeof(Header) +
+                                         i * sizeof(SectionEntry));
+        if (::pread(_fd, &entry, sizeof(entry), offset) !=
+                static_cast<ssize_t>(sizeof(entry)) ||
+                entry.id >= static_cast<uint32_t>(NUM_SECTIONS)) {
+            ERROR("Wrong binary graph table of contents")
+        }
+        if (entry.offset % page_size() != 0 || entry.size > file_size ||
+                entry.offset > file_size - entry.size) {
+            ERROR("Binary graph: section ", entry.id, " out of file bounds")
+        }
+        _entries[entry.id] = entry;
+        _present[entry.id] = true;
+    }
+}
+
+File::~File() noexcept {
+    for (int i = 0; i < NUM_SECTIONS; i++)
+        unmap(static_cast<Section>(i));
+    ::close(_fd);
+}
+
+const Header& File::header() const noexcept {
+    return _header;
+}
+
+bool File::has(Section id) const noexcept {
+    return _present[static_cast<int>(id)];
+}
+
+const SectionEntry& File::section(Section id) const noexcept {
+    return _entries[static_cast<int>(id)];
+}
+
+const void* File::map(Section id) const {
+    auto index = static_cast<int>(id);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_present[index] || _entries[index].size == 0)
+        return nullptr;
+    if (_mapped[index] != nullptr)
+        return _mapped[index];
+
+    const auto& entry = _entries[index];
+    void* ptr = ::mmap(nullptr, entry.size, PROT_READ, MAP_SHARED, _fd,
+                       static_cast<off_t>(entry.offset));
+    if (ptr == MAP_FAILED)
+        ERROR("::mmap")
+    if ((_header.flags & CHECKSUM) &&
+            binary::checksum(ptr, entry.size) != entry.checksum) {
+        ERROR("Binary graph: wrong checksum of section ", index)
+    }
+    _mapped[index] = ptr;
+    return ptr;
+}
+
+void File::unmap(Section id) const noexcept {
+    auto index = static_cast<int>(id);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_mapped[index] != nullptr) {
+        ::munmap(_mapped[index], _entries[index].size);
+        _mapped[index] = nullptr;
+    }
+}
+
+} // namespace binary
+} // namespace graph
@@ -89,9 +89,11 @@ void Brim<vid_t, eoff_t, weight_t>::reset() noexcept {
 //==============================================================================
 
 template<typename vid_t, typename eoff_t, typename weight_t>
-void Brim<vid_t, eoff_t, weight_t>::run() noexcept {
+void Brim<vid_t, eoff_t, weight_t>::run() {
 	while (_queue.size() > 0) {
-        const auto& in_offsets = _graph._in_offsets;
+        const auto in_offsets = _graph.in_offsets_ptr();
+        const auto in_edges   = _graph.in_edges_ptr();
+        const auto in_weights = _graph.in_weights_array();
 
 		auto       vertex_id = _queue.extract();
 		_in_queue[vertex_id] = false;
@@ -104,8 +106,8 @@ void Brim<vid_t, eoff_t, weight_t>::run() noexcept {
 		for (auto j = in_offsets[vertex_id];
              j < in_offsets[vertex_id + 1]; j++) {
 
-            auto in_weight = _graph._in_weights[j];
-            auto  incoming = _graph._in_edges[j];
+            auto in_weight = in_weights[j];
+            auto  incoming = in_edges[j];
 
 			if (_potentials[incoming] < minus(_potentials[vertex_id], in_weight)) {
 				if (is_player0(incoming)) {
@@ -204,7 +206,7 @@ void Brim<vid_t, eoff_t, weight_t>::lift_count(vid_t vertex_id) noexcept {
     if (is_player0(vertex_id)) {
 		auto min_value = std::numeric_limits<potential_t>::max();
 		int count = 0;
-		for (int j = offsets[vertex_id]; j < offsets[vertex_id + 1]; j++) {
+		for (auto j = offsets[vertex_id]; j < offsets[vertex_id + 1]; j++) {
             auto weight = _graph._out_weights[j];
             auto    dst = _graph._out_edges[j];
 			auto   diff = minus(_potentials[dst], weight);
@@ -220,7 +222,7 @@ void Brim<vid_t, eoff_t, weight_t>::lift_count(vid_t vertex_id) noexcept {
 	}
 	else {
 		auto max_value = std::numeric_limits<potential_t>::lowest();
-		for (int j = offsets[vertex_id]; j < offsets[vertex_id + 1]; j++) {
+		for (auto j = offsets[vertex_id]; j < offsets[vertex_id + 1]; j++) {
             auto weight = _graph._out_weights[j];
             auto    dst = _graph._out_edges[j];
 			max_value = std::max(max_value, minus(_potentials[dst], weight));
@@ -336,6 +338,7 @@ void Brim<vid_t, eoff_t, weight_t>::check_from_file(const std::string& file) {
 //==============================================================================
 
 template class Brim<int, int, int>;
+template class Brim<int, int64_t, int>;
 template class Brim<int64_t, int64_t, int>;
 
 } // namespace graph
@@ -34,63 +34,288 @@
  * </blockquote>}
  */
 #include "GraphIO/Dijkstra.hpp"
+#include <algorithm>    //std::push_heap, std::pop_heap
+#include <functional>   //std::greater
+#include <set>          //std::set
+#include <type_traits>  //std::is_integral
+#include <utility>      //std::pair
+#include <vector>       //std::vector
 
 namespace graph {
+namespace detail {
 
-#define DIJKSTRA Dijkstra<vid_t,eoff_t,weight_t>
+///@brief queue entry: (distance, vertex)
+template<typename vid_t, typename weight_t>
+using SetNode = std::pair<weight_t, vid_t>;
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+// DijkstraPQ interface: `decrease(v, old_key, key)` inserts `v` or lowers its
+// key (`old_key` is INF if `v` is not in the queue), `extract()` removes an
+// entry of minimum key
+
+template<typename vid_t, typename weight_t>
+class DijkstraPQ<vid_t, weight_t, DijkstraQueue::SET> {
+public:
+    explicit DijkstraPQ(size_t) noexcept {}
+
+    bool empty() const noexcept { return _set.empty(); }
+
+    void decrease(vid_t v, weight_t old_key, weight_t key) noexcept {
+        if (old_key != std::numeric_limits<weight_t>::max())
+            _set.erase(SetNode<vid_t, weight_t>(old_key, v));
+        _set.insert(SetNode<vid_t, weight_t>(key, v));
+    }
+
+    SetNode<vid_t, weight_t> extract() noexcept {
+        auto node = *_set.begin();
+        _set.erase(_set.begin());
+        return node;
+    }
+private:
+    std::set<SetNode<vid_t, weight_t>> _set;
+};
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename weight_t>
+class DijkstraPQ<vid_t, weight_t, DijkstraQueue::INDEXED_HEAP> {
+    static const size_t ARITY     = 4;
+    static const size_t NOT_QUEUED = std::numeric_limits<size_t>::max();
+public:
+    explicit DijkstraPQ(size_t num_vertices) noexcept :
+                            _positions(num_vertices, size_t(NOT_QUEUED)) {}
+
+    bool empty() const noexcept { return _heap.empty(); }
+
+    void decrease(vid_t v, weight_t, weight_t key) noexcept {
+        auto position = _positions[v];
+        if (position == NOT_QUEUED) {
+            position = _heap.size();
+            _heap.push_back(SetNode<vid_t, weight_t>(key, v));
+        }
+        siftUp(position, SetNode<vid_t, weight_t>(key, v));
+    }
+
+    SetNode<vid_t, weight_t> extract() noexcept {
+        auto root = _heap.front();
+        _positions[root.second] = NOT_QUEUED;
+        auto last = _heap.back();
+        _heap.pop_back();
+        if (!_heap.empty())
+            siftDown(0, last);
+        return root;
+    }
+private:
+    std::vector<SetNode<vid_t, weight_t>> _heap;
+    ///@brief heap position of each vertex
+    std::vector<size_t>                   _positions;
+
+    void place(size_t position, const SetNode<vid_t, weight_t>& node)
+               noexcept {
+        _heap[position]          = node;
+        _positions[node.second] = position;
+    }
+
+    void siftUp(size_t position, const SetNode<vid_t, weight_t>& node)
+                noexcept {
+        while (position > 0) {
+            auto parent = (position - 1) / ARITY;
+            if (_heap[parent].first <= node.first)
+                break;
+            place(position, _heap[parent]);
+            position = parent;
+        }
+        place(position, node);
+    }
+
+    void siftDown(size_t position, const SetNode<vid_t, weight_t>& node)
+                  noexcept {
+        auto size = _heap.size();
+        while (true) {
+            auto first = position * ARITY + 1;
+            if (first >= size)
+                break;
+            auto min_child = first;
+            auto      last = std::min(first + ARITY, size);
+            for (auto i = first + 1; i < last; i++) {
+                if (_heap[i].first < _heap[min_child].first)
+                    min_child = i;
+            }
+            if (node.first <= _heap[min_child].first)
+                break;
+            place(position, _heap[min_child]);
+            position = min_child;
+        }
+        place(position, node);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @details Bucket `i > 0` holds the keys whose highest bit differing from the
+ *          last extracted key is `i - 1`, bucket 0 the keys equal to it. The
+ *          keys are monotone (Dijkstra), so an entry moves to a lower bucket
+ *          at most once per bit
+ */
+template<typename vid_t, typename weight_t>
+class DijkstraPQ<vid_t, weight_t, DijkstraQueue::RADIX_HEAP> {
+    static_assert(std::is_integral<weight_t>::value,
+                  "DijkstraQueue::RADIX_HEAP requires integral weights");
+    static const int NUM_BUCKETS = 65;
+public:
+    explicit DijkstraPQ(size_t) noexcept {}
+
+    bool empty() const noexcept { return _size == 0; }
+
+    void decrease(vid_t v, weight_t, weight_t key) noexcept {
+        if (_size == 0)             //any key is valid (e.g. a new run)
+            _last = 0;
+        _buckets[bucket(key)].push_back(SetNode<vid_t, weight_t>(key, v));
+        _size++;
+    }
+
+    SetNode<vid_t, weight_t> extract() noexcept {
+        if (_buckets[0].empty()) {
+            int i = 1;
+            while (_buckets[i].empty())
+                i++;
+            auto& source = _buckets[i];
+            _last = std::min_element(source.begin(), source.end())->first;
+            for (const auto& node : source)
+                _buckets[bucket(node.first)].push_back(node);
+            source.clear();
+        }
+        auto node = _buckets[0].back();
+        _buckets[0].pop_back();
+        _size--;
+        return node;
+    }
+private:
+    std::vector<SetNode<vid_t, weight_t>> _buckets[NUM_BUCKETS];
+    weight_t                              _last { 0 };
+    size_t                                _size { 0 };
+
+    int bucket(weight_t key) const noexcept {
+        auto diff = static_cast<uint64_t>(key) ^ static_cast<uint64_t>(_last);
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename weight_t>
+class DijkstraPQ<vid_t, weight_t, DijkstraQueue::LAZY_HEAP> {
+public:
+    explicit DijkstraPQ(size_t) noexcept {}
+
+    bool empty() const noexcept { return _heap.empty(); }
+
+    void decrease(vid_t v, weight_t, weight_t key) noexcept {
+        _heap.push_back(SetNode<vid_t, weight_t>(key, v));
+        std::push_heap(_heap.begin(), _heap.end(),
+                       std::greater<SetNode<vid_t, weight_t>>());
+    }
+
+    SetNode<vid_t, weight_t> extract() noexcept {
+        std::pop_heap(_heap.begin(), _heap.end(),
+                      std::greater<SetNode<vid_t, weight_t>>());
+        auto node = _heap.back();
+        _heap.pop_back();
+        return node;
+    }
+private:
+    std::vector<SetNode<vid_t, weight_t>> _heap;
+};
+
+} // namespace detail
+
+//==============================================================================
+
+#define DIJKSTRA Dijkstra<vid_t,eoff_t,weight_t,queue_t>
+
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t>
 DIJKSTRA::Dijkstra(const GraphWeight<vid_t, eoff_t, weight_t>& graph)
                         noexcept : _graph(graph) {
     _distances = new weight_t[_graph._nV];
+    _queue     = new detail::DijkstraPQ<vid_t, weight_t, queue_t>(
+                                            static_cast<size_t>(_graph._nV));
     reset();
 }
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t>
 DIJKSTRA::~Dijkstra() noexcept {
     delete[] _distances;
+    delete _queue;
 }
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t>
 void DIJKSTRA::reset() noexcept {
     std::fill(_distances, _distances + _graph._nV, INF);
     _reset = true;
 }
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t>
 const weight_t* DIJKSTRA::result() const noexcept {
     return _distances;
 }
 
-template<typename vid_t, typename eoff_t, typename weight_t>
+template<typename vid_t, typename eoff_t, typename weight_t,
+         DijkstraQueue queue_t>
 void DIJKSTRA::run(vid_t source) noexcept {
-    if (_reset)
-        ERROR("Dijkstra not ready")
-    _queue.insert(SetNode(0, source));
+    if (!_reset)
+        ERROR("Dijkstra must be reset before the next run")
+    _queue->decrease(source, INF, 0);
     _distances[source] = 0;
 
-    while (!_queue.empty()) {
-        vid_t next = _queue.begin()->second;
-        _queue.erase(_queue.begin());
+    while (!_queue->empty()) {
+        auto  node = _queue->extract();
+        vid_t next = node.second;
+        if (node.first > _distances[next])      //stale entry (lazy queues)
+            continue;
 
-        for (int i = _graph._out_offsets[next]; i < _graph._out_offsets[next + 1];
-             i++) {
+        for (auto i = _graph._out_offsets[next];
+             i < _graph._out_offsets[next + 1]; i++) {
             vid_t dest = _graph._out_edges[i];
 
             auto tentative = _distances[next] + _graph._out_weights[i];
             if (tentative < _distances[dest]) {
-                _queue.erase(SetNode(_distances[dest], dest));
+                _queue->decrease(dest, _distances[dest], tentative);
                 _distances[dest] = tentative;
-                _queue.insert(SetNode(_distances[dest], dest));
             }
         }
     }
     _reset = false;
 }
 
-template class Dijkstra<int, int, int>;
-template class Dijkstra<int64_t, int64_t, int>;
-template class Dijkstra<int, int, float>;
-template class Dijkstra<int64_t, int64_t, float>;
+template class Dijkstra<int, int, int, DijkstraQueue::SET>;
+template class Dijkstra<int, int, int, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int, int, int, DijkstraQueue::LAZY_HEAP>;
+template class Dijkstra<int, int, int, DijkstraQueue::RADIX_HEAP>;
+
+template class Dijkstra<int64_t, int64_t, int, DijkstraQueue::SET>;
+template class Dijkstra<int64_t, int64_t, int, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int64_t, int64_t, int, DijkstraQueue::LAZY_HEAP>;
+template class Dijkstra<int64_t, int64_t, int, DijkstraQueue::RADIX_HEAP>;
+
+template class Dijkstra<int, int, float, DijkstraQueue::SET>;
+template class Dijkstra<int, int, float, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int, int, float, DijkstraQueue::LAZY_HEAP>;
+
+template class Dijkstra<int, int64_t, int, DijkstraQueue::SET>;
+template class Dijkstra<int, int64_t, int, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int, int64_t, int, DijkstraQueue::LAZY_HEAP>;
+template class Dijkstra<int, int64_t, int, DijkstraQueue::RADIX_HEAP>;
+
+template class Dijkstra<int, int64_t, float, DijkstraQueue::SET>;
+template class Dijkstra<int, int64_t, float, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int, int64_t, float, DijkstraQueue::LAZY_HEAP>;
+
+template class Dijkstra<int64_t, int64_t, float, DijkstraQueue::SET>;
+template class Dijkstra<int64_t, int64_t, float, DijkstraQueue::INDEXED_HEAP>;
+template class Dijkstra<int64_t, int64_t, float, DijkstraQueue::LAZY_HEAP>;
 
 } // namespace graph
@@ -0,0 +1,330 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/ExternalCSR.hpp"
+#include "GraphIO/BinaryFormat.hpp"
+#include "GraphIO/GraphBase.hpp"  //detail::StructureEnum
+#include "Host/Algorithm.hpp" //xlib::parallel_radix_sort
+#include "Host/Basic.hpp"     //ERROR, xlib::type_name
+#include "Host/FileUtil.hpp"  //xlib::MemoryMapped, xlib::parse_integer
+#include "Host/Numeric.hpp"   //xlib::ceil_log2, xlib::check_overflow
+#include "Host/PrintExt.hpp"  //xlib::format
+#include <algorithm>          //std::max, std::min
+#include <cstdint>            //uint64_t
+#include <cstdio>             //std::remove
+#include <fstream>            //std::ifstream, std::ofstream
+#include <functional>         //std::greater
+#include <iostream>           //std::cout
+#include <memory>             //std::unique_ptr
+#include <queue>              //std::priority_queue
+#include <string>             //std::to_string
+#include <utility>            //std::pair
+#include <vector>             //std::vector
+
+namespace graph {
+namespace {
+
+//(first << 32) | second
+using key_t = uint64_t;
+
+const size_t MIN_BUFFER = 4096;
+
+key_t swap_halves(key_t key) noexcept {
+    return (key << 32) | (key >> 32);
+}
+
+void spill(const key_t* keys, size_t size, const std::string& path) {
+    std::ofstream fout(path, std::ios::binary);
+    fout.write(reinterpret_cast<const char*>(keys),
+               static_cast<std::streamsize>(size * sizeof(key_t)));
+    if (!fout.good())
+        ERROR("Unable to write the file ", path)
+}
+
+/**
+ * @brief Buffered sequential reader of a sorted run
+ */
+class RunReader {
+public:
+    RunReader(const std::string& path, size_t buffer_size) :
+                                          _fin(path, std::ios::binary),
+                                          _buffer(buffer_size) {
+        if (!_fin.is_open())
+            ERROR("Unable to open the file ", path)
+    }
+
+    bool next(key_t& key) {
+        if (_pos == _size) {
+            _fin.read(reinterpret_cast<char*>(_buffer.data()),
+                      static_cast<std::streamsize>(_buffer.size() *
+                                                   sizeof(key_t)));
+            _size = static_cast<size_t>(_fin.gcount()) / sizeof(key_t);
+            _pos  = 0;
+            if (_size == 0)
+                return false;
+        }
+        key = _buffer[_pos++];
+        return true;
+    }
+private:
+    std::ifstream      _fin;
+    std::vector<key_t> _buffer;
+    size_t             _pos  { 0 };
+    size_t             _size { 0 };
+};
+
+/**
+ * @brief K-way merge of sorted runs. The keys are streamed to
+ *        `write_op(source, destination)` in sorted order
+ */
+template<typename Lambda>
+void merge_runs(const std::vector<std::string>& runs, size_t memory_budget,
+                const Lambda& write_op) {
+    using entry_t = std::pair<key_t, size_t>;
+    auto buffer_size = std::max(memory_budget / sizeof(key_t) /
+                                (runs.size() + 1), MIN_BUFFER);
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::priority_queue<entry_t, std::vector<entry_t>,
+                        std::greater<entry_t>> queue;
+    for (size_t i = 0; i < runs.size(); i++) {
+        readers.emplace_back(new RunReader(runs[i], buffer_size));
+        key_t key;
+        if (readers[i]->next(key))
+            queue.push({ key, i });
+    }
+    while (!queue.empty()) {
+        auto top = queue.top();
+        queue.pop();
+        write_op(top.first >> 32, top.first & 0xFFFFFFFF);
+        key_t key;
+        if (readers[top.second]->next(key))
+            queue.push({ key, top.second });
+    }
+    readers.clear();
+    for (const auto& run : runs)
+        std::remove(run.c_str());
+}
+
+/**
+ * @brief Write the edges, degrees and offsets sections of the CSR stored in
+ *        the (sorted) runs
+ */
+template<typename vid_t, typename eoff_t>
+void write_csr(binary::Writer& writer, const std::vector<std::string>& runs,
+               size_t memory_budget, size_t num_vertices,
+               binary::Section edges_id, binary::Section degrees_id,
+               binary::Section offsets_id) {
+    std::vector<int>   degrees(num_vertices);
+    std::vector<vid_t> buffer;
+    buffer.reserve(std::max(memory_budget / 2 / sizeof(vid_t), MIN_BUFFER));
+
+    writer.begin_section(edges_id, sizeof(vid_t));
+    merge_runs(runs, memory_budget / 2,
+               [&](key_t source, key_t destination) {
+                    degrees[source]++;
+                    buffer.push_back(static_cast<vid_t>(destination));
+                    if (buffer.size() == buffer.capacity()) {
+                        writer.append(buffer.data(),
+                                      buffer.size() * sizeof(vid_t));
+                        buffer.clear();
+                    }
+               });
+    writer.append(buffer.data(), buffer.size() * sizeof(vid_t));
+    writer.end_section();
+
+    writer.begin_section(degrees_id, sizeof(int));
+    writer.append(degrees.data(), num_vertices * sizeof(int));
+    writer.end_section();
+
+    std::vector<eoff_t> offsets(num_vertices + 1);
+    offsets[0] = 0;
+    xlib::parallel_prefix_sum(degrees.data(), num_vertices,
+                              offsets.data() + 1);
+    writer.begin_section(offsets_id, sizeof(eoff_t));
+    writer.append(offsets.data(), (num_vertices + 1) * sizeof(eoff_t));
+    writer.end_section();
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void buildBinaryExternal(const char* filename, const std::string& bin_file,
+                         size_t memory_budget, bool reverse,
+                         const std::string& tmp_dir, bool print) {
+    using namespace binary;
+    const key_t MAX_ID = 0xFFFFFFFF;
+    //the radix sort requires a temporary array of the same size
+    auto capacity = std::max(memory_budget / (2 * sizeof(key_t)), MIN_BUFFER);
+    std::string run_prefix = tmp_dir.empty() ? bin_file :
+                             tmp_dir + "/" + xlib::extract_filename(bin_file);
+
+    size_t file_size = xlib::file_size(filename);
+    xlib::MemoryMapped memory_mapped(filename, file_size,
+                                     xlib::MemoryMapped::READ);
+    const char* ptr = memory_mapped.read_ptr<char>(file_size);
+    const char* end = ptr + file_size;
+
+    bool   is_market = xlib::extract_file_extension(filename) == ".mtx";
+    bool  undirected = false;
+    key_t     max_id = 0;
+    size_t num_edges = 0, num_lines = 0, market_lines = 0;
+    if (is_market) {
+        auto line_end = xlib::end_of_line(ptr, end);
+        undirected    = std::string(ptr, line_end).find("symmetric") !=
+                        std::string::npos;
+        while (ptr < end && *ptr == '%')
+            ptr = xlib::end_of_line(ptr, end) + 1;
+        key_t rows, columns;
+        ptr    = xlib::parse_integer(ptr, end, rows);
+        ptr    = xlib::parse_integer(ptr, end, columns);
+        ptr    = xlib::parse_integer(ptr, end, market_lines);
+        ptr    = xlib::end_of_line(ptr, end) + 1;
+        max_id = std::max(rows, columns) - 1;
+    }
+    bool   twice = !undirected && reverse;
+    auto* buffer = new key_t[capacity];
+    size_t  size = 0;
+    std::vector<std::string> out_runs, in_runs;
+
+    const auto& flush_op = [&]() {
+            if (size == 0)
+                return;
+            int num_bits = 32 + (max_id > 0 ? xlib::ceil_log2(max_id + 1) : 1);
+            auto    path = run_prefix + ".run" +
+                           std::to_string(out_runs.size());
+            xlib::parallel_radix_sort(buffer, size, num_bits);
+            spill(buffer, size, path + ".out");
+            out_runs.push_back(path + ".out");
+            if (twice) {
+                for (size_t i = 0; i < size; i++)
+                    buffer[i] = swap_halves(buffer[i]);
+                xlib::parallel_radix_sort(buffer, size, num_bits);
+                spill(buffer, size, path + ".in");
+                in_runs.push_back(path + ".in");
+            }
+            size = 0;
+        };
+
+    if (print) {
+        std::cout << "External build: " << filename << "  (budget: "
+                  << (memory_budget >> 20) << " MB)" << std::endl;
+    }
+    //as GraphStd, the Market entries beyond the header count are ignored
+    while (ptr < end && (!is_market || num_lines < market_lines)) {
+        auto line_end = xlib::end_of_line(ptr, end);
+        auto    start = xlib::skip_blanks(ptr, line_end);
+        ptr = line_end + 1;
+        if (start == line_end || *start == '#' || *start == '%')
+            continue;
+        key_t source, destination;
+        start = xlib::parse_integer(start, line_end, source);
+        xlib::parse_integer(start, line_end, destination);
+        if (is_market) {
+            if (source == 0 || destination == 0)
+                ERROR("Wrong Matrix Market vertex id (0)")
+            source--;
+            destination--;
+        }
+        if (source > MAX_ID || destination > MAX_ID)
+            ERROR("External build: vertex ids must be lower than 2^32")
+        max_id = std::max(max_id, std::max(source, destination));
+        if (size + 2 > capacity)
+            flush_op();
+        buffer[size++] = (source << 32) | destination;
+        num_edges++;
+        num_lines++;
+        //as GraphStd, the mirrored copy of undirected self-loops is skipped
+        if (undirected && source != destination) {
+            buffer[size++] = (destination << 32) | source;
+            num_edges++;
+        }
+    }
+    flush_op();
+    delete[] buffer;
+    if (is_market && num_lines < market_lines) {
+        for (const auto& run : out_runs)
+            std::remove(run.c_str());
+        for (const auto& run : in_runs)
+            std::remove(run.c_str());
+        ERROR("Market: ", market_lines, " entries declared in the header, ",
+              num_lines, " found")
+    }
+
+    size_t num_vertices = static_cast<size_t>(max_id) + 1;
+    xlib::check_overflow<vid_t>(num_vertices);
+    xlib::check_overflow<eoff_t>(num_edges);
+    if (print) {
+        std::cout << "V: " << xlib::format(num_vertices) << "  E: "
+                  << xlib::format(num_edges) << "  sorted runs: "
+                  << out_runs.size() << std::endl;
+    }
+
+    Writer writer(bin_file, false);
+    write_csr<vid_t, eoff_t>(writer, out_runs, memory_budget, num_vertices,
+                             Section::OUT_EDGES, Section::OUT_DEGREES,
+                             Section::OUT_OFFSETS);
+    if (twice) {
+        write_csr<vid_t, eoff_t>(writer, in_runs, memory_budget,
+                                 num_vertices, Section::IN_EDGES,
+                                 Section::IN_DEGREES, Section::IN_OFFSETS);
+    }
+    using detail::StructureEnum;
+    Header header {};
+    xlib::type_name<vid_t>().copy(header.vid_type,
+                                  sizeof(header.vid_type) - 1);
+    xlib::type_name<eoff_t>().copy(header.eoff_type,
+                                   sizeof(header.eoff_type) - 1);
+    header.num_vertices = num_vertices;
+    header.num_edges    = num_edges;
+    header.structure    = static_cast<uint32_t>(undirected ?
+                                StructureEnum::UNDIRECTED :
+                                StructureEnum::DIRECTED);
+    if (twice)
+        header.structure |= static_cast<uint32_t>(StructureEnum::REVERSE);
+    writer.close(header, print);
+}
+
+//------------------------------------------------------------------------------
+
+template void buildBinaryExternal<int, int>
+    (const char*, const std::string&, size_t, bool, const std::string&, bool);
+template void buildBinaryExternal<int, int64_t>
+    (const char*, const std::string&, size_t, bool, const std::string&, bool);
+template void buildBinaryExternal<int64_t, int64_t>
+    (const char*, const std::string&, size_t, bool, const std::string&, bool);
+
+} // namespace graph
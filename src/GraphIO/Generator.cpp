@@ -0,0 +1,408 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/Generator.hpp"
+#include "Host/Algorithm.hpp"   //xlib::parallel_run, xlib::thread_chunk
+#include "Host/Basic.hpp"       //ERROR
+#include "Host/Numeric.hpp"     //xlib::check_overflow
+#include <algorithm>            //std::min
+#include <cmath>                //std::log1p, std::pow
+#include <random>               //std::mt19937_64
+#include <type_traits>          //std::is_integral
+
+namespace graph {
+
+namespace {
+
+///@brief edges (or weights) generated with the same random generator
+const size_t   BLOCK_SIZE  = 1 << 16;
+const uint64_t WEIGHT_SEED = 0x5851F42D4C957F2D;
+
+///@brief splitmix64 of (seed, block): independent streams for the blocks
+uint64_t block_seed(uint64_t seed, size_t block) noexcept {
+    uint64_t z = seed + (static_cast<uint64_t>(block) + 1) *
+                        0x9E3779B97F4A7C15;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+///@brief uniform in [0, 1), same sequence on every platform
+inline double uniform(std::mt19937_64& rng) noexcept {
+    return static_cast<double>(rng() >> 11) * (1.0 / (uint64_t(1) << 53));
+}
+
+///@brief uniform in [0, n), n < 2^53
+inline uint64_t uniform_int(std::mt19937_64& rng, uint64_t n) noexcept {
+    return static_cast<uint64_t>(uniform(rng) * static_cast<double>(n));
+}
+
+///@brief probability `p` as a threshold on 32-bit random values
+uint64_t threshold(double p) noexcept {
+    const double TWO_32 = 4294967296.0;
+    return std::min(static_cast<uint64_t>(p * TWO_32), uint64_t(1) << 32);
+}
+
+/**
+ * @brief Call `fun(rng, start, end)` for each block of [0, num_items) in
+ *        parallel. The generator of a block depends only on (seed, block)
+ */
+template<typename Lambda>
+void parallel_blocks(size_t num_items, uint64_t seed, const Lambda& fun) {
+    size_t num_blocks = (num_items + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto first = xlib::thread_chunk(num_blocks, thread_id,
+                                            num_threads);
+            auto  last = xlib::thread_chunk(num_blocks, thread_id + 1,
+                                            num_threads);
+            for (auto block = first; block < last; block++) {
+                std::mt19937_64 rng(block_seed(seed, block));
+                auto start = block * BLOCK_SIZE;
+                fun(rng, start, std::min(start + BLOCK_SIZE, num_items));
+            }
+        });
+}
+
+/**
+ * @brief Bijection of [0, 2^scale): two rounds of odd multiplication and
+ *        xor-shift modulo 2^scale
+ */
+class Scrambler {
+public:
+    explicit Scrambler(int scale, uint64_t seed) noexcept :
+            _mask((uint64_t(1) << scale) - 1),
+            _shift((scale + 1) / 2),
+            _mul1(block_seed(seed, 0) | 1),
+            _mul2(block_seed(seed, 1) | 1) {}
+
+    uint64_t operator()(uint64_t x) const noexcept {
+        x = (x * _mul1) & _mask;
+        x ^= x >> _shift;
+        x = (x * _mul2) & _mask;
+        return x ^ (x >> _shift);
+    }
+private:
+    const uint64_t _mask;
+    const int      _shift;
+    const uint64_t _mul1, _mul2;
+};
+
+GeneratorProp make_prop(GeneratorProp::Type type, int scale, int edge_factor,
+                        uint64_t seed) {
+    if (scale < 1 || scale > 40)
+        ERROR("Generator: scale must be in [1, 40]  scale: ", scale)
+    if (edge_factor < 1)
+        ERROR("Generator: edge factor must be positive")
+    GeneratorProp prop;
+    prop.type        = type;
+    prop.scale       = scale;
+    prop.edge_factor = edge_factor;
+    prop.seed        = seed;
+    return prop;
+}
+
+} // namespace
+
+//==============================================================================
+
+size_t GeneratorProp::num_vertices() const noexcept {
+    return size_t(1) << scale;
+}
+
+std::string GeneratorProp::name() const {
+    const char* const names[] = { "rmat", "kronecker", "gnp", "gnm",
+                                  "chung-lu" };
+    return std::string(names[static_cast<int>(type)]) + "_s" +
+           std::to_string(scale) + "_ef" + std::to_string(edge_factor);
+}
+
+namespace generator {
+
+GeneratorProp rmat(int scale, int edge_factor, double a, double b, double c,
+                   uint64_t seed) {
+    auto prop = make_prop(GeneratorProp::Type::RMAT, scale, edge_factor, seed);
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1.0)
+        ERROR("R-MAT: wrong probabilities  a: ", a, " b: ", b, " c: ", c)
+    prop.a = a;
+    prop.b = b;
+    prop.c = c;
+    return prop;
+}
+
+GeneratorProp kronecker(int scale, int edge_factor, uint64_t seed) {
+    auto prop = rmat(scale, edge_factor, 0.57, 0.19, 0.19, seed);
+    prop.type = GeneratorProp::Type::KRONECKER;
+    return prop;
+}
+
+GeneratorProp gnp(int scale, int edge_factor, uint64_t seed) {
+    return make_prop(GeneratorProp::Type::GNP, scale, edge_factor, seed);
+}
+
+GeneratorProp gnm(int scale, int edge_factor, uint64_t seed) {
+    return make_prop(GeneratorProp::Type::GNM, scale, edge_factor, seed);
+}
+
+GeneratorProp chung_lu(int scale, int edge_factor, double exponent,
+                       uint64_t seed) {
+    auto prop = make_prop(GeneratorProp::Type::CHUNG_LU, scale, edge_factor,
+                          seed);
+    if (exponent <= 1.0)
+        ERROR("Chung-Lu: the exponent must be greater than 1")
+    prop.exponent = exponent;
+    return prop;
+}
+
+} // namespace generator
+
+//==============================================================================
+
+template<typename vid_t>
+EdgeGenerator<vid_t>::EdgeGenerator(const GeneratorProp& prop, bool directed) :
+                                        _prop(prop),
+                                        _num_vertices(prop.num_vertices()),
+                                        _directed(directed) {
+    xlib::check_overflow<vid_t>(_num_vertices);
+    if (prop.type == GeneratorProp::Type::GNP)
+        countGnp();
+    else {
+        _num_edges = static_cast<size_t>(prop.edge_factor) * _num_vertices;
+    }
+}
+
+template<typename vid_t>
+EdgeGenerator<vid_t>::~EdgeGenerator() noexcept {
+    delete[] _block_offsets;
+}
+
+template<typename vid_t>
+size_t EdgeGenerator<vid_t>::num_vertices() const noexcept {
+    return _num_vertices;
+}
+
+template<typename vid_t>
+size_t EdgeGenerator<vid_t>::num_edges() const noexcept {
+    return _num_edges;
+}
+
+template<typename vid_t>
+void EdgeGenerator<vid_t>::generate(coo_t* coo_edges) const {
+    using Type = GeneratorProp::Type;
+    auto  seed = _prop.seed;
+    auto     n = static_cast<uint64_t>(_num_vertices);
+
+    if (_prop.type == Type::RMAT || _prop.type == Type::KRONECKER) {
+        auto   scale = _prop.scale;
+        auto  th_a   = threshold(_prop.a);
+        auto  th_ab  = threshold(_prop.a + _prop.b);
+        auto  th_abc = threshold(_prop.a + _prop.b + _prop.c);
+        bool  permute = _prop.type == Type::KRONECKER;
+        Scrambler scramble(scale, seed);
+
+        parallel_blocks(_num_edges, seed,
+            [&](std::mt19937_64& rng, size_t start, size_t end) {
+                for (auto i = start; i < end; i++) {
+                    uint64_t src = 0, dst = 0, bits = 0;
+                    //two levels for each 64-bit random value
+                    for (int level = 0; level < scale; level++) {
+                        if (level % 2 == 0)
+                            bits = rng();
+                        auto value = bits & 0xFFFFFFFF;
+                        bits >>= 32;
+                        //quadrants a, b, c, d without branches
+                        uint64_t src_bit = value >= th_ab;
+                        uint64_t dst_bit = (value >= th_a) ^ src_bit ^
+                                           (value >= th_abc);
+                        src = (src << 1) | src_bit;
+                        dst = (dst << 1) | dst_bit;
+                    }
+                    if (permute) {
+                        src = scramble(src);
+                        dst = scramble(dst);
+                    }
+                    coo_edges[i] = { static_cast<vid_t>(src),
+                                     static_cast<vid_t>(dst) };
+                }
+            });
+    }
+    else if (_prop.type == Type::GNM) {
+        parallel_blocks(_num_edges, seed,
+            [&](std::mt19937_64& rng, size_t start, size_t end) {
+                for (auto i = start; i < end; i++) {
+                    auto src = uniform_int(rng, n);
+                    auto dst = uniform_int(rng, n - 1);
+                    dst     += dst >= src ? 1 : 0;          //no self-loops
+                    coo_edges[i] = { static_cast<vid_t>(src),
+                                     static_cast<vid_t>(dst) };
+                }
+            });
+    }
+    else if (_prop.type == Type::CHUNG_LU) {
+        //inverse transform sampling of the density x^-alpha on [1, n + 1)
+        double alpha = 1.0 / (_prop.exponent - 1.0);
+        double  beta = 1.0 - alpha;
+        double   top = std::pow(static_cast<double>(n + 1), beta);
+        const auto& sample = [&](std::mt19937_64& rng) {
+                auto r = uniform(rng);
+                auto x = std::abs(beta) < 1e-9 ?
+                            std::pow(static_cast<double>(n + 1), r) :
+                            std::pow(1.0 + r * (top - 1.0), 1.0 / beta);
+                auto id = static_cast<uint64_t>(std::max(x, 1.0)) - 1;
+                return static_cast<vid_t>(std::min(id, n - 1));
+            };
+        parallel_blocks(_num_edges, seed,
+            [&](std::mt19937_64& rng, size_t start, size_t end) {
+                for (auto i = start; i < end; i++) {
+                    auto src     = sample(rng);
+                    coo_edges[i] = { src, sample(rng) };
+                }
+            });
+    }
+    else
+        generateGnp(coo_edges);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t>
+template<typename Lambda>
+void EdgeGenerator<vid_t>::visitGnpBlock(size_t block, const Lambda& emit)
+                                         const {
+    auto     n = static_cast<uint64_t>(_num_vertices);
+    auto    r0 = static_cast<uint64_t>(block * _rows_per_block);
+    auto    r1 = std::min<uint64_t>(r0 + _rows_per_block, n);
+    //the candidates of row u are [0, n) \ {u} (directed) or [0, u)
+    const auto& row_size = [&](uint64_t u) { return _directed ? n - 1 : u; };
+    uint64_t total = _directed ? (r1 - r0) * (n - 1)
+                               : (r0 + r1 - 1) * (r1 - r0) / 2;
+    double num_pairs = _directed ? static_cast<double>(n) * (n - 1)
+                                 : static_cast<double>(n) * (n - 1) / 2;
+    double p = std::min(_prop.edge_factor * static_cast<double>(n) /
+                        num_pairs, 1.0);
+    double log_q = std::log1p(-p);
+
+    std::mt19937_64 rng(block_seed(_prop.seed, block));
+    uint64_t pos = 0, u = r0, row_start = 0;
+    while (true) {
+        //geometric skip: number of pairs before the next edge
+        auto skip = std::floor(std::log1p(-uniform(rng)) / log_q);
+        if (skip >= static_cast<double>(total - pos))
+            break;
+        pos += static_cast<uint64_t>(skip);
+        while (pos - row_start >= row_size(u)) {
+            row_start += row_size(u);
+            u++;
+        }
+        auto k = pos - row_start;
+        auto v = _directed && k >= u ? k + 1 : k;
+        emit(static_cast<vid_t>(u), static_cast<vid_t>(v));
+        if (++pos == total)
+            break;
+    }
+}
+
+template<typename vid_t>
+void EdgeGenerator<vid_t>::countGnp() {
+    auto row_edges  = static_cast<size_t>(_prop.edge_factor);
+    _rows_per_block = std::max<size_t>(BLOCK_SIZE / row_edges, 1);
+    _num_blocks     = (_num_vertices + _rows_per_block - 1) / _rows_per_block;
+    _block_offsets  = new size_t[_num_blocks + 1];
+    _block_offsets[0] = 0;
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto first = xlib::thread_chunk(_num_blocks, thread_id,
+                                            num_threads);
+            auto  last = xlib::thread_chunk(_num_blocks, thread_id + 1,
+                                            num_threads);
+            for (auto block = first; block < last; block++) {
+                size_t count = 0;
+                visitGnpBlock(block, [&](vid_t, vid_t) { count++; });
+                _block_offsets[block + 1] = count;
+            }
+        });
+    for (size_t i = 0; i < _num_blocks; i++)
+        _block_offsets[i + 1] += _block_offsets[i];
+    _num_edges = _block_offsets[_num_blocks];
+}
+
+template<typename vid_t>
+void EdgeGenerator<vid_t>::generateGnp(coo_t* coo_edges) const {
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto first = xlib::thread_chunk(_num_blocks, thread_id,
+                                            num_threads);
+            auto  last = xlib::thread_chunk(_num_blocks, thread_id + 1,
+                                            num_threads);
+            for (auto block = first; block < last; block++) {
+                auto k = _block_offsets[block];
+                visitGnpBlock(block, [&](vid_t src, vid_t dst) {
+                                         coo_edges[k++] = { src, dst };
+                                     });
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t>
+template<typename weight_t>
+void EdgeGenerator<vid_t>::generate_weights(weight_t* weights,
+                                            size_t num_edges) const {
+    bool is_integral = std::is_integral<weight_t>::value;
+    if (is_integral && _prop.max_weight < 1.0)
+        ERROR("Generator: the maximum weight must be at least 1")
+    auto max_weight = _prop.max_weight;
+    auto max_int    = static_cast<uint64_t>(max_weight);
+
+    parallel_blocks(num_edges, _prop.seed ^ WEIGHT_SEED,
+        [&](std::mt19937_64& rng, size_t start, size_t end) {
+            for (auto i = start; i < end; i++) {
+                weights[i] = is_integral ?
+                    static_cast<weight_t>(uniform_int(rng, max_int) + 1) :
+                    static_cast<weight_t>(uniform(rng) * max_weight);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+
+template class EdgeGenerator<int>;
+template class EdgeGenerator<unsigned>;
+template class EdgeGenerator<int64_t>;
+
+template void EdgeGenerator<int>::generate_weights(int*, size_t) const;
+template void EdgeGenerator<int>::generate_weights(float*, size_t) const;
+template void EdgeGenerator<int64_t>::generate_weights(int64_t*, size_t)
+                                                       const;
+
+} // namespace graph
@@ -38,6 +38,7 @@
 #include "Host/FileUtil.hpp"//xlib::file_size
 #include "Host/Numeric.hpp" //xlib::check_overflow
 #include <iostream>                 //std::cout
+#include <memory>                   //std::unique_ptr
 #include <sstream>                  //std::istringstream
 
 namespace graph {
@@ -56,6 +57,55 @@ bool ParsingProp::is_randomize() const noexcept {
 bool ParsingProp::is_print() const noexcept {
     return *this & parsing_prop::PRINT_INFO;
 }
+
+bool ParsingProp::is_mmap() const noexcept {
+    return *this & parsing_prop::MMAP;
+}
+
+bool ParsingProp::is_pipeline() const noexcept {
+    return *this & parsing_prop::PIPELINE;
+}
+
+bool ParsingProp::is_cache() const noexcept {
+    return *this & parsing_prop::CACHE;
+}
+
+bool ParsingProp::is_low_memory() const noexcept {
+    return *this & parsing_prop::LOW_MEMORY;
+}
+
+namespace {
+
+std::string global_cache_directory;
+
+} // namespace
+
+void set_cache_directory(const std::string& directory) {
+    global_cache_directory = directory;
+}
+
+const std::string& cache_directory() noexcept {
+    return global_cache_directory;
+}
+
+namespace detail {
+
+void check_lines(const char* format, size_t expected, size_t found) {
+    if (found < expected) {
+        ERROR(format, ": ", expected, " entries declared in the header, ",
+              found, " found")
+    }
+}
+
+void check_edges(const char* format, size_t expected, size_t found) {
+    if (found != expected) {
+        ERROR(format, ": ", expected, " edges declared in the header, ",
+              found, " found")
+    }
+}
+
+} // namespace detail
+
 //------------------------------------------------------------------------------
 
 StructureProp::StructureProp(const detail::StructureEnum& value) noexcept :
@@ -134,6 +184,9 @@ void GraphBase<vid_t, eoff_t>::read(const char* filename,               //NOLINT
         readBinary(filename, prop.is_print());
         return;
     }
+    uint64_t cache_key = prop.is_cache() ? cacheKey(filename) : 0;
+    if (cache_key != 0 && readCache(filename, cache_key))
+        return;
 
     std::ifstream fin;
     //IO improvements START ----------------------------------------------------
@@ -148,45 +201,67 @@ void GraphBase<vid_t, eoff_t>::read(const char* filename,               //NOLINT
     fin >> first_str;
     fin.seekg(std::ios::beg);
 
+    const char* start = nullptr;
+    const char*   end = nullptr;
+#if defined(__linux__)
+    std::unique_ptr<xlib::MemoryMapped> memory_mapped;
+    if (prop.is_mmap()) {
+        fin.close();
+        memory_mapped.reset(new xlib::MemoryMapped(filename, size,
+                                             xlib::MemoryMapped::READ, false));
+        start = memory_mapped->read_ptr<char>(size);
+        end   = start + size;
+    }
+#endif
+    bool is_mmap = start != nullptr;
+
     if (file_ext == ".mtx" && first_str == "%%MatrixMarket") {
         if (prop.is_print())
             std::cout << "(Market)\n";
-        readMarket(fin, prop.is_print());
+        is_mmap ? readMarket(start, end, prop.is_print())
+                : readMarket(fin, prop.is_print());
     }
     else if (file_ext == ".graph") {
         if (prop.is_print())
             std::cout << "(Dimacs10th)\n";
-        readDimacs10(fin, prop.is_print());
+        is_mmap ? readDimacs10(start, end, prop.is_print())
+                : readDimacs10(fin, prop.is_print());
     }
     else if (file_ext == ".gr" && (first_str == "c"|| first_str == "p")) {
         if (prop.is_print())
             std::cout << "(Dimacs9th)\n";
-        readDimacs9(fin, prop.is_print());
+        is_mmap ? readDimacs9(start, end, prop.is_print())
+                : readDimacs9(fin, prop.is_print());
     }
     else if (file_ext == ".txt" && first_str == "#") {
         if (prop.is_print())
             std::cout << "(SNAP)\n";
-        readSnap(fin, prop.is_print());
+        is_mmap ? readSnap(start, end, prop.is_print())
+                : readSnap(fin, prop.is_print());
     }
     else if (file_ext == ".edges") {
         if (prop.is_print())
             std::cout << "(Net Repository)\n";
-        readNetRepo(fin);
+        is_mmap ? readNetRepo(start, end) : readNetRepo(fin);
     }
     else if (first_str == "%") {
         if (prop.is_print())
             std::cout << "(Konect)\n";
-        readKonect(fin, prop.is_print());
+        is_mmap ? readKonect(start, end, prop.is_print())
+                : readKonect(fin, prop.is_print());
     } else
         ERROR("Graph type not recognized");
-    fin.close();
+    if (!is_mmap)
+        fin.close();
     COOtoCSR();
+    if (cache_key != 0)
+        writeCache(filename, cache_key);
 }
 
 //==============================================================================
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getMarketHeader(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getMarketHeader(std::istream& fin) {
     std::string header_lines;
     std::getline(fin, header_lines);
     auto direction = header_lines.find("symmetric") != std::string::npos ?
@@ -213,7 +288,7 @@ GInfo GraphBase<vid_t, eoff_t>::getMarketHeader(std::ifstream& fin) {
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getDimacs9Header(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getDimacs9Header(std::istream& fin) {
     while (fin.peek() == 'c')
         xlib::skip_lines(fin);
 
@@ -227,7 +302,7 @@ GInfo GraphBase<vid_t, eoff_t>::getDimacs9Header(std::ifstream& fin) {
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getDimacs10Header(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getDimacs10Header(std::istream& fin) {
     while (fin.peek() == '%')
         xlib::skip_lines(fin);
 
@@ -235,46 +310,52 @@ GInfo GraphBase<vid_t, eoff_t>::getDimacs10Header(std::ifstream& fin) {
     fin >> num_vertices >> num_edges;
     StructureProp direction;
 
-    if (fin.peek() == '\n')
+    _stored_weights = false;
+    if (fin.peek() == '\n') {
         direction = structure_prop::UNDIRECTED;
+        xlib::skip_lines(fin);
+    }
     else {
         std::string flag;
         fin >> flag;
         direction = flag == "100" ? structure_prop::DIRECTED
                                   : structure_prop::UNDIRECTED;
-        if (flag == "1")
-            ERROR("Weighted Dimacs10th graphs not supported")
+        if (flag == "10" || flag == "11")
+            ERROR("Dimacs10th vertex weights not supported")
+        _stored_weights = flag == "1";
         xlib::skip_lines(fin);
     }
+    //the adjacency lists already store both directions of undirected edges
     if (direction == structure_prop::UNDIRECTED)
         num_edges *= 2;
-    _stored_undirected = direction == structure_prop::UNDIRECTED;
+    _stored_undirected = false;
     return { num_vertices, num_edges, num_vertices, direction };
 }
 
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getKonectHeader(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getKonectHeader(std::istream& fin) {
     std::string str;
     fin >> str >> str;
     auto direction = (str == "asym") || (str == "bip") ?
                         structure_prop::DIRECTED : structure_prop::UNDIRECTED;
-    size_t num_edges, value1, value2;
-    fin >> str >> num_edges >> value1 >> value2;
+    xlib::skip_lines(fin);
+    size_t num_lines, value1, value2;
+    fin >> str >> num_lines >> value1 >> value2;
     xlib::skip_lines(fin);
     if (str != "%")
         ERROR("Wrong file format")
-    if (direction == structure_prop::UNDIRECTED)
-        num_edges *= 2;
+    size_t num_edges = direction == structure_prop::UNDIRECTED ? num_lines * 2
+                                                               : num_lines;
     _stored_undirected = direction == structure_prop::UNDIRECTED;
-    return { std::max(value1, value2), num_edges, num_edges, direction };
+    return { std::max(value1, value2), num_edges, num_lines, direction };
 }
 
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-void GraphBase<vid_t, eoff_t>::getNetRepoHeader(std::ifstream& fin) {
+void GraphBase<vid_t, eoff_t>::getNetRepoHeader(std::istream& fin) {
     std::string str;
     fin >> str >> str;
     auto direction = (str == "directed") ? structure_prop::DIRECTED
@@ -286,7 +367,7 @@ void GraphBase<vid_t, eoff_t>::getNetRepoHeader(std::ifstream& fin) {
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getSnapHeader(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getSnapHeader(std::istream& fin) {
     std::string tmp;
     fin >> tmp >> tmp;
     StructureProp direction = (tmp == "Undirected") ? structure_prop::UNDIRECTED
@@ -313,13 +394,15 @@ GInfo GraphBase<vid_t, eoff_t>::getSnapHeader(std::ifstream& fin) {
 
 
 template<typename vid_t, typename eoff_t>
-GInfo GraphBase<vid_t, eoff_t>::getMPGHeader(std::ifstream& fin) {
+GInfo GraphBase<vid_t, eoff_t>::getMPGHeader(std::istream& fin) {
     return { 0, 0, 0, structure_prop::UNDIRECTED };
 }
 
 //------------------------------------------------------------------------------
 
 template class GraphBase<int, int>;
+template class GraphBase<int, int64_t>;
+template class GraphBase<unsigned, int64_t>;
 template class GraphBase<int64_t, int64_t>;
 
 } // namespace graph
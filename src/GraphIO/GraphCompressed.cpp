@@ -0,0 +1,195 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/GraphCompressed.hpp"
+#include "Host/Algorithm.hpp" //xlib::parallel_run, xlib::parallel_counting_sort
+#include "Host/Basic.hpp"     //ERROR
+#include <algorithm>          //std::fill, std::is_sorted, std::sort
+#include <new>                //std::bad_alloc
+#include <vector>             //std::vector
+
+namespace graph {
+
+template<typename vid_t, typename eoff_t>
+GraphCompressed<vid_t, eoff_t>
+::GraphCompressed(const GraphStd<vid_t, eoff_t>& graph) noexcept :
+        GraphCompressed(graph.out_offsets_ptr(), graph.nV(),
+                        graph.out_edges_ptr(), graph.nE()) {
+    _directed = graph.is_directed();
+}
+
+template<typename vid_t, typename eoff_t>
+GraphCompressed<vid_t, eoff_t>
+::GraphCompressed(const eoff_t* csr_offsets, vid_t nV,
+                  const vid_t* csr_edges, eoff_t nE) noexcept :
+                                                    _nV(nV), _nE(nE) {
+    compress(csr_offsets, csr_edges, _data, _byte_offsets, _degrees);
+}
+
+template<typename vid_t, typename eoff_t>
+GraphCompressed<vid_t, eoff_t>::~GraphCompressed() noexcept {
+    delete[] _data;
+    delete[] _byte_offsets;
+    delete[] _degrees;
+    delete[] _in_data;
+    delete[] _in_byte_offsets;
+    delete[] _in_degrees;
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphCompressed<vid_t, eoff_t>
+::compress(const eoff_t* csr_offsets, const vid_t* csr_edges,
+           uint8_t*& data, size_t*& byte_offsets, degree_t*& degrees)
+           const noexcept {
+    auto num_vertices = static_cast<size_t>(_nV);
+    try {
+        byte_offsets = new size_t[num_vertices + 1];
+        degrees      = new degree_t[num_vertices];
+    }
+    catch (const std::bad_alloc&) {
+        ERROR("OUT OF MEMORY: Graph too Large !!  V: ", _nV, " E: ", _nE)
+    }
+    //encoded size of the adjacency list of `vertex`, written to `output` if
+    //not null. Unsorted lists are sorted in the thread-local `buffer`
+    const auto& encode_op = [&](size_t vertex, std::vector<vid_t>& buffer,
+                                uint8_t* output) {
+            const vid_t* start = csr_edges + csr_offsets[vertex];
+            const vid_t*   end = csr_edges + csr_offsets[vertex + 1];
+            if (!std::is_sorted(start, end)) {
+                buffer.assign(start, end);
+                std::sort(buffer.begin(), buffer.end());
+                start = buffer.data();
+                end   = start + buffer.size();
+            }
+            size_t   bytes = 0;
+            uint64_t  prev = 0;
+            for (auto it = start; it != end; it++) {
+                auto gap = static_cast<uint64_t>(*it) - prev;
+                prev     = static_cast<uint64_t>(*it);
+                do {
+                    auto byte = static_cast<uint8_t>(gap & 0x7F);
+                    gap >>= 7;
+                    if (output != nullptr)
+                        output[bytes] = gap != 0 ? byte | 0x80 : byte;
+                    bytes++;
+                } while (gap != 0);
+            }
+            return bytes;
+        };
+
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(num_vertices, thread_id,
+                                            num_threads);
+            auto   end = xlib::thread_chunk(num_vertices, thread_id + 1,
+                                            num_threads);
+            std::vector<vid_t> buffer;
+            for (auto i = start; i < end; i++) {
+                degrees[i] = static_cast<degree_t>(csr_offsets[i + 1] -
+                                                   csr_offsets[i]);
+                byte_offsets[i + 1] = encode_op(i, buffer, nullptr);
+            }
+        });
+    byte_offsets[0] = 0;
+    xlib::parallel_prefix_sum(byte_offsets + 1, num_vertices,
+                              byte_offsets + 1);
+    try {
+        data = new uint8_t[byte_offsets[num_vertices]];
+    }
+    catch (const std::bad_alloc&) {
+        ERROR("OUT OF MEMORY: Graph too Large !!  V: ", _nV, " E: ", _nE)
+    }
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(num_vertices, thread_id,
+                                            num_threads);
+            auto   end = xlib::thread_chunk(num_vertices, thread_id + 1,
+                                            num_threads);
+            std::vector<vid_t> buffer;
+            for (auto i = start; i < end; i++)
+                encode_op(i, buffer, data + byte_offsets[i]);
+        });
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphCompressed<vid_t, eoff_t>::loadReverse() const {
+    std::lock_guard<std::mutex> lock(_reverse_mutex);
+    if (_reverse_ready.load(std::memory_order_relaxed))
+        return;
+    if (_directed) {
+        auto nV = static_cast<size_t>(_nV);
+        auto nE = static_cast<size_t>(_nE);
+        auto out_offsets = new eoff_t[nV + 1];
+        auto sources     = new vid_t[nE];
+        auto targets     = new vid_t[nE];
+        out_offsets[0] = 0;
+        xlib::parallel_prefix_sum(_degrees, nV, out_offsets + 1);
+        xlib::parallel_run([&](int thread_id, int num_threads) {
+                auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+                auto   end = xlib::thread_chunk(nV, thread_id + 1,
+                                                num_threads);
+                for (auto u = start; u < end; u++) {
+                    auto id = static_cast<vid_t>(u);
+                    std::fill(sources + out_offsets[u],
+                              sources + out_offsets[u + 1], id);
+                    vertex(id).decode(targets + out_offsets[u]);
+                }
+            });
+        //the stable counting sort by destination keeps the sources sorted
+        auto in_offsets = new eoff_t[nV + 1];
+        auto in_edges   = new vid_t[nE];
+        auto in_degrees = new degree_t[nV];
+        xlib::parallel_counting_sort(nE, nV,
+                                     [&](size_t i) { return targets[i]; },
+                                     [&](size_t i, eoff_t pos) {
+                                         in_edges[pos] = sources[i];
+                                     }, in_degrees, in_offsets);
+        delete[] out_offsets;
+        delete[] sources;
+        delete[] targets;
+        delete[] in_degrees;
+        compress(in_offsets, in_edges, _in_data, _in_byte_offsets,
+                 _in_degrees);
+        delete[] in_offsets;
+        delete[] in_edges;
+    }
+    _reverse_ready.store(true, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+
+template class GraphCompressed<int, int>;
+template class GraphCompressed<int, int64_t>;
+template class GraphCompressed<int64_t, int64_t>;
+
+} // namespace graph
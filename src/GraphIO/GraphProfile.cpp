@@ -0,0 +1,346 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/GraphProfile.hpp"
+#include "GraphIO/GraphStd.hpp"
+#include "Host/Algorithm.hpp"  //xlib::parallel_run, xlib::parallel_radix_sort
+#include "Host/Numeric.hpp"    //xlib::log2, xlib::ceil_log2, xlib::per_cent
+#include "Host/PrintExt.hpp"   //xlib::IosFlagSaver, xlib::ThousandSep
+#include <algorithm>           //std::binary_search, std::is_sorted, std::sort
+#include <cmath>               //std::sqrt
+#include <iomanip>             //std::setw
+#include <iostream>            //std::cout
+#include <string>              //std::to_string
+#include <type_traits>         //std::make_unsigned
+#include <vector>              //std::vector
+
+namespace graph {
+namespace {
+
+void add(GraphProfile& total, const GraphProfile& partial) noexcept {
+    total.max_out_degree      = std::max(total.max_out_degree,
+                                         partial.max_out_degree);
+    total.max_in_degree       = std::max(total.max_in_degree,
+                                         partial.max_in_degree);
+    total.out_degree_0       += partial.out_degree_0;
+    total.in_degree_0        += partial.in_degree_0;
+    total.out_degree_1       += partial.out_degree_1;
+    total.in_degree_1        += partial.in_degree_1;
+    total.self_loops         += partial.self_loops;
+    total.self_loop_vertices += partial.self_loop_vertices;
+    total.singletons         += partial.singletons;
+    total.out_leaves         += partial.out_leaves;
+    total.in_leaves          += partial.in_leaves;
+    total.reciprocal_edges   += partial.reciprocal_edges;
+    for (int i = 0; i < GraphProfile::NUM_BUCKETS; i++) {
+        total.out_vertices[i] += partial.out_vertices[i];
+        total.out_edges[i]    += partial.out_edges[i];
+        total.in_vertices[i]  += partial.in_vertices[i];
+    }
+}
+
+/**
+ * @brief Gini coefficient of `degrees` from their sorted order (parallel
+ *        radix sort of a copy)
+ */
+template<typename degree_t>
+double gini_coefficient(const degree_t* degrees, size_t size,
+                        uint64_t max_degree, uint64_t sum) {
+    using key_t = typename std::make_unsigned<degree_t>::type;
+    if (size == 0 || sum == 0)
+        return 0.0;
+    auto keys = new key_t[size];
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(size, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(size, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++)
+                keys[i] = static_cast<key_t>(degrees[i]);
+        });
+    xlib::parallel_radix_sort(keys, size,
+                              std::max(xlib::ceil_log2(max_degree + 1), 1));
+    //sum of (rank + 1) * degree
+    int  num_threads = xlib::num_threads();
+    std::vector<double> partial(num_threads);
+    xlib::parallel_run([&](int thread_id, int n) {
+            auto start = xlib::thread_chunk(size, thread_id, n);
+            auto   end = xlib::thread_chunk(size, thread_id + 1, n);
+            double numerator = 0.0;
+            for (auto i = start; i < end; i++)
+                numerator += static_cast<double>(i + 1) * keys[i];
+            partial[thread_id] = numerator;
+        }, num_threads);
+    delete[] keys;
+    double numerator = 0.0;
+    for (auto value : partial)
+        numerator += value;
+    auto n      = static_cast<double>(size);
+    auto result = 2.0 * numerator / (n * static_cast<double>(sum)) -
+                  (n + 1.0) / n;
+    return std::max(result, 0.0);
+}
+
+} // namespace
+
+//==============================================================================
+
+template<typename vid_t, typename eoff_t>
+GraphProfile GraphStd<vid_t, eoff_t>::profile() const {
+    auto       nV = static_cast<size_t>(_nV);
+    auto       nE = static_cast<size_t>(_nE);
+    bool directed = _structure.is_directed();
+    int  num_threads = xlib::num_threads();
+    auto partition   = balanced_partition(num_threads);
+    const auto& vertex_range_op = [&](const auto& op) {
+            xlib::parallel_run([&](int thread_id, int) {
+                    for (auto u = partition[thread_id];
+                         u < partition[thread_id + 1]; u++) {
+                        op(u);
+                    }
+                }, num_threads);
+        };
+    //the in-degrees of directed graphs are counted unless the reverse CSR is
+    //already built: it is not built for the in-degrees only
+    bool reverse_ready = _reverse_ready.load(std::memory_order_acquire);
+    const degree_t* in_degrees  = (!directed || reverse_ready) ? _in_degrees
+                                                               : nullptr;
+    degree_t*       tmp_degrees = nullptr;
+    if (in_degrees == nullptr) {
+        tmp_degrees      = new degree_t[nV];
+        auto tmp_offsets = new eoff_t[nV + 1];
+        xlib::parallel_counting_sort(nE, nV,
+                                     [&](size_t i) { return _out_edges[i]; },
+                                     [](size_t, eoff_t) {},
+                                     tmp_degrees, tmp_offsets);
+        delete[] tmp_offsets;
+        in_degrees = tmp_degrees;
+    }
+    //the reciprocal edges are searched in the sorted adjacency lists
+    const vid_t* sorted_edges = _out_edges;
+    vid_t*       tmp_edges    = nullptr;
+    if (directed) {
+        std::vector<char> sorted(num_threads, 1);
+        xlib::parallel_run([&](int thread_id, int) {
+                for (auto u = partition[thread_id];
+                     u < partition[thread_id + 1] && sorted[thread_id]; u++) {
+                    sorted[thread_id] = std::is_sorted(
+                                           _out_edges + _out_offsets[u],
+                                           _out_edges + _out_offsets[u + 1]);
+                }
+            }, num_threads);
+        if (std::find(sorted.begin(), sorted.end(), 0) != sorted.end()) {
+            tmp_edges = new vid_t[nE];
+            vertex_range_op([&](size_t u) {
+                    auto first = _out_offsets[u], last = _out_offsets[u + 1];
+                    std::copy(_out_edges + first, _out_edges + last,
+                              tmp_edges + first);
+                    std::sort(tmp_edges + first, tmp_edges + last);
+                });
+            sorted_edges = tmp_edges;
+        }
+    }
+    //--------------------------------------------------------------------------
+    // one pass over the vertices and the edges
+    std::vector<GraphProfile> partial(num_threads);
+    std::vector<double>       partial_sum2(num_threads);
+    xlib::parallel_run([&](int thread_id, int) {
+            GraphProfile local;
+            double       sum2 = 0.0;
+            for (auto u = partition[thread_id]; u < partition[thread_id + 1];
+                 u++) {
+                auto out_degree = static_cast<uint64_t>(_out_degrees[u]);
+                auto  in_degree = static_cast<uint64_t>(in_degrees[u]);
+                uint64_t  loops = 0;
+                for (auto i = _out_offsets[u]; i < _out_offsets[u + 1]; i++) {
+                    auto v = _out_edges[i];
+                    if (static_cast<size_t>(v) == u)
+                        loops++;
+                    else if (directed &&
+                             std::binary_search(
+                                        sorted_edges + _out_offsets[v],
+                                        sorted_edges + _out_offsets[v + 1],
+                                        static_cast<vid_t>(u))) {
+                        local.reciprocal_edges++;
+                    }
+                }
+                local.max_out_degree = std::max(local.max_out_degree,
+                                                out_degree);
+                local.max_in_degree  = std::max(local.max_in_degree,
+                                                in_degree);
+                local.out_degree_0  += out_degree == 0 ? 1 : 0;
+                local.out_degree_1  += out_degree == 1 ? 1 : 0;
+                local.in_degree_0   += in_degree == 0 ? 1 : 0;
+                local.in_degree_1   += in_degree == 1 ? 1 : 0;
+                local.self_loops    += loops;
+                local.self_loop_vertices += loops > 0 ? 1 : 0;
+                local.singletons    += out_degree == loops &&
+                                       in_degree == loops ? 1 : 0;
+                local.out_leaves    += out_degree - loops == 1 ? 1 : 0;
+                local.in_leaves     += in_degree - loops == 1 ? 1 : 0;
+                if (out_degree > 0) {
+                    auto bucket = xlib::log2(out_degree);
+                    local.out_vertices[bucket]++;
+                    local.out_edges[bucket] += out_degree;
+                }
+                if (in_degree > 0)
+                    local.in_vertices[xlib::log2(in_degree)]++;
+                sum2 += static_cast<double>(out_degree) *
+                        static_cast<double>(out_degree);
+            }
+            partial[thread_id]      = local;
+            partial_sum2[thread_id] = sum2;
+        }, num_threads);
+    delete[] tmp_degrees;
+    delete[] tmp_edges;
+    //--------------------------------------------------------------------------
+    GraphProfile result;
+    double sum2 = 0.0;
+    for (int i = 0; i < num_threads; i++) {
+        add(result, partial[i]);
+        sum2 += partial_sum2[i];
+    }
+    result.num_vertices = nV;
+    result.num_edges    = nE;
+    result.directed     = directed;
+    if (nV > 0) {
+        auto n = static_cast<double>(nV);
+        auto m = static_cast<double>(nE);
+        result.average_degree  = m / n;
+        result.std_deviation   = std::sqrt(std::max(sum2 / n -
+                                                    result.average_degree *
+                                                    result.average_degree,
+                                                    0.0));
+        result.variation_coeff = nE > 0 ? result.std_deviation /
+                                          result.average_degree : 0.0;
+        result.density         = m / (n * n);
+    }
+    result.gini = gini_coefficient(_out_degrees, nV, result.max_out_degree,
+                                   nE);
+    auto non_loops = nE - result.self_loops;
+    if (!directed)
+        result.reciprocal_edges = non_loops;
+    result.reciprocity = non_loops > 0 ?
+                            static_cast<double>(result.reciprocal_edges) /
+                            static_cast<double>(non_loops) : 0.0;
+    return result;
+}
+
+//==============================================================================
+
+void GraphProfile::print() const {
+    const int W1 = 30;
+    const int W2 = 14;
+    const int W3 = 8;
+    xlib::IosFlagSaver tmp1;
+    xlib::ThousandSep  tmp2;
+
+    const auto& row = [&](const char* name, uint64_t value) {
+            std::cout << std::setw(W1) << name << std::setw(W2) << value
+                      << std::setw(W3) << xlib::per_cent(value, num_vertices)
+                      << "%\n";
+        };
+    std::cout << "Degree analysis:"
+    << std::right << std::setprecision(1) << std::fixed << "\n\n"
+    << std::setw(W1) << "Average:  "             << std::setw(W2)
+                                                 << average_degree << "\n"
+    << std::setw(W1) << "Std. Deviation:  "      << std::setw(W2)
+                                                 << std_deviation << "\n"
+    << std::setw(W1) << "Coeff. of variation:  " << std::setw(W2)
+                                                 << variation_coeff << "\n"
+    << std::setw(W1) << "Gini Coeff:  "          << std::setprecision(2)
+                                                 << std::setw(W2)
+                                                 << gini << "\n"
+    << std::setw(W1) << "Density:  "             << std::setprecision(7)
+                                                 << std::setw(W2)
+                                                 << density << "\n"
+                                                 << std::setprecision(1)
+    << std::setw(W1) << "Max Out-Degree:  "      << std::setw(W2)
+                                                 << max_out_degree << "\n";
+    if (directed) {
+        std::cout << std::setw(W1) << "Max In-Degree:  " << std::setw(W2)
+                  << max_in_degree << "\n";
+    }
+    std::cout << std::setw(W1) << "Self-loops:  " << std::setw(W2)
+              << self_loops << "\n";
+    row("Rings:  ", self_loop_vertices);
+    row("Out-Degree = 0:  ", out_degree_0);
+    if (directed)
+        row("In-Degree = 0:  ", in_degree_0);
+    row("Out-Degree = 1:  ", out_degree_1);
+    if (directed)
+        row("In-Degree = 1:  ", in_degree_1);
+    row("Singletons:  ", singletons);
+    row(directed ? "Out-Leaves:  " : "Leaves:  ", out_leaves);
+    if (directed) {
+        row("In-Leaves:  ", in_leaves);
+        std::cout << std::setw(W1) << "Reciprocity:  " << std::setw(W2)
+                  << std::setprecision(3) << reciprocity << "\n";
+    }
+    std::cout << std::endl;
+}
+
+void GraphProfile::print_histogram() const {
+    int last = NUM_BUCKETS - 1;
+    while (last > 0 && out_vertices[last] == 0)
+        last--;
+    xlib::IosFlagSaver tmp1;
+    xlib::ThousandSep  tmp2;
+
+    const auto& table = [&](const char* title, const uint64_t* histogram,
+                            uint64_t total) {
+            std::cout << title << std::fixed << std::setprecision(1)
+                      << "\n\n";
+            for (int i = 0; i <= last; i++) {
+                auto exp = "  (2^" + std::to_string(i) + ")";
+                std::cout << std::right << std::setw(14) << (uint64_t(1) << i)
+                          << std::left  << std::setw(8)  << exp
+                          << std::right << std::setw(16) << histogram[i]
+                          << std::right << std::setw(7)
+                          << xlib::per_cent(histogram[i], total) << " %\n";
+            }
+        };
+    table("Degree distribution:", out_vertices, num_vertices);
+    std::cout << "\n";
+    table("Edge distribution:", out_edges, num_edges);
+    std::cout << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+template GraphProfile GraphStd<int, int>::profile() const;
+template GraphProfile GraphStd<int, int64_t>::profile() const;
+template GraphProfile GraphStd<unsigned, int64_t>::profile() const;
+template GraphProfile GraphStd<int64_t, int64_t>::profile() const;
+
+} // namespace graph
@@ -34,17 +34,220 @@
  * </blockquote>}
  */
 #include "GraphIO/GraphStd.hpp"
+#include "Host/Algorithm.hpp"  //xlib::parallel_radix_sort
 #include "Host/Basic.hpp"      //ERROR
-#include "Host/FileUtil.hpp"   //xlib::MemoryMapped
-#include "Host/Numeric.hpp"    //xlib::per_cent
+#include "Host/FileUtil.hpp"   //xlib::MemoryMapped, xlib::parallel_write
+#include "Host/Numeric.hpp"    //xlib::ceil_log2
 #include "Host/PrintExt.hpp"   //xlib::printArray
-#include "Host/Statistics.hpp" //xlib::average
-#include <algorithm>           //std::iota, std::shuffle
+#include <algorithm>           //std::shuffle, std::sort
+#include <atomic>              //std::atomic
 #include <cassert>             //assert
 #include <chrono>              //std::chrono
+#include <cstring>             //std::memcpy
+#include <numeric>             //std::iota
 #include <random>              //std::mt19937_64
+#include <string>              //std::to_string
+#include <sys/mman.h>          //::madvise
+#include <unistd.h>            //::sysconf
 
 namespace graph {
+namespace {
+
+/**
+ * @brief CSR of the graph relabeled with `permutation`
+ * @param[out] edge_map old position of each new edge
+ */
+template<typename vid_t, typename eoff_t, typename degree_t>
+void permute_csr(const vid_t* permutation, size_t nV, const eoff_t* offsets,
+                 const vid_t* edges, bool sort, eoff_t* new_offsets,
+                 vid_t* new_edges, degree_t* new_degrees, eoff_t* edge_map) {
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto v = start; v < end; v++) {
+                new_degrees[permutation[v]] =
+                                static_cast<degree_t>(offsets[v + 1] -
+                                                      offsets[v]);
+            }
+        });
+    new_offsets[0] = 0;
+    xlib::parallel_prefix_sum(new_degrees, nV, new_offsets + 1);
+
+    const auto& new_id = [&](eoff_t e) { return permutation[edges[e]]; };
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto v = start; v < end; v++) {
+                auto first = new_offsets[permutation[v]];
+                auto  last = first + (offsets[v + 1] - offsets[v]);
+                std::iota(edge_map + first, edge_map + last, offsets[v]);
+                if (sort) {
+                    std::sort(edge_map + first, edge_map + last,
+                              [&](eoff_t a, eoff_t b) {
+                                  return new_id(a) < new_id(b) ||
+                                         (new_id(a) == new_id(b) && a < b);
+                              });
+                }
+                for (auto i = first; i < last; i++)
+                    new_edges[i] = new_id(edge_map[i]);
+            }
+        });
+}
+
+/**
+ * @brief Return the whole pages of [begin, end) to the operating system.
+ *        The range stays allocated (zero-filled on the next access)
+ */
+void release_pages(void* begin, void* end) noexcept {
+#if defined(__linux__)
+    auto  page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    auto first = (reinterpret_cast<uintptr_t>(begin) + page - 1) & ~(page - 1);
+    auto  last = reinterpret_cast<uintptr_t>(end) & ~(page - 1);
+    if (first < last)
+        ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#endif
+}
+
+/**
+ * @brief Parallel histogram of `key(i)` for every `i` in [0, size) with
+ *        atomic counters (no per-thread histograms: LOW_MEMORY)
+ */
+template<typename T, typename KeyOp>
+void atomic_histogram(size_t size, size_t num_keys, const KeyOp& key,
+                      T* counts) {
+    auto counters = new std::atomic<T>[num_keys];
+    const auto& key_range_op = [&](const auto& op) {
+            xlib::parallel_run([&](int thread_id, int num_threads) {
+                    auto start = xlib::thread_chunk(num_keys, thread_id,
+                                                    num_threads);
+                    auto   end = xlib::thread_chunk(num_keys, thread_id + 1,
+                                                    num_threads);
+                    for (auto k = start; k < end; k++)
+                        op(k);
+                });
+        };
+    key_range_op([&](size_t k) { counters[k].store(0); });
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(size, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(size, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                counters[static_cast<size_t>(key(i))].fetch_add(
+                                                1, std::memory_order_relaxed);
+            }
+        });
+    key_range_op([&](size_t k) { counts[k] = counters[k].load(); });
+    delete[] counters;
+}
+
+/**
+ * @brief In-place parallel partition of `array` in buckets (as PARADIS).
+ *        `offsets` holds the final boundaries of the buckets
+ * @details Each round splits the part of every bucket which is not yet
+ *          placed among the threads. Each thread swaps the items into its
+ *          share of their bucket; the items whose share is full are moved to
+ *          the end of the current share and, after the round, to the end of
+ *          the bucket, which is the input of the next round
+ */
+template<typename T, typename BucketOp>
+void parallel_bucket_partition(T* array, const std::vector<size_t>& offsets,
+                               const BucketOp& bucket, int num_threads) {
+    const size_t MIN_PARALLEL_ITEMS = 65536;
+    auto num_buckets = offsets.size() - 1;
+    //[head[b], offsets[b + 1]): items of the b-th bucket not yet placed
+    std::vector<size_t> head(offsets.begin(), offsets.end() - 1);
+    auto unplaced = offsets[num_buckets] - offsets[0];
+    bool sequential = false;
+    while (unplaced > 0) {
+        //a single thread places all the items in one round
+        sequential   = sequential || unplaced < MIN_PARALLEL_ITEMS;
+        int  threads = sequential ? 1 : num_threads;
+        auto size    = static_cast<size_t>(threads) * num_buckets;
+        //share of the thread t in the bucket b (index t * num_buckets + b):
+        //[start, pos) placed, [pos, end) unprocessed, [end, stop) misplaced
+        std::vector<size_t> start(size), pos(size), end(size), stop(size);
+        for (size_t b = 0; b < num_buckets; b++) {
+            auto length = offsets[b + 1] - head[b];
+            for (int t = 0; t < threads; t++) {
+                auto k = static_cast<size_t>(t) * num_buckets + b;
+                start[k] = pos[k] = head[b] + xlib::thread_chunk(length, t,
+                                                                 threads);
+                end[k] = stop[k] = head[b] + xlib::thread_chunk(length, t + 1,
+                                                                threads);
+            }
+        }
+        xlib::parallel_run([&](int thread_id, int) {
+                auto t_pos = pos.data() + thread_id * num_buckets;
+                auto t_end = end.data() + thread_id * num_buckets;
+                for (size_t b = 0; b < num_buckets; b++) {
+                    while (t_pos[b] < t_end[b]) {
+                        auto item = array[t_pos[b]];
+                        auto k    = bucket(item);
+                        while (k != b && t_pos[k] < t_end[k]) {
+                            std::swap(item, array[t_pos[k]++]);
+                            k = bucket(item);
+                        }
+                        if (k == b)
+                            array[t_pos[b]++] = item;
+                        else {
+                            t_end[b]--;
+                            array[t_pos[b]] = array[t_end[b]];
+                            array[t_end[b]] = item;
+                        }
+                    }
+                }
+            }, threads);
+        //----------------------------------------------------------------------
+        // the misplaced items of each bucket are swapped with the last placed
+        // ones
+        xlib::parallel_run([&](int thread_id, int n) {
+                auto first = xlib::thread_chunk(num_buckets, thread_id, n);
+                auto  last = xlib::thread_chunk(num_buckets, thread_id + 1, n);
+                for (auto b = first; b < last; b++) {
+                    size_t misplaced = 0;
+                    for (int t = 0; t < threads; t++) {
+                        auto k = static_cast<size_t>(t) * num_buckets + b;
+                        misplaced += stop[k] - end[k];
+                    }
+                    //front: next misplaced item, back: after the last placed
+                    int    front_t = 0, back_t = threads - 1;
+                    size_t front   = end[b];
+                    size_t back    = end[static_cast<size_t>(back_t) *
+                                         num_buckets + b];
+                    while (true) {
+                        while (front_t < threads &&
+                               front == stop[static_cast<size_t>(front_t) *
+                                             num_buckets + b]) {
+                            if (++front_t < threads) {
+                                front = end[static_cast<size_t>(front_t) *
+                                            num_buckets + b];
+                            }
+                        }
+                        while (back_t >= 0 &&
+                               back == start[static_cast<size_t>(back_t) *
+                                             num_buckets + b]) {
+                            if (--back_t >= 0) {
+                                back = end[static_cast<size_t>(back_t) *
+                                           num_buckets + b];
+                            }
+                        }
+                        if (front_t == threads || back_t < 0 || front >= back)
+                            break;
+                        std::swap(array[front++], array[--back]);
+                    }
+                    head[b] = offsets[b + 1] - misplaced;
+                }
+            }, threads);
+
+        size_t left = 0;
+        for (size_t b = 0; b < num_buckets; b++)
+            left += offsets[b + 1] - head[b];
+        //no progress (unbalanced shares): the next round is sequential
+        sequential = left == unplaced;
+        unplaced   = left;
+    }
+}
+
+} // namespace
 
 template<typename vid_t, typename eoff_t>
 GraphStd<vid_t, eoff_t>::GraphStd(const eoff_t* csr_offsets, vid_t nV,
@@ -126,11 +329,14 @@ void GraphStd<vid_t, eoff_t>::allocate(const GInfo& ginfo) noexcept {
         std::cout << std::right << std::endl;
     }
 
+    //with parsing_prop::LOW_MEMORY the edges are built in the COO array
+    bool low_memory = is_low_memory_enabled();
     try {
         _out_offsets = new eoff_t[ _nV + 1 ];
-        _out_edges   = new vid_t[ _nE ];
+        _out_edges   = low_memory ? nullptr : new vid_t[ _nE ];
         _out_degrees = new degree_t[ _nV ]();
         _coo_edges   = new coo_t[ _nE ];
+        _coo_size    = static_cast<size_t>(_nE);
         if (_structure.is_undirected()) {
             _in_degrees = _out_degrees;
             _in_offsets = _out_offsets;
@@ -138,7 +344,7 @@ void GraphStd<vid_t, eoff_t>::allocate(const GInfo& ginfo) noexcept {
         }
         else if (_structure.is_reverse()) {
             _in_offsets = new eoff_t[ _nV + 1 ];
-            _in_edges   = new vid_t[ _nE ];
+            _in_edges   = low_memory ? nullptr : new vid_t[ _nE ];
             _in_degrees = new degree_t[ _nV ]();
         }
     }
@@ -147,17 +353,204 @@ void GraphStd<vid_t, eoff_t>::allocate(const GInfo& ginfo) noexcept {
     }
 }
 
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::generate(const GeneratorProp& generator,
+                                       const ParsingProp& property) {
+    _graph_name = generator.name();
+    _prop       = property;
+    if (property.is_print()) {
+        std::cout << "\nGenerator: " << _graph_name << "  (seed: " << std::hex
+                  << generator.seed << std::dec << ")" << std::endl;
+    }
+    bool directed = _structure.is_directed();
+    EdgeGenerator<vid_t> edge_generator(generator, directed);
+    auto num_lines = edge_generator.num_edges();
+    auto direction = directed ? structure_prop::DIRECTED
+                              : structure_prop::UNDIRECTED;
+    allocate({ edge_generator.num_vertices(),
+               directed ? num_lines : num_lines * 2, num_lines, direction });
+    _stored_undirected = !directed;
+
+    edge_generator.generate(_coo_edges);
+    generateWeights(edge_generator, num_lines);
+    COOtoCSR();
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::generateWeights(const EdgeGenerator<vid_t>&,
+                                              size_t) {}
+
 template<typename vid_t, typename eoff_t>
 GraphStd<vid_t, eoff_t>::~GraphStd() noexcept {
-    delete[] _out_offsets;
-    delete[] _out_edges;
-    delete[] _out_degrees;
+    freeCSR();
     delete[] _coo_edges;
-    if (_structure.is_directed() && _structure.is_reverse()) {
+    delete[] _out_histograms;
+    delete[] _in_histograms;
+#if defined(__linux__)
+    delete _memory_mapped;
+    delete _binary_file;
+#endif
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::freeCSR() noexcept {
+    bool twice = _structure.is_directed() && _structure.is_reverse();
+    if (!_mapped_csr) {
+        delete[] _out_offsets;
+        if (_packed_edges)
+            delete[] reinterpret_cast<coo_t*>(_out_edges);
+        else
+            delete[] _out_edges;
+        if (twice) {
+            delete[] _in_offsets;
+            if (!_packed_edges)
+                delete[] _in_edges;
+        }
+    }
+    if (!_mapped_degrees) {
+        delete[] _out_degrees;
+        if (twice)
+            delete[] _in_degrees;
+    }
+    if (_reverse_on_demand) {
         delete[] _in_offsets;
         delete[] _in_edges;
         delete[] _in_degrees;
     }
+    _mapped_csr        = false;
+    _mapped_degrees    = false;
+    _packed_edges      = false;
+    _reverse_on_demand = false;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::loadReverse() const {
+    std::lock_guard<std::mutex> lock(_reverse_mutex);
+    if (_reverse_ready.load(std::memory_order_relaxed) ||
+            _out_offsets == nullptr) {
+        return;
+    }
+#if defined(__linux__)
+    if (_in_offsets == nullptr && _binary_file != nullptr)
+        readReverseSections();
+#endif
+    if (_in_offsets == nullptr && _structure.is_directed()) {
+        if (_prop.is_print())
+            std::cout << "Building the reverse CSR..." << std::endl;
+        buildReverse();
+        _reverse_on_demand = true;
+    }
+    _reverse_ready.store(true, std::memory_order_release);
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::buildReverse() const {
+    transposeCSR(nullptr);
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::transposeCSR(eoff_t* edge_map) const {
+    auto nV = static_cast<size_t>(_nV);
+    auto nE = static_cast<size_t>(_nE);
+    _in_offsets = new eoff_t[nV + 1];
+    _in_edges   = new vid_t[nE];
+    _in_degrees = new degree_t[nV];
+    //source of each out-edge: the stable counting sort by destination keeps
+    //the sources in ascending order
+    auto sources   = new vid_t[nE];
+    auto partition = balanced_partition(xlib::num_threads());
+    xlib::parallel_run([&](int thread_id, int) {
+            for (auto u = partition[thread_id]; u < partition[thread_id + 1];
+                 u++) {
+                std::fill(sources + _out_offsets[u],
+                          sources + _out_offsets[u + 1],
+                          static_cast<vid_t>(u));
+            }
+        });
+    xlib::parallel_counting_sort(nE, nV,
+                                 [&](size_t i) { return _out_edges[i]; },
+                                 [&](size_t i, eoff_t pos) {
+                                     _in_edges[pos] = sources[i];
+                                     if (edge_map != nullptr)
+                                         edge_map[pos] = static_cast<eoff_t>(i);
+                                 }, _in_degrees, _in_offsets);
+    delete[] sources;
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::release_reverse() noexcept {
+    std::lock_guard<std::mutex> lock(_reverse_mutex);
+    if (_structure.is_undirected())
+        return;
+    if (_reverse_on_demand) {
+        delete[] _in_offsets;
+        delete[] _in_edges;
+        delete[] _in_degrees;
+    }
+    else {
+        //reverse CSR of structure_prop::REVERSE (file, mapping or packed COO)
+        if (!_mapped_csr) {
+            delete[] _in_offsets;
+            if (_packed_edges && _in_edges != nullptr)
+                release_pages(_in_edges, _in_edges + _nE);
+            else if (!_packed_edges)
+                delete[] _in_edges;
+        }
+        if (!_mapped_degrees)
+            delete[] _in_degrees;
+#if defined(__linux__)
+        if (_binary_file != nullptr) {
+            _binary_file->unmap(binary::Section::IN_OFFSETS);
+            _binary_file->unmap(binary::Section::IN_EDGES);
+            _binary_file->unmap(binary::Section::IN_DEGREES);
+        }
+#endif
+        _structure -= structure_prop::REVERSE;
+    }
+    _in_offsets        = nullptr;
+    _in_edges          = nullptr;
+    _in_degrees        = nullptr;
+    _reverse_on_demand = false;
+    _reverse_ready.store(false, std::memory_order_release);
+}
+
+template<typename vid_t, typename eoff_t>
+eoff_t GraphStd<vid_t, eoff_t>::sortCOO(bool remove_duplicates) noexcept {
+    auto nE   = static_cast<size_t>(_nE);
+    int  bits = _nV > 1 ? xlib::ceil_log2(_nV) : 1;
+    if (2 * bits > 64) {
+        std::sort(_coo_edges, _coo_edges + _nE);
+        auto last = remove_duplicates ? std::unique(_coo_edges,
+                                                    _coo_edges + _nE)
+                                      : _coo_edges + _nE;
+        return static_cast<eoff_t>(std::distance(_coo_edges, last));
+    }
+    auto keys = new uint64_t[nE];
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nE, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                keys[i] = (static_cast<uint64_t>(_coo_edges[i].first) << bits)
+                          | static_cast<uint64_t>(_coo_edges[i].second);
+            }
+        });
+    xlib::parallel_radix_sort(keys, nE, 2 * bits);
+    if (remove_duplicates)
+        nE = static_cast<size_t>(std::distance(keys, std::unique(keys,
+                                                                 keys + nE)));
+    auto mask = (uint64_t(1) << bits) - 1;
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nE, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                _coo_edges[i] = { static_cast<vid_t>(keys[i] >> bits),
+                                  static_cast<vid_t>(keys[i] & mask) };
+            }
+        });
+    delete[] keys;
+    return static_cast<eoff_t>(nE);
 }
 
 template<typename vid_t, typename eoff_t>
@@ -180,15 +573,15 @@ void GraphStd<vid_t, eoff_t>::COOtoCSR() noexcept {
 
     }
 
-    if (_directed_to_undirected) {
+    //the duplicated edges are removed by buildCSRInPlace()
+    bool low_memory = is_low_memory_enabled();
+    if (_directed_to_undirected && !low_memory) {
         if (_prop.is_print()) {
             if (_directed_to_undirected)
                 std::cout << "Directed to Undirected: ";
             std::cout << "Removing duplicated edges..." << std::flush;
         }
-        std::sort(_coo_edges, _coo_edges + _nE);
-        auto   last = std::unique(_coo_edges, _coo_edges + _nE);
-        auto new_nE = std::distance(_coo_edges, last);
+        auto new_nE = sortCOO(true);
         if (_prop.is_print() && new_nE != _nE) {
             std::cout << "(" << xlib::format(_nE - new_nE) << " edges removed)"
                       << std::endl;
@@ -217,56 +610,309 @@ void GraphStd<vid_t, eoff_t>::COOtoCSR() noexcept {
             _coo_edges[i].first  = random_array[ _coo_edges[i].first ];
             _coo_edges[i].second = random_array[ _coo_edges[i].second ];
         }
+        if (!_id_map.empty())
+            _id_map.permute(random_array);
         delete[] random_array;
     }
-    if (_prop.is_sort() && (!_directed_to_undirected || _prop.is_randomize())) {
+    if (_prop.is_sort() && !low_memory &&
+            (!_directed_to_undirected || _prop.is_randomize())) {
         if (_prop.is_print())
             std::cout << "Sorting..." << std::endl;
-        std::sort(_coo_edges, _coo_edges + _nE);
+        sortCOO(false);
     }
     //--------------------------------------------------------------------------
     if (_prop.is_print())
         std::cout << "COO to CSR...\t" << std::flush;
+    if (low_memory) {
+        buildCSRInPlace();
+        if (_prop.is_print())
+            std::cout << "Complete!\n" << std::endl;
+        reorderByProperty();
+        return;
+    }
 
-    if (_structure.is_reverse() && _structure.is_directed()) {
-        for (eoff_t i = 0; i < _nE; i++) {
-            _out_degrees[_coo_edges[i].first]++;
-            _in_degrees[ _coo_edges[i].second]++;
+    auto nE = static_cast<size_t>(_nE);
+    auto nV = static_cast<size_t>(_nV);
+    const auto& out_key     = [&](size_t i) { return _coo_edges[i].first; };
+    const auto& out_scatter = [&](size_t i, eoff_t pos) {
+                                    _out_edges[pos] = _coo_edges[i].second;
+                                };
+    const auto& in_key      = [&](size_t i) { return _coo_edges[i].second; };
+    const auto& in_scatter  = [&](size_t i, eoff_t pos) {
+                                    _in_edges[pos] = _coo_edges[i].first;
+                                };
+    bool twice = _structure.is_directed() && _structure.is_reverse();
+    if (_out_histograms != nullptr) {
+        //the histograms have been built during the parsing
+        auto num_threads = xlib::counting_sort_threads(nE, nV);
+        xlib::parallel_counting_scatter(nE, nV, out_key, out_scatter,
+                                        _out_histograms, _out_degrees,
+                                        _out_offsets, num_threads);
+        if (twice) {
+            xlib::parallel_counting_scatter(nE, nV, in_key, in_scatter,
+                                            _in_histograms, _in_degrees,
+                                            _in_offsets, num_threads);
         }
+        delete[] _out_histograms;
+        delete[] _in_histograms;
+        _out_histograms = nullptr;
+        _in_histograms  = nullptr;
     }
     else {
-        for (eoff_t i = 0; i < _nE; i++)
-            _out_degrees[_coo_edges[i].first]++;
+        xlib::parallel_counting_sort(nE, nV, out_key, out_scatter,
+                                     _out_degrees, _out_offsets);
+        if (twice) {
+            xlib::parallel_counting_sort(nE, nV, in_key, in_scatter,
+                                         _in_degrees, _in_offsets);
+        }
+    }
+    if (!_structure.is_coo()) {
+        delete[] _coo_edges;
+        _coo_edges = nullptr;
     }
+    if (_prop.is_print())
+        std::cout << "Complete!\n" << std::endl;
+    reorderByProperty();
+}
 
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::buildCSRInPlace() {
+    auto    nV = static_cast<size_t>(_nV);
+    auto    nE = static_cast<size_t>(_nE);
+    bool twice = _structure.is_directed() && _structure.is_reverse();
+    int  num_threads = xlib::num_threads();
+    atomic_histogram(nE, nV, [&](size_t i) { return _coo_edges[i].first; },
+                     _out_degrees);
     _out_offsets[0] = 0;
-    std::partial_sum(_out_degrees, _out_degrees + _nV, _out_offsets + 1);
+    xlib::parallel_prefix_sum(_out_degrees, nV, _out_offsets + 1);
+    //--------------------------------------------------------------------------
+    // in-place permutation by source. The edges are first partitioned in
+    // ranges of sources with the same number of edges, then each thread
+    // permutes one range: each edge is swapped into the next free position
+    // of its vertex until the edge of the current position is found
+    auto partition = balanced_partition(num_threads);
+    std::vector<size_t> range_offsets(partition.size());
+    for (size_t k = 0; k < partition.size(); k++)
+        range_offsets[k] = static_cast<size_t>(_out_offsets[partition[k]]);
+    const auto& range_of = [&](const coo_t& edge) {
+            auto it = std::upper_bound(partition.begin(), partition.end(),
+                                       static_cast<size_t>(edge.first));
+            return static_cast<size_t>(it - partition.begin()) - 1;
+        };
+    parallel_bucket_partition(_coo_edges, range_offsets, range_of,
+                              num_threads);
 
-    auto tmp = new degree_t[_nV]();
-    for (eoff_t i = 0; i < _nE; i++) {
-        vid_t  src = _coo_edges[i].first;
-        vid_t dest = _coo_edges[i].second;
-        _out_edges[ _out_offsets[src] + tmp[src]++ ] = dest;
+    auto next = new eoff_t[nV];
+    std::copy(_out_offsets, _out_offsets + nV, next);
+    xlib::parallel_run([&](int thread_id, int) {
+            for (auto v = partition[thread_id];
+                 v < partition[thread_id + 1]; v++) {
+                for (auto i = next[v]; i < _out_offsets[v + 1]; i = next[v]) {
+                    auto edge = _coo_edges[i];
+                    while (static_cast<size_t>(edge.first) != v)
+                        std::swap(edge, _coo_edges[next[edge.first]++]);
+                    _coo_edges[i] = edge;
+                    next[v]++;
+                }
+            }
+        }, num_threads);
+    delete[] next;
+    //--------------------------------------------------------------------------
+    // destinations into the first half of the array (byte copies): the
+    // destination of the i-th edge overwrites the edge i / 2 only, so the
+    // edges [m, 2m) are moved in parallel after the edges [0, m)
+    auto bytes = reinterpret_cast<char*>(_coo_edges);
+    const auto& move_edges = [&](size_t first, size_t last) {
+            for (auto i = first; i < last; i++) {
+                vid_t dst = _coo_edges[i].second;
+                std::memcpy(bytes + i * sizeof(vid_t), &dst, sizeof(vid_t));
+            }
+        };
+    const size_t MIN_PARALLEL_EDGES = 65536;
+    move_edges(0, std::min(MIN_PARALLEL_EDGES, nE));
+    for (auto m = MIN_PARALLEL_EDGES; m < nE; m *= 2) {
+        auto last = std::min(2 * m, nE);
+        xlib::parallel_run([&](int thread_id, int n) {
+                move_edges(m + xlib::thread_chunk(last - m, thread_id, n),
+                           m + xlib::thread_chunk(last - m, thread_id + 1, n));
+            }, num_threads);
     }
-
-    if (_structure.is_directed() && _structure.is_reverse()) {
+    auto edges = reinterpret_cast<vid_t*>(bytes);
+    _coo_edges = nullptr;
+    //--------------------------------------------------------------------------
+    if (_prop.is_sort() || _directed_to_undirected) {
+        bool unique = _directed_to_undirected;
+        xlib::parallel_run([&](int thread_id, int num_threads) {
+                auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+                auto   end = xlib::thread_chunk(nV, thread_id + 1,
+                                                num_threads);
+                for (auto v = start; v < end; v++) {
+                    auto first = edges + _out_offsets[v];
+                    auto  last = edges + _out_offsets[v + 1];
+                    std::sort(first, last);
+                    if (unique) {
+                        _out_degrees[v] = static_cast<degree_t>(
+                                     std::distance(first,
+                                                   std::unique(first, last)));
+                    }
+                }
+            });
+        if (unique) {
+            eoff_t k = 0;
+            for (size_t v = 0; v < nV; v++) {
+                auto first = edges + _out_offsets[v];
+                if (first != edges + k)
+                    std::copy(first, first + _out_degrees[v], edges + k);
+                _out_offsets[v] = k;
+                k += _out_degrees[v];
+            }
+            _out_offsets[nV] = k;
+            if (_prop.is_print() && k != _nE) {
+                std::cout << "(" << xlib::format(_nE - k)
+                          << " duplicated edges removed) ";
+            }
+            _nE = k;
+            nE  = static_cast<size_t>(k);
+        }
+    }
+    //--------------------------------------------------------------------------
+    // reverse CSR: transposition into the second half of the array. The
+    // incoming edges of each vertex are sorted by source
+    if (twice) {
+        auto in_edges = edges + nE;
+        atomic_histogram(nE, nV, [&](size_t i) { return edges[i]; },
+                         _in_degrees);
         _in_offsets[0] = 0;
-        std::partial_sum(_in_degrees, _in_degrees + _nV, _in_offsets + 1);
-        std::fill(tmp, tmp + _nV, 0);
-        for (eoff_t i = 0; i < _nE; i++) {
-            vid_t dest = _coo_edges[i].second;
-            _in_edges[ _in_offsets[dest] + tmp[dest]++ ] = _coo_edges[i].first;
+        xlib::parallel_prefix_sum(_in_degrees, nV, _in_offsets + 1);
+
+        auto in_next = new std::atomic<eoff_t>[nV];
+        xlib::parallel_run([&](int thread_id, int n) {
+                auto start = xlib::thread_chunk(nV, thread_id, n);
+                auto   end = xlib::thread_chunk(nV, thread_id + 1, n);
+                for (auto v = start; v < end; v++)
+                    in_next[v].store(_in_offsets[v]);
+            });
+        partition = balanced_partition(num_threads);
+        xlib::parallel_run([&](int thread_id, int) {
+                for (auto v = partition[thread_id];
+                     v < partition[thread_id + 1]; v++) {
+                    for (auto i = _out_offsets[v]; i < _out_offsets[v + 1];
+                         i++) {
+                        auto pos = in_next[edges[i]].fetch_add(1,
+                                                    std::memory_order_relaxed);
+                        in_edges[pos] = static_cast<vid_t>(v);
+                    }
+                }
+            }, num_threads);
+        delete[] in_next;
+        //the threads fill the incoming lists in any order
+        if (num_threads > 1) {
+            xlib::parallel_run([&](int thread_id, int n) {
+                    auto start = xlib::thread_chunk(nV, thread_id, n);
+                    auto   end = xlib::thread_chunk(nV, thread_id + 1, n);
+                    for (auto v = start; v < end; v++) {
+                        std::sort(in_edges + _in_offsets[v],
+                                  in_edges + _in_offsets[v + 1]);
+                    }
+                }, num_threads);
         }
     }
-    delete[] tmp;
-    if (!_structure.is_coo()) {
-        delete[] _coo_edges;
-        _coo_edges = nullptr;
+    else {
+        //the second half of the array is not used
+        release_pages(edges + nE, edges + 2 * _coo_size);
+    }
+    _out_edges    = edges;
+    _in_edges     = twice ? edges + nE
+                          : (_structure.is_undirected() ? edges : nullptr);
+    _packed_edges = true;
+}
+
+template<typename vid_t, typename eoff_t>
+std::vector<vid_t> GraphStd<vid_t, eoff_t>::reorder(Reordering type) {
+    auto    nV = static_cast<size_t>(_nV);
+    auto    nE = static_cast<size_t>(_nE);
+    bool twice = _structure.is_directed() && _structure.is_reverse();
+    //a reverse CSR built on demand is built again after the relabeling
+    if (twice)
+        lazy_reverse();
+    else
+        release_reverse();
+    std::vector<vid_t> permutation(nV);
+    reorder_permutation(type, _out_offsets, _out_edges, nV,
+                        permutation.data());
+
+    auto out_offsets = new eoff_t[nV + 1];
+    auto out_edges   = new vid_t[nE];
+    auto out_degrees = new degree_t[nV];
+    auto out_map     = new eoff_t[nE];
+    permute_csr(permutation.data(), nV, _out_offsets, _out_edges,
+                _prop.is_sort(), out_offsets, out_edges, out_degrees, out_map);
+    eoff_t*   in_offsets = nullptr;
+    vid_t*    in_edges   = nullptr;
+    degree_t* in_degrees = nullptr;
+    eoff_t*   in_map     = nullptr;
+    if (twice) {
+        in_offsets = new eoff_t[nV + 1];
+        in_edges   = new vid_t[nE];
+        in_degrees = new degree_t[nV];
+        in_map     = new eoff_t[nE];
+        permute_csr(permutation.data(), nV, _in_offsets, _in_edges,
+                    _prop.is_sort(), in_offsets, in_edges, in_degrees, in_map);
+    }
+    permuteEdgeData(out_map, in_map);
+    delete[] out_map;
+    delete[] in_map;
+
+    freeCSR();
+    _out_offsets = out_offsets;
+    _out_edges   = out_edges;
+    _out_degrees = out_degrees;
+    _in_offsets  = twice ? in_offsets : (_structure.is_undirected() ?
+                                         out_offsets : nullptr);
+    _in_edges    = twice ? in_edges   : (_structure.is_undirected() ?
+                                         out_edges : nullptr);
+    _in_degrees  = twice ? in_degrees : (_structure.is_undirected() ?
+                                         out_degrees : nullptr);
+
+    if (_coo_edges != nullptr) {
+        xlib::parallel_run([&](int thread_id, int num_threads) {
+                auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+                auto   end = xlib::thread_chunk(nE, thread_id + 1,
+                                                num_threads);
+                for (auto i = start; i < end; i++) {
+                    _coo_edges[i] = { permutation[_coo_edges[i].first],
+                                      permutation[_coo_edges[i].second] };
+                }
+            });
+    }
+    if (!_id_map.empty())
+        _id_map.permute(permutation.data());
+    return permutation;
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::reorderByProperty() {
+    const std::pair<ParsingProp, Reordering> orderings[] = {
+        { parsing_prop::DEGREE_ORDER,    Reordering::DEGREE },
+        { parsing_prop::RCM_ORDER,       Reordering::RCM },
+        { parsing_prop::BFS_ORDER,       Reordering::BFS },
+        { parsing_prop::COMMUNITY_ORDER, Reordering::COMMUNITY }
+    };
+    for (const auto& ordering : orderings) {
+        if (!(_prop & ordering.first))
+            continue;
+        if (_prop.is_print())
+            std::cout << "Reordering..." << std::flush;
+        reorder(ordering.second);
+        if (_prop.is_print())
+            std::cout << "Complete!\n" << std::endl;
+        return;
     }
-    if (_prop.is_print())
-        std::cout << "Complete!\n" << std::endl;
 }
 
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::permuteEdgeData(const eoff_t*, const eoff_t*) {}
+
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::print() const noexcept {
     for (vid_t i = 0; i < _nV; i++) {
@@ -282,7 +928,9 @@ void GraphStd<vid_t, eoff_t>::print() const noexcept {
 #pragma clang diagnostic ignored "-Wsign-conversion"
 
 template<typename vid_t, typename eoff_t>
-void GraphStd<vid_t, eoff_t>::print_raw() const noexcept {
+void GraphStd<vid_t, eoff_t>::print_raw() const {
+    if (_structure.is_reverse())
+        lazy_reverse();
     xlib::printArray(_out_offsets, _nV + 1, "Out-Offsets  ");           //NOLINT
     xlib::printArray(_out_edges,   _nE,     "Out-Edges    ");           //NOLINT
     xlib::printArray(_out_degrees, _nV,     "Out-Degrees  ");           //NOLINT
@@ -297,56 +945,105 @@ void GraphStd<vid_t, eoff_t>::print_raw() const noexcept {
 
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>
-::writeBinary(const std::string& filename, bool print) const {
-    using namespace structure_prop;
-    size_t  base_size = sizeof(_nV) + sizeof(_nE) + sizeof(_structure);
-    size_t file_size1 = (static_cast<size_t>(_nV) + 1) * sizeof(eoff_t) +
-                        (static_cast<size_t>(_nE)) * sizeof(vid_t);
-
-    bool       twice = _structure.is_directed() && _structure.is_reverse();
-    size_t file_size = base_size + (twice ? file_size1 * 2 : file_size1);
-
-    if (print) {
-        std::cout << "Graph to binary file: " << filename
-                << " (" << (file_size >> 20) << ") MB" << std::endl;
-    }
+::binary_sections(binary::Header& header,
+                  std::vector<binary::SectionData>& sections) const {
+    using namespace binary;
+    using detail::StructureEnum;
+    auto    nV = static_cast<size_t>(_nV);
+    auto    nE = static_cast<size_t>(_nE);
+    bool twice = _structure.is_directed() && _structure.is_reverse();
 
-    std::string class_id = xlib::type_name<vid_t>() + xlib::type_name<eoff_t>();
-    file_size           += class_id.size();
-    xlib::MemoryMapped memory_mapped(filename.c_str(), file_size,
-                                     xlib::MemoryMapped::WRITE, print);
+    std::string names[] = { xlib::type_name<vid_t>(),
+                            xlib::type_name<eoff_t>() };
+    names[0].copy(header.vid_type,  sizeof(header.vid_type)  - 1);
+    names[1].copy(header.eoff_type, sizeof(header.eoff_type) - 1);
+    header.num_vertices = nV;
+    header.num_edges    = nE;
+    header.structure    = static_cast<uint32_t>(_structure.is_directed() ?
+                                StructureEnum::DIRECTED :
+                                StructureEnum::UNDIRECTED);
+    if (twice)
+        header.structure |= static_cast<uint32_t>(StructureEnum::REVERSE);
 
-    if (_structure.is_directed() && _structure.is_reverse()) {
-        auto struct_tmp = DIRECTED | REVERSE;
-        memory_mapped.write(class_id.c_str(), class_id.size(),          //NOLINT
-                            &_nV, 1, &_nE, 1, &struct_tmp, 1,           //NOLINT
-                            _out_offsets, _nV + 1, _in_offsets, _nV + 1,//NOLINT
-                            _out_edges, _nE, _in_edges, _nE);           //NOLINT
+    sections.push_back({ Section::OUT_OFFSETS, _out_offsets, nV + 1,
+                         sizeof(eoff_t) });
+    sections.push_back({ Section::OUT_EDGES, _out_edges, nE, sizeof(vid_t) });
+    sections.push_back({ Section::OUT_DEGREES, _out_degrees, nV,
+                         sizeof(degree_t) });
+    if (twice) {
+        sections.push_back({ Section::IN_OFFSETS, _in_offsets, nV + 1,
+                             sizeof(eoff_t) });
+        sections.push_back({ Section::IN_EDGES, _in_edges, nE,
+                             sizeof(vid_t) });
+        sections.push_back({ Section::IN_DEGREES, _in_degrees, nV,
+                             sizeof(degree_t) });
     }
-    else {
-        auto struct_tmp = DIRECTED;
-        memory_mapped.write(class_id.c_str(), class_id.size(),          //NOLINT
-                            &_nV, 1, &_nE, 1, &struct_tmp, 1,           //NOLINT
-                            _out_offsets, _nV + 1, _out_edges, _nE);    //NOLINT
+    if (!_id_map.empty()) {
+        sections.push_back({ Section::ORIGINAL_IDS, _id_map.original_ids(),
+                             _id_map.size(), sizeof(vid_t) });
     }
 }
 
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>
+::writeBinary(const std::string& filename, bool print, bool checksum) const {
+    if (_structure.is_reverse())
+        lazy_reverse();
+    binary::Header header {};
+    std::vector<binary::SectionData> sections;
+    binary_sections(header, sections);
+    binary::write(filename, header, sections, checksum, print);
+}
+
 #pragma clang diagnostic pop
 #endif
 
+template<typename vid_t, typename eoff_t>
+std::vector<size_t>
+GraphStd<vid_t, eoff_t>::balanced_partition(int num_threads) const noexcept {
+    //weight of the vertices [0, v): edges + vertices (one line each)
+    const auto& weight = [&](size_t v) {
+                            return static_cast<size_t>(_out_offsets[v]) + v;
+                        };
+    auto nV    = static_cast<size_t>(_nV);
+    auto total = weight(nV);
+    std::vector<size_t> partition(num_threads + 1, nV);
+    partition[0] = 0;
+    for (int k = 1; k < num_threads; k++) {
+        auto target = total / static_cast<size_t>(num_threads) *
+                      static_cast<size_t>(k);
+        size_t low = partition[k - 1], high = nV;
+        while (low < high) {
+            auto mid = low + (high - low) / 2;
+            if (weight(mid) < target)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        partition[k] = low;
+    }
+    return partition;
+}
+
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::writeMarket(const std::string& filename,
                                           bool print) const {
     if (print)
         std::cout << "Graph to Market format file: " << filename << std::endl;
-    std::ofstream fout(filename);
-    fout << "%%MatrixMarket matrix coordinate pattern general\n"
-         << _nV << " " << _nV << " " << _nE << "\n";
-    for (vid_t i = 0; i < _nV; i++) {
-        for (auto j = _out_offsets[i]; j < _out_offsets[i + 1]; j++)
-            fout << i + 1 << " " << _out_edges[j] + 1 << "\n";
-    }
-    fout.close();
+    auto header = "%%MatrixMarket matrix coordinate pattern general\n" +
+                  std::to_string(_nV) + " " + std::to_string(_nV) + " " +
+                  std::to_string(_nE) + "\n";
+    //"source destination\n": two integers of at most 20 digits and sign
+    const size_t LINE_BYTES = 2 * 21 + 2;
+    const auto& edge_op = [&](char* ptr, vid_t src, eoff_t j) {
+            ptr    = xlib::format_integer(ptr, src + 1);
+            *ptr++ = ' ';
+            ptr    = xlib::format_integer(ptr, _out_edges[j] + 1);
+            *ptr++ = '\n';
+            return ptr;
+        };
+    writeText(filename, header, LINE_BYTES, edge_op,
+              [](char* ptr, vid_t) { return ptr; });
 }
 
 template<typename vid_t, typename eoff_t>
@@ -356,184 +1053,39 @@ void GraphStd<vid_t, eoff_t>::writeDimacs10th(const std::string& filename,
         std::cout << "Graph to Dimacs10th format file: " << filename
                   << std::endl;
     }
-    std::ofstream fout(filename);
-    fout << _nV << " " << _nE << " 100\n";
-    for (vid_t i = 0; i < _nV; i++) {
-        for (auto j = _out_offsets[i]; j < _out_offsets[i + 1]; j++) {
-            fout << _out_edges[j] + 1;
-            if (j < _out_offsets[i + 1] - 1)
-                fout << " ";
-        }
-        fout << "\n";
-    }
-    fout.close();
+    auto header = std::to_string(_nV) + " " + std::to_string(_nE) + " 100\n";
+    //"destination destination ...\n": a separator and at most 21 characters
+    //for each edge
+    const size_t TOKEN_BYTES = 22;
+    const auto& edge_op = [&](char* ptr, vid_t src, eoff_t j) {
+            if (j != _out_offsets[src])
+                *ptr++ = ' ';
+            return xlib::format_integer(ptr, _out_edges[j] + 1);
+        };
+    const auto& end_op = [](char* ptr, vid_t) {
+            *ptr++ = '\n';
+            return ptr;
+        };
+    writeText(filename, header, TOKEN_BYTES, edge_op, end_op);
 }
+
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t>
-void GraphStd<vid_t, eoff_t>::print_degree_distrib() const noexcept {
-    const int MAX_LOG = 32;
-    int distribution[MAX_LOG] = {};
-    int   cumulative[MAX_LOG] = {};
-    int      percent[MAX_LOG];
-    int cumulative_percent[MAX_LOG];
-    for (auto i = 0; i < _nV; i++) {
-        auto degree = _out_degrees[i];
-        if (degree == 0) continue;
-        auto log_value = xlib::log2(degree);
-        distribution[log_value]++;
-        cumulative[log_value] += degree;
-    }
-    for (auto i = 0; i < MAX_LOG; i++) {
-        percent[i] = xlib::per_cent(distribution[i], _nV);
-        cumulative_percent[i] = xlib::per_cent(cumulative[i], _nE);
-    }
-    int sum = 0;
-    for (auto i = 0; i < MAX_LOG; i++)
-        sum += cumulative[i];
-    std::cout << "sum  " << sum << std::endl;
-
-    int pos = MAX_LOG;
-    while (pos >= 0 && distribution[--pos] == 0);
-
-    xlib::IosFlagSaver tmp1;
-    xlib::ThousandSep  tmp2;
-    using namespace std::string_literals;
-
-    std::cout << "Degree distribution:" << std::setprecision(1) << "\n\n";
-    for (auto i = 0; i <= pos; i++) {
-        std::string exp = "  (2^"s + std::to_string(i) + ")"s;
-        std::cout << std::right << std::setw(9)  << (1 << i)
-                  << std::left  << std::setw(8)  << exp
-                  << std::right << std::setw(12) << distribution[i]
-                  << std::right << std::setw(5)  << percent[i] << " %\n";
-    }
-    std::cout << "\nEdge distribution:" << std::setprecision(1) << "\n\n";
-    for (auto i = 0; i <= pos; i++) {
-        std::string exp = "  (2^"s + std::to_string(i) + ")"s;
-        std::cout << std::right << std::setw(9)  << (1 << i)
-                  << std::left  << std::setw(8)  << exp
-                  << std::right << std::setw(12) << cumulative[i]
-                  << std::right << std::setw(5)  << cumulative_percent[i]
-                  << " %\n";
-    }
-    std::cout << std::endl;
+void GraphStd<vid_t, eoff_t>::print_degree_distrib() const {
+    profile().print_histogram();
 }
 
 template<typename vid_t, typename eoff_t>
-void GraphStd<vid_t, eoff_t>::print_degree_analysis() const noexcept {
-    auto avg      = static_cast<float>(_nE) / static_cast<float>(_nV);
-    auto std_dev  = xlib::std_deviation(_out_degrees, _out_degrees + _nV);
-    auto density  = static_cast<float>(_nE) /
-                       static_cast<float>(static_cast<uint64_t>(_nV) * _nV);
-    auto gini     = xlib::gini_coefficient(_out_degrees, _out_degrees + _nV);
-    auto variance_coeff = std_dev / std::abs(avg);
-    xlib::Bitmask rings(_nV);
-    for (auto i = 0; i < _nV; i++) {
-        for (auto j = _out_offsets[i]; j < _out_offsets[i + 1]; j++) {
-            if (_out_edges[j] == i) {
-                rings[i] = true;
-                break;
-            }
-        }
-    }
-    int     num_rings = rings.size();
-    auto ring_percent = xlib::per_cent(rings.size(), _nV);
-
-    degree_t out_degree_0 = 0, in_degree_0 = 0, out_degree_1 = 0,
-              in_degree_1 = 0,   singleton = 0,     out_leaf = 0, in_leaf = 0;
-    auto max_out_degree = std::numeric_limits<degree_t>::min();
-    auto  max_in_degree = std::numeric_limits<degree_t>::min();
-    for (auto i = 0; i < _nV; i++) {
-        if (_out_degrees[i] > max_out_degree)
-            max_out_degree = _out_degrees[i];
-        if (_in_degrees[i] > max_in_degree)
-            max_in_degree = _in_degrees[i];
-        if (_out_degrees[i] == 0) out_degree_0++;
-        if (_out_degrees[i] == 1) out_degree_1++;
-        if (_in_degrees[i] == 0)  in_degree_0++;
-        if (_in_degrees[i] == 1)  in_degree_1++;
-        if ((_out_degrees[i] == 0 && _in_degrees[i] == 0) ||
-            (_out_degrees[i] == 1 && _in_degrees[i] == 1 && rings[i]))
-            singleton++;
-        if (((_out_degrees[i] == 2 && is_undirected()) ||
-            (_out_degrees[i] == 1 && is_directed())) && rings[i])
-            out_leaf++;
-        if (((_in_degrees[i] == 2 && is_undirected()) ||
-            (_in_degrees[i] == 1 && is_directed())) && rings[i])
-            in_leaf++;
-    }
-    auto out_degree_0_percent = xlib::per_cent(out_degree_0, _nV);
-    auto out_degree_1_percent = xlib::per_cent(out_degree_1, _nV);
-    auto in_degree_0_percent  = xlib::per_cent(in_degree_0, _nV);
-    auto in_degree_1_percent  = xlib::per_cent(in_degree_1, _nV);
-    auto singleton_percent    = xlib::per_cent(singleton, _nV);
-    auto out_leaf_percent     = xlib::per_cent(out_leaf, _nV);
-    auto in_leaf_percent      = xlib::per_cent(in_leaf, _nV);
-
-    const int W1 = 30;
-    const int W2 = 10;
-    const int W3 = 8;
-    xlib::IosFlagSaver tmp1;
-    xlib::ThousandSep tmp2;
-
-    std::cout << "Degree analysis:"
-    << std::right << std::setprecision(1) << std::fixed << "\n\n"
-    << std::setw(W1) << "Average:  "             << std::setw(W2) << avg << "\n"
-    << std::setw(W1) << "Std. Deviation:  "      << std::setw(W2) << std_dev
-                                                 << "\n"
-    << std::setw(W1) << "Coeff. of variation:  " << std::setw(W2)
-                                                 << variance_coeff  << "\n"
-    << std::setw(W1) << "Gini Coeff:  "          << std::setprecision(2)
-                                                 << std::setw(W2)
-                                                 << gini  << "\n"
-    << std::setw(W1) << "Density:  "             << std::setprecision(7)
-                                                 << std::setw(W2)
-                                                 << density  << "\n"
-                                                 << std::setprecision(1)
-
-    << std::setw(W1) << "Max Out-Degree:  "  << std::setw(W2) << max_out_degree
-                                             << "\n"
-    << std::setw(W1) << "Max In-Degree:  "   << std::setw(W2) << max_in_degree
-                                             << "\n"
-    << std::setw(W1) << "Rings:  "           << std::setw(W2) << num_rings
-                                             << std::setw(W3) << ring_percent
-                                             << "%\n"
-    << std::setw(W1) << "Out-Degree = 0:  "  << std::setw(W2) << out_degree_0
-                                             << std::setw(W3)
-                                             << out_degree_0_percent << "%\n";
-    if (is_directed()) {
-        std::cout << std::setw(W1) << "In-Degree = 0:  "
-                                             << std::setw(W2) << in_degree_0
-                                             << std::setw(W3)
-                                             << in_degree_0_percent << "%\n";
-    }
-    std::cout
-    << std::setw(W1) << "Out-Degree = 1:  "  << std::setw(W2) << out_degree_1
-                                             << std::setw(W3)
-                                             << out_degree_1_percent << "%\n";
-    if (is_directed()) {
-        std::cout << std::setw(W1) << "In-Degree = 1:  "
-                                             << std::setw(W2) << in_degree_1
-                                             << std::setw(W3)
-                                             << in_degree_1_percent << "%\n";
-    }
-
-    std::cout << std::setw(W1) << "leaf:  "  << std::setw(W2) << singleton
-                                             << std::setw(W3)
-                                             << singleton_percent << "%\n"
-    << std::setw(W1) << "Out-Leaf:  "        << std::setw(W2) << out_leaf
-                                             << std::setw(W3)
-                                             << out_leaf_percent << "%\n"
-    << std::setw(W1) << "In-Leaf:  "         << std::setw(W2) << in_leaf
-                                             << std::setw(W3)
-                                             << in_leaf_percent << "%\n"
-                                             << std::endl;
+void GraphStd<vid_t, eoff_t>::print_degree_analysis() const {
+    profile().print();
 }
 
 //------------------------------------------------------------------------------
 
 template class GraphStd<int, int>;
+template class GraphStd<int, int64_t>;
+template class GraphStd<unsigned, int64_t>;
 template class GraphStd<int64_t, int64_t>;
 
 } // namespace graph
@@ -34,29 +34,225 @@
  * </blockquote>}
  */
 #include "GraphIO/GraphStd.hpp"
-#include "Host/Algorithm.hpp" //xlib::UniqueMap
-#include "Host/FileUtil.hpp"  //xlib::skip_lines, xlib::Progress
-#include <cstring>                    //std::strtok
+#include "Host/Algorithm.hpp" //xlib::num_threads
+#include "Host/BoundedQueue.hpp"  //xlib::BoundedQueue
+#include "Host/FileUtil.hpp"  //xlib::skip_lines, xlib::parallel_parse
+#include "Host/Numeric.hpp"   //xlib::check_overflow
+#include "Host/PrintExt.hpp"  //xlib::format
+#include "Host/Timer.hpp"     //timer::Timer
+#include <algorithm>                  //std::max
+#include <atomic>                     //std::atomic
+#include <cctype>                     //std::isspace
+#include <cstdio>                     //std::snprintf, std::rename
+#include <cstdlib>                    //::realpath
+#include <cstring>                    //std::strtok, std::memcmp
+#include <numeric>                    //std::partial_sum
 #include <sstream>                    //std::istringstream
+#include <thread>                     //std::thread
 #include <vector>                     //std::vector
+#include <unistd.h>                   //::access, ::getpid
 
 namespace graph {
+namespace {
+
+void print_parsing(bool print) {
+    if (print) {
+        std::cout << "Parsing with " << xlib::num_threads() << " threads..."
+                  << std::flush;
+    }
+}
+
+/**
+ * @brief `<cache directory>/<input file name>.<key>.bin`
+ */
+std::string cache_file(const char* filename, uint64_t key) {
+    std::string path(filename);
+    auto pos  = path.find_last_of('/');
+    auto name = pos == std::string::npos ? path : path.substr(pos + 1);
+    auto dir  = !cache_directory().empty() ? cache_directory() :
+                pos == std::string::npos   ? std::string(".") :
+                                             path.substr(0, pos);
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx",
+                  static_cast<unsigned long long>(key));
+    return dir + "/" + name + "." + hex + ".bin";
+}
+
+void print_done(bool print) {
+    if (print)
+        std::cout << "done\n";
+}
+
+} // namespace
 
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::readMarket(std::ifstream& fin, bool print) {
     auto ginfo = GraphBase<vid_t, eoff_t>::getMarketHeader(fin);
     allocate(ginfo);
-    xlib::Progress progress(ginfo.num_lines);
+    auto body = xlib::read_remaining(fin);
 
-    for (size_t lines = 0; lines < ginfo.num_lines; lines++) {
+    print_parsing(print);
+    parseMarket(body.data(), body.data() + body.size(), ginfo.num_lines);
+    print_done(print);
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::parseMarket(const char* start, const char* end,
+                                          size_t num_lines) {
+    if (is_pipeline_enabled()) {
+        parseMarketPipelined(start, end, num_lines);
+        return;
+    }
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '%') ? -1 : 1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= num_lines)
+            return;
         vid_t index1, index2;
-        fin >> index1 >> index2;
+        ptr = xlib::parse_integer(ptr, line_end, index1);
+        xlib::parse_integer(ptr, line_end, index2);
         assert(index1 <= _nV && index2 <= _nV);
-        _coo_edges[lines] = { index1 - 1, index2 - 1 };
+        _coo_edges[line_id] = { index1 - 1, index2 - 1 };
+    };
+    auto read_lines = xlib::parallel_parse(start, end, count_op, parse_op);
+    detail::check_lines("Market", num_lines, read_lines);
+}
 
-        if (print)
-            progress.next(lines);
-        xlib::skip_lines(fin);
+template<typename vid_t, typename eoff_t>
+bool GraphStd<vid_t, eoff_t>::is_pipeline_enabled() const noexcept {
+    //the COO must reach COOtoCSR() unchanged
+    bool enabled = !_stored_undirected && !_directed_to_undirected &&
+                   !_undirected_to_directed && !_prop.is_randomize() &&
+                   !_prop.is_sort() && !is_low_memory_enabled();
+    if (_prop.is_pipeline() && !enabled && _prop.is_print())
+        std::cout << "(pipeline disabled) ";
+    return _prop.is_pipeline() && enabled;
+}
+
+template<typename vid_t, typename eoff_t>
+bool GraphStd<vid_t, eoff_t>::is_low_memory_enabled() const noexcept {
+    //the COO structure keeps the COO array
+    return _prop.is_low_memory() && !_structure.is_coo();
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::parseMarketPipelined(const char* start,
+                                                   const char* end,
+                                                   size_t num_lines) {
+    using namespace timer;
+    const size_t CHUNK_BYTES = 256 * xlib::KB;
+    const size_t  QUEUE_SIZE = 1024;
+    auto num_chunks = std::max(static_cast<size_t>(end - start) / CHUNK_BYTES,
+                               size_t(1));
+    std::vector<const char*> chunks(num_chunks + 1);
+    std::vector<size_t>      first(num_chunks + 1);
+    xlib::split_lines(start, end, static_cast<int>(num_chunks), chunks.data());
+
+    const auto& is_edge = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return ptr != line_end && *ptr != '%';
+    };
+    //--------------------------------------------------------------------------
+    // first edge of each chunk
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto chunk_start = xlib::thread_chunk(num_chunks, thread_id,
+                                                  num_threads);
+            auto   chunk_end = xlib::thread_chunk(num_chunks, thread_id + 1,
+                                                  num_threads);
+            for (auto c = chunk_start; c < chunk_end; c++) {
+                size_t count = 0;
+                for (auto ptr = chunks[c]; ptr < chunks[c + 1]; ) {
+                    auto line_end = xlib::end_of_line(ptr, chunks[c + 1]);
+                    count        += is_edge(ptr, line_end) ? 1 : 0;
+                    ptr           = line_end + 1;
+                }
+                first[c + 1] = count;
+            }
+        });
+    first[0] = 0;
+    std::partial_sum(first.begin() + 1, first.end(), first.begin() + 1);
+    detail::check_lines("Market", num_lines, first[num_chunks]);
+    //--------------------------------------------------------------------------
+    auto    nV = static_cast<size_t>(_nV);
+    auto    nE = static_cast<size_t>(_nE);
+    bool twice = _structure.is_directed() && _structure.is_reverse();
+    int  num_histograms = xlib::counting_sort_threads(nE, nV);
+    auto num_bins       = xlib::counting_sort_bins(nE, nV, num_histograms);
+    _out_histograms = new eoff_t[num_histograms * num_bins]();
+    if (twice)
+        _in_histograms = new eoff_t[num_histograms * num_bins]();
+
+    //a vertex id or, for low-degree graphs, its range of ids
+    const auto& bin = [&](vid_t id) {
+                        return xlib::counting_sort_bin(static_cast<size_t>(id),
+                                                       nV, num_bins);
+                    };
+    xlib::BoundedQueue<size_t> queue(QUEUE_SIZE);
+    float count_time = 0.0f;
+    //consumer: the histograms of the counting sort (COOtoCSR) are built as
+    //the chunks of edges are parsed
+    std::thread consumer([&]() {
+            for (size_t k = 0; k < num_chunks; k++) {
+                auto c = queue.pop();
+                Timer<HOST> TM;
+                TM.start();
+                auto edge_start = std::min(first[c], nE);
+                auto   edge_end = std::min(first[c + 1], nE);
+                int        hist = 0;
+                auto   boundary = xlib::thread_chunk(nE, 1, num_histograms);
+                for (auto i = edge_start; i < edge_end; i++) {
+                    while (i >= boundary)
+                        boundary = xlib::thread_chunk(nE, ++hist + 1,
+                                                      num_histograms);
+                    auto offset = static_cast<size_t>(hist) * num_bins;
+                    _out_histograms[offset + bin(_coo_edges[i].first)]++;
+                    if (twice)
+                        _in_histograms[offset + bin(_coo_edges[i].second)]++;
+                }
+                TM.stop();
+                count_time += TM.duration();
+            }
+        });
+    //producers: one hardware thread is left to the consumer
+    Timer<HOST> TM;
+    TM.start();
+
+    std::atomic<size_t> next_chunk(0);
+    int num_producers = std::max(xlib::num_threads() - 1, 1);
+    xlib::parallel_run([&](int, int) {
+            for (auto c = next_chunk++; c < num_chunks; c = next_chunk++) {
+                auto line_id = first[c];
+                for (auto ptr = chunks[c]; ptr < chunks[c + 1]; ) {
+                    auto line_end = xlib::end_of_line(ptr, chunks[c + 1]);
+                    if (is_edge(ptr, line_end) && line_id < num_lines) {
+                        vid_t index1, index2;
+                        auto tmp = xlib::parse_integer(ptr, line_end, index1);
+                        xlib::parse_integer(tmp, line_end, index2);
+                        _coo_edges[line_id++] = { index1 - 1, index2 - 1 };
+                    }
+                    ptr = line_end + 1;
+                }
+                queue.push(c);
+            }
+        }, num_producers);
+
+    TM.stop();
+    auto parse_time = TM.duration();
+    TM.start();
+
+    consumer.join();
+
+    TM.stop();
+    if (_prop.is_print()) {
+        auto exposed = TM.duration();
+        std::cout << "\n  parsing:        " << xlib::format(parse_time, 1)
+                  << " ms\n  degree count:   " << xlib::format(count_time, 1)
+                  << " ms  (hidden: "
+                  << xlib::format(std::max(count_time - exposed, 0.0f), 1)
+                  << " ms, exposed: " << xlib::format(exposed, 1) << " ms)\n";
     }
 }
 
@@ -91,15 +287,12 @@ template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::readKonect(std::ifstream& fin, bool print) {
     auto ginfo = GraphBase<vid_t, eoff_t>::getKonectHeader(fin);
     allocate(ginfo);
-    xlib::Progress progress(ginfo.num_lines);
+    auto body = xlib::read_remaining(fin);
 
-    for (size_t lines = 0; lines < ginfo.num_lines; lines++) {
-        vid_t index1, index2;
-        fin >> index1 >> index2;
-        _coo_edges[lines] = { index1 - 1, index2 - 1 };
-        if (print)
-            progress.next(lines);
-    }
+    print_parsing(print);
+    //weight and timestamp columns are skipped
+    parseMarket(body.data(), body.data() + body.size(), ginfo.num_lines);
+    print_done(print);
 }
 
 //------------------------------------------------------------------------------
@@ -107,24 +300,8 @@ void GraphStd<vid_t, eoff_t>::readKonect(std::ifstream& fin, bool print) {
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::readNetRepo(std::ifstream& fin) {
     GraphBase<vid_t, eoff_t>::getNetRepoHeader(fin);
-    xlib::UniqueMap<vid_t> unique_map;
-    std::vector<coo_t> coo_edges_vect(32768);
-
-    size_t num_lines = 0;
-    while (!fin.eof()) {
-        vid_t index1, index2;
-        fin >> index1;
-        fin.ignore(1, ',');
-        fin >> index2;
-        unique_map.insert(index1);
-        unique_map.insert(index2);
-
-        coo_edges_vect.push_back( { index1 - 1, index2 - 1 } );
-        num_lines++;
-    }
-    allocate( { unique_map.size(), num_lines, num_lines,
-                structure_prop::DIRECTED } );
-    std::copy(coo_edges_vect.begin(), coo_edges_vect.end(), _coo_edges);
+    auto body = xlib::read_remaining(fin);
+    parseNetRepo(body.data(), body.data() + body.size());
 }
 
 //------------------------------------------------------------------------------
@@ -143,14 +320,17 @@ void GraphStd<vid_t, eoff_t>::readDimacs10(std::ifstream& fin, bool print){
         char* token = std::strtok(const_cast<char*>(str.c_str()), " ");
         while (token != nullptr) {
             vid_t dest = std::stoi(token) - 1;
-            assert(count_edges < ginfo.num_edges);
-            _coo_edges[count_edges++] = { lines, dest };
+            if (count_edges < ginfo.num_edges)
+                _coo_edges[count_edges] = { lines, dest };
+            count_edges++;
             token = std::strtok(nullptr, " ");
+            if (_stored_weights && token != nullptr)   //skip the weight
+                token = std::strtok(nullptr, " ");
         }
         if (print)
             progress.next(lines);
     }
-    assert(count_edges == static_cast<size_t>(_nE));
+    detail::check_edges("Dimacs10th", ginfo.num_edges, count_edges);
 }
 
 //------------------------------------------------------------------------------
@@ -164,14 +344,14 @@ void GraphStd<vid_t, eoff_t>::readSnap(std::ifstream& fin, bool print) {
     while (fin.peek() == '#')
         xlib::skip_lines(fin);
 
-    xlib::UniqueMap<vid_t, vid_t> map;
     for (size_t lines = 0; lines < ginfo.num_lines; lines++) {
         vid_t v1, v2;
         fin >> v1 >> v2;
-        _coo_edges[lines] = { map.insert(v1), map.insert(v2) };
+        _coo_edges[lines] = { v1, v2 };
         if (print)
             progress.next(lines);
     }
+    relabelCOO(ginfo.num_lines);
 }
 
 //------------------------------------------------------------------------------
@@ -183,44 +363,469 @@ void GraphStd<vid_t, eoff_t>::readMPG(std::ifstream&, bool) {
 
 //------------------------------------------------------------------------------
 
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::relabelCOO(size_t num_edges) {
+    //key 2 * i (2 * i + 1) is the source (destination) of the i-th edge
+    _id_map.build(num_edges * 2,
+                  [&](size_t i) {
+                      return (i % 2 == 0) ? _coo_edges[i / 2].first
+                                          : _coo_edges[i / 2].second;
+                  },
+                  [&](size_t i, vid_t new_id) {
+                      if (i % 2 == 0)
+                          _coo_edges[i / 2].first = new_id;
+                      else
+                          _coo_edges[i / 2].second = new_id;
+                  }, true);
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::allocateRelabeled(const coo_t* coo_edges,
+                                                size_t num_lines) {
+    auto relabeled = new coo_t[num_lines];
+    _id_map.build(num_lines * 2,
+                  [&](size_t i) {
+                      return (i % 2 == 0) ? coo_edges[i / 2].first
+                                          : coo_edges[i / 2].second;
+                  },
+                  [&](size_t i, vid_t new_id) {
+                      if (i % 2 == 0)
+                          relabeled[i / 2].first = new_id;
+                      else
+                          relabeled[i / 2].second = new_id;
+                  }, false);
+    auto direction = _stored_undirected ? structure_prop::UNDIRECTED
+                                        : structure_prop::DIRECTED;
+    allocate({ _id_map.size(), _stored_undirected ? num_lines * 2 : num_lines,
+               num_lines, direction });
+    std::copy(relabeled, relabeled + num_lines, _coo_edges);
+    delete[] relabeled;
+}
+
+//==============================================================================
+//  Memory-mapped readers: the header is parsed through xlib::MemoryStream,
+//  the body in parallel directly on the mapped range
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readMarket(const char* start, const char* end,
+                                         bool print) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getMarketHeader(stream);
+    allocate(ginfo);
+
+    print_parsing(print);
+    parseMarket(stream.current(), end, ginfo.num_lines);
+    print_done(print);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readDimacs9(const char* start, const char* end,
+                                          bool print) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs9Header(stream);
+    allocate(ginfo);
+
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr != line_end && *ptr == 'a') ? 1 : -1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= ginfo.num_lines)
+            return;
+        vid_t index1, index2;
+        ptr = xlib::skip_blanks(ptr, line_end) + 1;     //skip 'a'
+        ptr = xlib::parse_integer(ptr, line_end, index1);
+        xlib::parse_integer(ptr, line_end, index2);
+        _coo_edges[line_id] = { index1 - 1, index2 - 1 };
+    };
+    print_parsing(print);
+    auto read_lines = xlib::parallel_parse(stream.current(), end,
+                                           count_op, parse_op);
+    detail::check_lines("Dimacs9th", ginfo.num_lines, read_lines);
+    print_done(print);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readKonect(const char* start, const char* end,
+                                         bool print) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getKonectHeader(stream);
+    allocate(ginfo);
+    print_parsing(print);
+    parseMarket(stream.current(), end, ginfo.num_lines);   //same line layout
+    print_done(print);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readNetRepo(const char* start, const char* end) {
+    xlib::MemoryStream stream(start, end);
+    GraphBase<vid_t, eoff_t>::getNetRepoHeader(stream);
+    parseNetRepo(stream.current(), end);
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::parseNetRepo(const char* start,
+                                           const char* end) {
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '%') ? -1 : 1;
+    };
+    const auto& parse_op = [](const char*, const char*, size_t, size_t) {};
+    auto num_lines = xlib::parallel_parse(start, end, count_op, parse_op);
+
+    auto coo_edges = new coo_t[num_lines];
+    const auto& parse_op2 = [&](const char* ptr, const char* line_end,
+                                size_t line_id, size_t) {
+        vid_t index1, index2;
+        ptr = xlib::parse_integer(ptr, line_end, index1);  //',' is a blank
+        xlib::parse_integer(ptr, line_end, index2);
+        coo_edges[line_id] = { index1, index2 };
+    };
+    xlib::parallel_parse(start, end, count_op, parse_op2);
+    allocateRelabeled(coo_edges, num_lines);
+    delete[] coo_edges;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readDimacs10(const char* start, const char* end,
+                                           bool print) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs10Header(stream);
+    allocate(ginfo);
+
+    int tokens_per_edge = _stored_weights ? 2 : 1;
+    const auto& count_op = [&](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        if (ptr != line_end && *ptr == '%')
+            return -1;
+        int count = 0;
+        while (ptr != line_end) {
+            do {
+                ptr++;
+            } while (ptr != line_end && !std::isspace(*ptr));
+            count++;
+            ptr = xlib::skip_blanks(ptr, line_end);
+        }
+        return count / tokens_per_edge;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t item_id) {
+        if (line_id >= ginfo.num_lines)
+            return;
+        ptr = xlib::skip_blanks(ptr, line_end);
+        while (ptr != line_end) {
+            vid_t dest;
+            ptr = std::max(xlib::parse_integer(ptr, line_end, dest), ptr + 1);
+            if (_stored_weights) {
+                vid_t weight;                                //skipped
+                ptr = xlib::parse_integer(ptr, line_end, weight);
+            }
+            if (item_id < ginfo.num_edges) {
+                _coo_edges[item_id++] = { static_cast<vid_t>(line_id),
+                                          dest - 1 };
+            }
+            ptr = xlib::skip_blanks(ptr, line_end);
+        }
+    };
+    print_parsing(print);
+    auto read_edges = xlib::parallel_parse(stream.current(), end,
+                                           count_op, parse_op);
+    detail::check_edges("Dimacs10th", ginfo.num_edges, read_edges);
+    print_done(print);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readSnap(const char* start, const char* end,
+                                       bool print) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getSnapHeader(stream);
+    allocate(ginfo);
+
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '#') ? -1 : 1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= ginfo.num_lines)
+            return;
+        vid_t v1, v2;
+        ptr = xlib::parse_integer(ptr, line_end, v1);
+        xlib::parse_integer(ptr, line_end, v2);
+        _coo_edges[line_id] = { v1, v2 };
+    };
+    print_parsing(print);
+    auto read_lines = xlib::parallel_parse(stream.current(), end,
+                                           count_op, parse_op);
+    detail::check_lines("SNAP", ginfo.num_lines, read_lines);
+    relabelCOO(ginfo.num_lines);
+    print_done(print);
+}
+
+//------------------------------------------------------------------------------
+
 #if defined(__linux__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wsign-conversion"
 
 template<typename vid_t, typename eoff_t>
 void GraphStd<vid_t, eoff_t>::readBinary(const char* filename, bool print) {
+    if (binary::is_v2(filename)) {
+        readBinaryV2(filename, print);
+        return;
+    }
+    //legacy format: class identifier, nV, nE, structure, CSR arrays
     size_t file_size = xlib::file_size(filename);
-    xlib::MemoryMapped memory_mapped(filename, file_size,
-                                     xlib::MemoryMapped::READ, print);
+    auto memory_mapped = new xlib::MemoryMapped(filename, file_size,
+                                              xlib::MemoryMapped::READ, print);
 
     std::string class_id = xlib::type_name<vid_t>() + xlib::type_name<eoff_t>();
     auto tmp = new char[class_id.size()];
-    memory_mapped.read_noprint(tmp, class_id.size());
+    memory_mapped->read_noprint(tmp, class_id.size());
 
     if (!std::equal(tmp, tmp + class_id.size(), class_id.begin()))
         ERROR("Different class identifier")
     delete[] tmp;
 
-    memory_mapped.read_noprint(&_nV, 1, &_nE, 1, &_structure, 1);
-    auto direction = _structure.is_directed() ? structure_prop::DIRECTED
-                                              : structure_prop::UNDIRECTED;
-    allocate({static_cast<size_t>(_nV), static_cast<size_t>(_nE),
-              static_cast<size_t>(_nE), direction});
+    memory_mapped->read_noprint(&_nV, 1, &_nE, 1, &_structure, 1);
+    bool   twice = _structure.is_directed() && _structure.is_reverse();
+    auto      nV = static_cast<size_t>(_nV);
+    auto      nE = static_cast<size_t>(_nE);
+    size_t  data = ((nV + 1) * sizeof(eoff_t) + nE * sizeof(vid_t)) *
+                   (twice ? 2 : 1);
+    size_t  header = class_id.size() + sizeof(_nV) + sizeof(_nE) +
+                     sizeof(_structure);
+    //files written before the array alignment have no padding
+    size_t padding = file_size - header - data;
+    if (file_size < header + data || padding >= _binary_alignment)
+        ERROR("Wrong binary file size")
+    memory_mapped->read_ptr<char>(padding);
+
+    bool aligned = (header + padding) % alignof(eoff_t) == 0 &&
+                   ((nV + 1) * sizeof(eoff_t)) % alignof(vid_t) == 0;
+    if (_prop.is_mmap() && !aligned)
+        WARNING("Binary file not aligned: zero-copy loading disabled")
+
+    if (_prop.is_mmap() && aligned) {
+        //CSR arrays point into the read-only mapping
+        const auto& offsets_ptr = [&]() {
+                return const_cast<eoff_t*>(
+                            memory_mapped->read_ptr<eoff_t>(nV + 1));
+            };
+        const auto& edges_ptr = [&]() {
+                return const_cast<vid_t*>(memory_mapped->read_ptr<vid_t>(nE));
+            };
+        _out_offsets = offsets_ptr();
+        _in_offsets  = twice ? offsets_ptr() : _out_offsets;
+        _out_edges   = edges_ptr();
+        _in_edges    = twice ? edges_ptr() : _out_edges;
+        _out_degrees = new degree_t[nV];
+        _in_degrees  = twice ? new degree_t[nV] : _out_degrees;
+        memory_mapped->normal_access();
+        _memory_mapped = memory_mapped;
+        _mapped_csr    = true;
+        if (print)
+            std::cout << "(zero-copy)";
+    }
+    else {
+        auto direction = _structure.is_directed() ? structure_prop::DIRECTED
+                                                  : structure_prop::UNDIRECTED;
+        //the CSR arrays are read directly
+        _prop -= parsing_prop::LOW_MEMORY;
+        allocate({nV, nE, nE, direction});
+        delete[] _coo_edges;
+        _coo_edges = nullptr;
+        if (twice) {
+            memory_mapped->read(_out_offsets, nV + 1, _in_offsets, nV + 1,
+                                _out_edges, nE, _in_edges, nE);
+        }
+        else
+            memory_mapped->read(_out_offsets, nV + 1, _out_edges, nE);
+        delete memory_mapped;
+    }
+
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                _out_degrees[i] = _out_offsets[i + 1] - _out_offsets[i];
+                if (twice)
+                    _in_degrees[i] = _in_offsets[i + 1] - _in_offsets[i];
+            }
+        });
+    if (print)
+        std::cout << std::endl;
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readBinaryV2(const char* filename, bool print) {
+    using namespace binary;
+    using detail::StructureEnum;
+    _binary_file = new File(filename);
+    const auto& header = _binary_file->header();
+    if (xlib::type_name<vid_t>() != header.vid_type ||
+            xlib::type_name<eoff_t>() != header.eoff_type) {
+        ERROR("Different class identifier: ", header.vid_type, ", ",
+              header.eoff_type)
+    }
+    xlib::check_overflow<vid_t>(header.num_vertices);
+    xlib::check_overflow<eoff_t>(header.num_edges);
+    _nV = static_cast<vid_t>(header.num_vertices);
+    _nE = static_cast<eoff_t>(header.num_edges);
+    const auto& has = [&](StructureEnum value) {
+                        return (header.structure &
+                                static_cast<uint32_t>(value)) != 0;
+                    };
+    _structure = StructureProp();
+    _structure += has(StructureEnum::DIRECTED) ? structure_prop::DIRECTED
+                                               : structure_prop::UNDIRECTED;
+    if (has(StructureEnum::REVERSE))
+        _structure += structure_prop::REVERSE;
+
+    auto nV = header.num_vertices;
+    auto nE = header.num_edges;
+    _out_offsets    = readSection<eoff_t>(Section::OUT_OFFSETS, nV + 1);
+    _out_edges      = readSection<vid_t>(Section::OUT_EDGES, nE);
+    _out_degrees    = readSection<degree_t>(Section::OUT_DEGREES, nV);
+    _mapped_csr     = _prop.is_mmap();
+    _mapped_degrees = _prop.is_mmap();
+    if (_structure.is_undirected()) {
+        _in_offsets = _out_offsets;
+        _in_edges   = _out_edges;
+        _in_degrees = _out_degrees;
+    }
+    if (_binary_file->has(Section::ORIGINAL_IDS) &&
+            _binary_file->section(Section::ORIGINAL_IDS).size > 0) {
+        auto size = _binary_file->section(Section::ORIGINAL_IDS).size /
+                    sizeof(vid_t);
+        auto  ids = static_cast<const vid_t*>(
+                                _binary_file->map(Section::ORIGINAL_IDS));
+        _id_map.build(size, [&](size_t i) { return ids[i]; },
+                      [](size_t, vid_t) {}, true);
+        _binary_file->unmap(Section::ORIGINAL_IDS);
+    }
+    //the reverse CSR sections are loaded on first access (lazy_reverse)
+    if (print) {
+        std::cout << "Binary graph (v2)  V: " << xlib::format(_nV)
+                  << "  E: " << xlib::format(_nE)
+                  << (_prop.is_mmap() ? "  (zero-copy)" : "") << std::endl;
+    }
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::readReverseSections() const {
+    if (!_structure.is_directed() || !_structure.is_reverse())
+        return;
+    auto nV = static_cast<size_t>(_nV);
+    auto nE = static_cast<size_t>(_nE);
+    _in_offsets = readSection<eoff_t>(binary::Section::IN_OFFSETS, nV + 1);
+    _in_edges   = readSection<vid_t>(binary::Section::IN_EDGES, nE);
+    _in_degrees = readSection<degree_t>(binary::Section::IN_DEGREES, nV);
+}
+
+template<typename vid_t, typename eoff_t>
+std::string GraphStd<vid_t, eoff_t>::class_id() const {
+    return xlib::type_name<vid_t>() + "," + xlib::type_name<eoff_t>();
+}
 
-    if (_structure.is_directed() && _structure.is_reverse()) {
-        memory_mapped.read(_out_offsets, _nV + 1, _in_offsets, _nV + 1, //NOLINT
-                           _out_edges, _nE, _in_edges, _nE);            //NOLINT
-        for (vid_t i = 0; i < _nV; i++)
-            _in_degrees[i] = _in_offsets[i + 1] - _in_offsets[i - 1];
+template<typename vid_t, typename eoff_t>
+uint64_t GraphStd<vid_t, eoff_t>::cacheKey(const char* filename) const {
+    if (_prop.is_randomize() || _structure.is_coo()) {
+        if (_prop.is_print())
+            std::cerr << "#binary cache ignored with randomize/COO\n";
+        return 0;
     }
-    else
-        memory_mapped.read(_out_offsets, _nV + 1, _out_edges, _nE);     //NOLINT
+    char* real_path = ::realpath(filename, nullptr);
+    if (real_path == nullptr)
+        return 0;
+    std::string options = std::string(real_path) + "\n" + class_id() + "\n" +
+                          (_prop.is_sort()            ? "S" : "") +
+                          (_prop & parsing_prop::DEGREE_ORDER    ? "d" : "") +
+                          (_prop & parsing_prop::RCM_ORDER       ? "r" : "") +
+                          (_prop & parsing_prop::BFS_ORDER       ? "b" : "") +
+                          (_prop & parsing_prop::COMMUNITY_ORDER ? "c" : "") +
+                          (_prop & parsing_prop::LOW_MEMORY      ? "l" : "") +
+                          (_structure.is_directed()   ? "D" : "") +
+                          (_structure.is_undirected() ? "U" : "") +
+                          (_structure.is_reverse()    ? "R" : "");
+    std::free(real_path);
+    auto key = binary::checksum(options.data(), options.size());
+    return key != 0 ? key : 1;
+}
 
-    for (vid_t i = 0; i < _nV; i++)
-        _out_degrees[i] = _out_offsets[i + 1] - _out_offsets[i - 1];
-    //if (_structure.is_coo())
-    //
-    std::cout << std::endl;
+template<typename vid_t, typename eoff_t>
+bool GraphStd<vid_t, eoff_t>::readCache(const char* filename, uint64_t key) {
+    using binary::SourceKey;
+    if (!binary::source_key(filename, key, _source_key))
+        return false;
+    auto cache = cache_file(filename, key);
+    if (!binary::is_v2(cache.c_str()))
+        return false;
+    {
+        binary::File file(cache.c_str());
+        auto    stored = static_cast<const SourceKey*>(
+                                    file.map(binary::Section::SOURCE_KEY));
+        bool up_to_date = stored != nullptr &&
+                          file.section(binary::Section::SOURCE_KEY).size ==
+                              sizeof(SourceKey) &&
+                          std::memcmp(stored, &_source_key,
+                                      sizeof(SourceKey)) == 0;
+        if (!up_to_date) {
+            if (_prop.is_print())
+                std::cout << "(binary cache out of date)";
+            return false;
+        }
+    }
+    if (_prop.is_print())
+        std::cout << "(Binary cache)\n";
+    _prop += parsing_prop::MMAP;
+    readBinary(cache.c_str(), _prop.is_print());
+    return true;
+}
+
+template<typename vid_t, typename eoff_t>
+void GraphStd<vid_t, eoff_t>::writeCache(const char* filename, uint64_t key) {
+    binary::SourceKey source_key;
+    if (!binary::source_key(filename, key, source_key) ||
+            std::memcmp(&source_key, &_source_key, sizeof(source_key)) != 0) {
+        WARNING(filename, " changed during the parsing: binary cache not "
+                "written")
+        return;
+    }
+    auto cache = cache_file(filename, key);
+    auto pos   = cache.find_last_of('/');
+    auto dir   = pos == 0 ? std::string("/") : cache.substr(0, pos);
+    if (::access(dir.c_str(), W_OK) != 0) {
+        WARNING("Binary cache directory not writable: ", dir)
+        return;
+    }
+    binary::Header header {};
+    std::vector<binary::SectionData> sections;
+    binary_sections(header, sections);
+    sections.push_back({ binary::Section::SOURCE_KEY, &_source_key, 1,
+                         sizeof(binary::SourceKey) });
+    //the rename is atomic: concurrent readers find either the previous cache
+    //file or the complete new one
+    auto tmp = cache + ".tmp" + std::to_string(::getpid());
+    binary::write(tmp, header, sections, false, false);
+    if (std::rename(tmp.c_str(), cache.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        WARNING("Unable to write the binary cache ", cache)
+        return;
+    }
+    if (_prop.is_print())
+        std::cout << "Binary cache: " << cache << "\n" << std::endl;
 }
 
 #pragma clang diagnostic pop
@@ -228,6 +833,8 @@ void GraphStd<vid_t, eoff_t>::readBinary(const char* filename, bool print) {
 //------------------------------------------------------------------------------
 
 template class GraphStd<int, int>;
+template class GraphStd<int, int64_t>;
+template class GraphStd<unsigned, int64_t>;
 template class GraphStd<int64_t, int64_t>;
 
 } // namespace graph
@@ -34,13 +34,17 @@
  * </blockquote>}
  */
 #include "GraphIO/GraphWeight.hpp"
+#include "Host/Algorithm.hpp" //xlib::parallel_radix_sort
 #include "Host/Basic.hpp"     //ERROR
-#include "Host/FileUtil.hpp"  //xlib::MemoryMapped
+#include "Host/FileUtil.hpp"  //xlib::MemoryMapped, xlib::parallel_write
+#include "Host/Numeric.hpp"   //xlib::ceil_log2
 #include "Host/PrintExt.hpp"  //xlib::printArray
 #include <algorithm>          //std::iota, std::shuffle
 #include <cassert>            //assert
 #include <chrono>             //std::chrono
 #include <random>             //std::mt19937_64
+#include <string>             //std::to_string
+#include <tuple>              //std::tuple
 
 namespace graph {
 
@@ -64,21 +68,33 @@ GraphWeight<vid_t, eoff_t, weight_t>
 template<typename vid_t, typename eoff_t, typename weight_t>
 GraphWeight<vid_t, eoff_t, weight_t>
 ::GraphWeight(const char* filename, const ParsingProp& property) noexcept :
-                    GraphStd<vid_t, eoff_t>(filename, property) {}
+                    GraphStd<vid_t, eoff_t>() {
+    //read() in the GraphStd constructor would dispatch to the unweighted
+    //readers: the object is not a GraphWeight yet
+    GraphBase<vid_t, eoff_t>::read(filename, property);
+}
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 GraphWeight<vid_t, eoff_t, weight_t>
 ::GraphWeight(StructureProp structure, const char* filename,
               const ParsingProp& property) noexcept :
-                    GraphStd<vid_t, eoff_t>(structure, filename, property) {}
+                    GraphStd<vid_t, eoff_t>(std::move(structure)) {
+    GraphBase<vid_t, eoff_t>::read(filename, property);
+}
 
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
 ::allocate(const GInfo& ginfo) noexcept {
+    //the weights follow the COO order: the in-place build is not supported
+    if (_prop.is_low_memory()) {
+        WARNING("LOW_MEMORY is not supported by GraphWeight: ignored")
+        _prop -= parsing_prop::LOW_MEMORY;
+    }
     GraphStd<vid_t, eoff_t>::allocate(ginfo);
     try {
+        _coo_weights = new weight_t[ _nE ];
         _out_weights = new weight_t[ _nE ];
         if (_structure.is_undirected()) {
             _in_weights = _out_weights;
@@ -92,30 +108,115 @@ void GraphWeight<vid_t, eoff_t, weight_t>
     }
 }
 
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::generateWeights(const EdgeGenerator<vid_t>& generator, size_t num_lines) {
+    generator.generate_weights(_coo_weights, num_lines);
+}
+
 template<typename vid_t, typename eoff_t, typename weight_t>
 GraphWeight<vid_t, eoff_t, weight_t>::~GraphWeight() noexcept {
+    delete[] _coo_weights;
+    if (_reverse_on_demand)
+        delete[] _in_weights;
+    if (_mapped_csr)
+        return;
     delete[] _out_weights;
     if (_structure.is_directed() && _structure.is_reverse())
         delete[] _in_weights;
 }
 
+template<typename vid_t, typename eoff_t, typename weight_t>
+eoff_t GraphWeight<vid_t, eoff_t, weight_t>::sortCOO(bool remove_duplicates)
+                                                     noexcept {
+    auto nE   = static_cast<size_t>(_nE);
+    int  bits = _nV > 1 ? xlib::ceil_log2(_nV) : 1;
+    if (2 * bits > 64) {
+        using edge_t = std::tuple<vid_t, vid_t, weight_t>;
+        auto edges = new edge_t[nE];
+        for (size_t i = 0; i < nE; i++) {
+            edges[i] = edge_t(_coo_edges[i].first, _coo_edges[i].second,
+                              _coo_weights[i]);
+        }
+        std::sort(edges, edges + nE);
+        auto last = remove_duplicates ? std::unique(edges, edges + nE)
+                                      : edges + nE;
+        nE = static_cast<size_t>(std::distance(edges, last));
+        for (size_t i = 0; i < nE; i++) {
+            _coo_edges[i]   = { std::get<0>(edges[i]), std::get<1>(edges[i]) };
+            _coo_weights[i] = std::get<2>(edges[i]);
+        }
+        delete[] edges;
+        return static_cast<eoff_t>(nE);
+    }
+    //the weights are sorted in-place as the payload of the keys
+    auto keys = new uint64_t[nE];
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nE, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                auto  src = static_cast<uint64_t>(_coo_edges[i].first);
+                auto dest = static_cast<uint64_t>(_coo_edges[i].second);
+                keys[i]   = (src << bits) | dest;
+            }
+        });
+    xlib::parallel_radix_sort(keys, _coo_weights, nE, 2 * bits);
+    //same order of std::sort on (source, destination, weight) tuples
+    for (size_t i = 0; i < nE; ) {
+        auto j = i + 1;
+        while (j < nE && keys[j] == keys[i])
+            j++;
+        if (j - i > 1)
+            std::sort(_coo_weights + i, _coo_weights + j);
+        i = j;
+    }
+    if (remove_duplicates) {
+        size_t k = 0;
+        for (size_t i = 0; i < nE; i++) {
+            if (k == 0 || keys[i] != keys[k - 1] ||
+                    _coo_weights[i] != _coo_weights[k - 1]) {
+                keys[k]         = keys[i];
+                _coo_weights[k] = _coo_weights[i];
+                k++;
+            }
+        }
+        nE = k;
+    }
+    auto mask = (uint64_t(1) << bits) - 1;
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nE, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                _coo_edges[i] = { static_cast<vid_t>(keys[i] >> bits),
+                                  static_cast<vid_t>(keys[i] & mask) };
+            }
+        });
+    delete[] keys;
+    return static_cast<eoff_t>(nE);
+}
+
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>::COOtoCSR() noexcept {
     if (_directed_to_undirected || _stored_undirected) {
-        eoff_t half = _nE / 2;
-        for (eoff_t i = 0; i < half; i++)
-            _coo_edges[i + half] = coo_t( std::get<1>(_coo_edges[i]),
-                                          std::get<0>(_coo_edges[i]),
-                                          std::get<2>(_coo_edges[i]) );
+        auto half = static_cast<size_t>(_nE / 2);
+        xlib::parallel_run([&](int thread_id, int num_threads) {
+                auto start = xlib::thread_chunk(half, thread_id, num_threads);
+                auto   end = xlib::thread_chunk(half, thread_id + 1,
+                                                num_threads);
+                for (auto i = start; i < end; i++) {
+                    _coo_edges[i + half] = { _coo_edges[i].second,
+                                             _coo_edges[i].first };
+                }
+                std::copy(_coo_weights + start, _coo_weights + end,
+                          _coo_weights + start + half);
+            });
     }
     if (_directed_to_undirected) {
         if (_prop.is_print()) {
             std::cout << "Directed to Undirected: Removing duplicated edges..."
                       << std::flush;
         }
-        std::sort(_coo_edges, _coo_edges + _nE);
-        auto   last = std::unique(_coo_edges, _coo_edges + _nE);
-        auto new_nE = std::distance(_coo_edges, last);
+        auto new_nE = sortCOO(true);
         if (_prop.is_print() && new_nE != _nE) {
             std::cout << "(" << xlib::format(_nE - new_nE) << " edges removed)"
                       << std::endl;
@@ -126,8 +227,11 @@ void GraphWeight<vid_t, eoff_t, weight_t>::COOtoCSR() noexcept {
         std::cout << "Undirected to Directed: Removing random edges..."
                   << std::endl;
         for (eoff_t i = 0, k = 0; i < _nE; i++) {
-            if (_bitmask[i])
-                _coo_edges[k++] = _coo_edges[i];
+            if (_bitmask[i]) {
+                _coo_edges[k]   = _coo_edges[i];
+                _coo_weights[k] = _coo_weights[i];
+                k++;
+            }
         }
         _bitmask.free();
     }
@@ -140,61 +244,106 @@ void GraphWeight<vid_t, eoff_t, weight_t>::COOtoCSR() noexcept {
         std::iota(random_array, random_array + _nV, 0);
         std::shuffle(random_array, random_array + _nV, std::mt19937_64(seed));
         for (eoff_t i = 0; i < _nE; i++) {
-            vid_t  src = std::get<0>(_coo_edges[i]);
-            vid_t dest = std::get<1>(_coo_edges[i]);
-            std::get<0>(_coo_edges[i]) = random_array[ src ];
-            std::get<1>(_coo_edges[i]) = random_array[ dest ];
+            _coo_edges[i].first  = random_array[ _coo_edges[i].first ];
+            _coo_edges[i].second = random_array[ _coo_edges[i].second ];
         }
+        if (!_id_map.empty())
+            _id_map.permute(random_array);
         delete[] random_array;
     }
     if (_prop.is_sort() && (!_directed_to_undirected || _prop.is_randomize())) {
         if (_prop.is_print())
             std::cout << "Sorting..." << std::endl;
-        std::sort(_coo_edges, _coo_edges + _nE);
+        sortCOO(false);
     }
     //--------------------------------------------------------------------------
     if (_prop.is_print())
         std::cout << "COO to CSR...\t" << std::flush;
 
-    for (eoff_t i = 0; i < _nE; i++) {
-        vid_t  src = std::get<0>(_coo_edges[i]);
-        _out_degrees[src]++;
-        if (_structure.is_reverse()) {
-            vid_t dest = std::get<1>(_coo_edges[i]);
-            _in_degrees[dest]++;
-        }
-    }
-    _out_offsets[0] = 0;
-    std::partial_sum(_out_degrees, _out_degrees + _nV, _out_offsets + 1);
-
-    auto tmp = new degree_t[_nV]();
-    for (size_t i = 0; i < _coo_size; i++) {
-        vid_t    src = std::get<0>(_coo_edges[i]);
-        vid_t   dest = std::get<1>(_coo_edges[i]);
-        auto offset1 = _out_offsets[src] + tmp[src]++;
-        _out_edges[ offset1 ]   = dest;
-        _out_weights[ offset1 ] = std::get<2>(_coo_edges[i]);
-    }
+    auto nE = static_cast<size_t>(_nE);
+    auto nV = static_cast<size_t>(_nV);
+    xlib::parallel_counting_sort(nE, nV,
+                    [&](size_t i) { return _coo_edges[i].first; },
+                    [&](size_t i, eoff_t pos) {
+                        _out_edges[pos]   = _coo_edges[i].second;
+                        _out_weights[pos] = _coo_weights[i];
+                    }, _out_degrees, _out_offsets);
 
     if (_structure.is_directed() && _structure.is_reverse()) {
-        _in_offsets[0] = 0;
-        std::partial_sum(_in_degrees, _in_degrees + _nV, _in_offsets + 1);
-        std::fill(tmp, tmp + _nV, 0);
-        for (eoff_t i = 0; i < _coo_size; i++) {
-            vid_t  src = std::get<0>(_coo_edges[i]);
-            vid_t dest = std::get<1>(_coo_edges[i]);
-            auto offset = _in_offsets[dest] + tmp[dest]++;
-            _in_edges[ offset ]   = src;
-            _in_weights[ offset ] = std::get<2>(_coo_edges[i]);
-        }
+        xlib::parallel_counting_sort(nE, nV,
+                    [&](size_t i) { return _coo_edges[i].second; },
+                    [&](size_t i, eoff_t pos) {
+                        _in_edges[pos]   = _coo_edges[i].first;
+                        _in_weights[pos] = _coo_weights[i];
+                    }, _in_degrees, _in_offsets);
     }
-    delete[] tmp;
     if (!_structure.is_coo()) {
         delete[] _coo_edges;
-        _coo_edges = nullptr;
+        delete[] _coo_weights;
+        _coo_edges   = nullptr;
+        _coo_weights = nullptr;
     }
     if (_prop.is_print())
         std::cout << "Complete!\n" << std::endl;
+    reorderByProperty();
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::permuteEdgeData(const eoff_t* out_map, const eoff_t* in_map) {
+    auto nE = static_cast<size_t>(_nE);
+    const auto& gather = [&](const weight_t* weights, const eoff_t* map) {
+            auto new_weights = new weight_t[nE];
+            xlib::parallel_run([&](int thread_id, int num_threads) {
+                    auto start = xlib::thread_chunk(nE, thread_id,
+                                                    num_threads);
+                    auto   end = xlib::thread_chunk(nE, thread_id + 1,
+                                                    num_threads);
+                    for (auto i = start; i < end; i++)
+                        new_weights[i] = weights[map[i]];
+                });
+            return new_weights;
+        };
+    auto out_weights = gather(_out_weights, out_map);
+    auto  in_weights = in_map != nullptr ? gather(_in_weights, in_map)
+                                         : nullptr;
+    if (!_mapped_csr) {
+        delete[] _out_weights;
+        if (in_map != nullptr)
+            delete[] _in_weights;
+    }
+    _out_weights = out_weights;
+    _in_weights  = in_map != nullptr ? in_weights :
+                   (_structure.is_undirected() ? out_weights : nullptr);
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>::buildReverse() const {
+    auto nE     = static_cast<size_t>(_nE);
+    auto in_map = new eoff_t[nE];
+    this->transposeCSR(in_map);
+    _in_weights = new weight_t[nE];
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nE, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nE, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++)
+                _in_weights[i] = _out_weights[in_map[i]];
+        });
+    delete[] in_map;
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>::release_reverse() noexcept {
+    if (_structure.is_directed()) {
+        if (_reverse_on_demand || !_mapped_csr)
+            delete[] _in_weights;
+#if defined(__linux__)
+        else if (_binary_file != nullptr)
+            _binary_file->unmap(binary::Section::IN_WEIGHTS);
+#endif
+        _in_weights = nullptr;
+    }
+    GraphStd<vid_t, eoff_t>::release_reverse();
 }
 
 template<typename vid_t, typename eoff_t, typename weight_t>
@@ -214,7 +363,9 @@ void GraphWeight<vid_t, eoff_t, weight_t>::print() const noexcept {
 #pragma clang diagnostic ignored "-Wsign-conversion"
 
 template<typename vid_t, typename eoff_t, typename weight_t>
-void GraphWeight<vid_t, eoff_t, weight_t>::print_raw() const noexcept {
+void GraphWeight<vid_t, eoff_t, weight_t>::print_raw() const {
+    if (_structure.is_reverse())
+        lazy_reverse();
     xlib::printArray(_out_offsets, _nV + 1, "Out-Offsets  ");           //NOLINT
     xlib::printArray(_out_edges,   _nE,     "Out-Edges    ");           //NOLINT
     xlib::printArray(_out_weights, _nE,     "Out-Weights  ");           //NOLINT
@@ -231,39 +382,30 @@ void GraphWeight<vid_t, eoff_t, weight_t>::print_raw() const noexcept {
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
-::toBinary(const std::string& filename, bool print) const {
-    size_t  base_size = sizeof(_nV) + sizeof(_nE) + sizeof(_structure);
-    size_t file_size1 = (static_cast<size_t>(_nV) + 1) * sizeof(eoff_t) +
-                        (static_cast<size_t>(_nE)) * sizeof(vid_t) +
-                        (static_cast<size_t>(_nE)) * sizeof(weight_t);
-
-    bool       twice = _structure.is_directed() && _structure.is_reverse();
-    size_t file_size = base_size + (twice ? file_size1 * 2 : file_size1);
-
-    if (print) {
-        std::cout << "Graph To binary file: " << filename
-                << " (" << (file_size >> 20) << ") MB" << std::endl;
+::binary_sections(binary::Header& header,
+                  std::vector<binary::SectionData>& sections) const {
+    GraphStd<vid_t, eoff_t>::binary_sections(header, sections);
+    xlib::type_name<weight_t>().copy(header.weight_type,
+                                     sizeof(header.weight_type) - 1);
+    auto nE = static_cast<size_t>(_nE);
+    sections.push_back({ binary::Section::OUT_WEIGHTS, _out_weights, nE,
+                         sizeof(weight_t) });
+    if (_structure.is_directed() && _structure.is_reverse()) {
+        sections.push_back({ binary::Section::IN_WEIGHTS, _in_weights, nE,
+                             sizeof(weight_t) });
     }
+}
 
-    std::string class_id = xlib::type_name<vid_t>() + xlib::type_name<eoff_t>() +
-                           xlib::type_name<weight_t>();
-    file_size           += class_id.size();
-    xlib::MemoryMapped memory_mapped(filename.c_str(), file_size,
-                                     xlib::MemoryMapped::WRITE, print);
+template<typename vid_t, typename eoff_t, typename weight_t>
+std::string GraphWeight<vid_t, eoff_t, weight_t>::class_id() const {
+    return GraphStd<vid_t, eoff_t>::class_id() + "," +
+           xlib::type_name<weight_t>();
+}
 
-    if (_structure.is_directed() && _structure.is_reverse()) {
-        memory_mapped.write(class_id.c_str(), class_id.size(),          //NOLINT
-                            &_nV, 1, &_nE, 1, &_structure, 1,           //NOLINT
-                            _out_offsets, _nV + 1, _in_offsets, _nV + 1,//NOLINT
-                            _out_edges, _nE, _in_edges, _nE,            //NOLINT
-                            _out_weights, _nE, _in_weights, _nE);       //NOLINT
-    }
-    else {
-        memory_mapped.write(class_id.c_str(), class_id.size(),          //NOLINT
-                            &_nV, 1, &_nE, 1, &_structure, 1,           //NOLINT
-                            _out_offsets, _nV + 1, _out_edges, _nE,     //NOLINT
-                            _out_weights, _nE);
-    }
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::toBinary(const std::string& filename, bool print, bool checksum) const {
+    this->writeBinary(filename, print, checksum);
 }
 
 #pragma clang diagnostic pop
@@ -272,22 +414,30 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
 ::toMarket(const std::string& filename) const {
-    std::ofstream fout(filename);
-    fout << "%%MatrixMarket matrix coordinate pattern general"
-         << "\n" << _nV << " " << _nV << " " << _nE << "\n";
-    for (vid_t i = 0; i < _nV; i++) {
-        for (eoff_t j = _out_offsets[i]; j < _out_offsets[i + 1]; j++) {
-            fout << i + 1 << " " << _out_edges[j] + 1 << " "
-                 << _out_weights[j] << "\n";
-        }
-    }
-    fout.close();
+    auto header = "%%MatrixMarket matrix coordinate pattern general\n" +
+                  std::to_string(_nV) + " " + std::to_string(_nV) + " " +
+                  std::to_string(_nE) + "\n";
+    //"source destination weight\n", see xlib::format_number()
+    const size_t LINE_BYTES = 2 * 21 + 32 + 3;
+    const auto& edge_op = [&](char* ptr, vid_t src, eoff_t j) {
+            ptr    = xlib::format_integer(ptr, src + 1);
+            *ptr++ = ' ';
+            ptr    = xlib::format_integer(ptr, _out_edges[j] + 1);
+            *ptr++ = ' ';
+            ptr    = xlib::format_number(ptr, _out_weights[j]);
+            *ptr++ = '\n';
+            return ptr;
+        };
+    this->writeText(filename, header, LINE_BYTES, edge_op,
+                    [](char* ptr, vid_t) { return ptr; });
 }
 
 //------------------------------------------------------------------------------
 
 template class GraphWeight<int, int, int>;
 template class GraphWeight<int, int, float>;
+template class GraphWeight<int, int64_t, int>;
+template class GraphWeight<int, int64_t, float>;
 template class GraphWeight<int64_t, int64_t, int64_t>;
 
 } // namespace graph
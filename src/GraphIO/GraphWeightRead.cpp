@@ -37,11 +37,11 @@
  * @file
  */
 #include "GraphIO/GraphWeight.hpp"
-#include "Host/Algorithm.hpp" //xlib::UniqueMap
-#include "Host/FileUtil.hpp"  //xlib::skip_lines, xlib::Progress
+#include "Host/FileUtil.hpp"  //xlib::skip_lines, xlib::read_remaining
+#include <algorithm>          //std::copy, std::max
+#include <cctype>             //std::isspace
 #include <cstring>            //std::strtok
 #include <sstream>            //std::istringstream
-#include <vector>             //std::vector
 
 namespace graph {
 
@@ -50,13 +50,14 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 ::readMarket(std::ifstream& fin, bool print) {
     auto ginfo = GraphBase<vid_t, eoff_t>::getMarketHeader(fin);
     allocate(ginfo);
-    xlib::Progress progress(_coo_size);
+    xlib::Progress progress(ginfo.num_lines);
 
-    for (size_t lines = 0; lines < _coo_size; lines++) {
+    for (size_t lines = 0; lines < ginfo.num_lines; lines++) {
         vid_t index1, index2;
         weight_t weight;
         fin >> index1 >> index2 >> weight;
-        _coo_edges[lines] = coo_t(index1 - 1, index2 - 1, weight);
+        _coo_edges[lines]   = { index1 - 1, index2 - 1 };
+        _coo_weights[lines] = weight;
 
         if (print)
             progress.next(lines);
@@ -66,16 +67,22 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
-::readDimacs9(std::ifstream& fin, bool print) {
-    ERROR("Not Implemented")
+::readDimacs9(std::ifstream& fin, bool) {
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs9Header(fin);
+    allocate(ginfo);
+    auto body = xlib::read_remaining(fin);
+    parseDimacs9(body.data(), body.data() + body.size(), ginfo.num_lines);
 }
 
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
-::readKonect(std::ifstream& fin, bool print) {
-    ERROR("Not Implemented")
+::readKonect(std::ifstream& fin, bool) {
+    auto ginfo = GraphBase<vid_t, eoff_t>::getKonectHeader(fin);
+    allocate(ginfo);
+    auto body = xlib::read_remaining(fin);
+    parseKonect(body.data(), body.data() + body.size(), ginfo.num_lines);
 }
 
 //------------------------------------------------------------------------------
@@ -83,15 +90,21 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
 ::readNetRepo(std::ifstream& fin) {
-    ERROR("Not Implemented")
+    GraphBase<vid_t, eoff_t>::getNetRepoHeader(fin);
+    auto body = xlib::read_remaining(fin);
+    parseNetRepo(body.data(), body.data() + body.size());
 }
 
 //------------------------------------------------------------------------------
 
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
-::readDimacs10(std::ifstream& fin, bool print) {
-    ERROR("Not Implemented")
+::readDimacs10(std::ifstream& fin, bool) {
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs10Header(fin);
+    allocate(ginfo);
+    auto body = xlib::read_remaining(fin);
+    parseDimacs10(body.data(), body.data() + body.size(), ginfo.num_lines,
+                  ginfo.num_edges);
 }
 
 //------------------------------------------------------------------------------
@@ -102,19 +115,20 @@ void GraphWeight<vid_t, eoff_t, weight_t>
     auto ginfo = GraphBase<vid_t, eoff_t>::getSnapHeader(fin);
     allocate(ginfo);
 
-    xlib::Progress progress(_coo_size);
+    xlib::Progress progress(ginfo.num_lines);
     while (fin.peek() == '#')
         xlib::skip_lines(fin);
 
-    xlib::UniqueMap<vid_t, vid_t> map;
-    for (size_t lines = 0; lines < _coo_size; lines++) {
+    for (size_t lines = 0; lines < ginfo.num_lines; lines++) {
         vid_t v1, v2;
         weight_t weight;
         fin >> v1 >> v2 >> weight;
-        _coo_edges[lines] = coo_t(map.insert(v1), map.insert(v2), weight);
+        _coo_edges[lines]   = { v1, v2 };
+        _coo_weights[lines] = weight;
         if (print)
             progress.next(lines);
     }
+    relabelCOO(ginfo.num_lines);
 }
 
 //------------------------------------------------------------------------------
@@ -128,6 +142,241 @@ void GraphWeight<vid_t, eoff_t, weight_t>
     /// TO IMPLEMENT
 }
 
+//==============================================================================
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readMarket(const char* start, const char* end, bool) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getMarketHeader(stream);
+    allocate(ginfo);
+
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '%') ? -1 : 1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= ginfo.num_lines)
+            return;
+        vid_t index1, index2;
+        weight_t weight;
+        ptr = xlib::parse_integer(ptr, line_end, index1);
+        ptr = xlib::parse_integer(ptr, line_end, index2);
+        xlib::parse_number(ptr, line_end, weight);
+        _coo_edges[line_id]   = { index1 - 1, index2 - 1 };
+        _coo_weights[line_id] = weight;
+    };
+    auto read_lines = xlib::parallel_parse(stream.current(), end,
+                                           count_op, parse_op);
+    detail::check_lines("Market", ginfo.num_lines, read_lines);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readDimacs9(const char* start, const char* end, bool) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs9Header(stream);
+    allocate(ginfo);
+    parseDimacs9(stream.current(), end, ginfo.num_lines);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readKonect(const char* start, const char* end, bool) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getKonectHeader(stream);
+    allocate(ginfo);
+    parseKonect(stream.current(), end, ginfo.num_lines);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readNetRepo(const char* start, const char* end) {
+    xlib::MemoryStream stream(start, end);
+    GraphBase<vid_t, eoff_t>::getNetRepoHeader(stream);
+    parseNetRepo(stream.current(), end);
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readDimacs10(const char* start, const char* end, bool) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getDimacs10Header(stream);
+    allocate(ginfo);
+    parseDimacs10(stream.current(), end, ginfo.num_lines, ginfo.num_edges);
+}
+
+//==============================================================================
+//  Parallel in-memory parsers: the weights are stored directly into
+//  `_coo_weights`, no intermediate token is allocated
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::parseDimacs9(const char* start, const char* end, size_t num_lines) {
+    //arc lines: "a source destination weight"
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr != line_end && *ptr == 'a') ? 1 : -1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= num_lines)
+            return;
+        vid_t index1, index2;
+        weight_t weight;
+        ptr = xlib::skip_blanks(ptr, line_end) + 1;     //skip 'a'
+        ptr = xlib::parse_integer(ptr, line_end, index1);
+        ptr = xlib::parse_integer(ptr, line_end, index2);
+        xlib::parse_number(ptr, line_end, weight);
+        _coo_edges[line_id]   = { index1 - 1, index2 - 1 };
+        _coo_weights[line_id] = weight;
+    };
+    auto read_lines = xlib::parallel_parse(start, end, count_op, parse_op);
+    detail::check_lines("Dimacs9th", num_lines, read_lines);
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::parseKonect(const char* start, const char* end, size_t num_lines) {
+    //"source destination [weight [timestamp]]", unit weight if missing
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '%') ? -1 : 1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= num_lines)
+            return;
+        vid_t index1, index2;
+        weight_t weight = 1;
+        ptr = xlib::parse_integer(ptr, line_end, index1);
+        ptr = xlib::parse_integer(ptr, line_end, index2);
+        if (xlib::skip_blanks(ptr, line_end) != line_end)
+            xlib::parse_number(ptr, line_end, weight);
+        _coo_edges[line_id]   = { index1 - 1, index2 - 1 };
+        _coo_weights[line_id] = weight;
+    };
+    auto read_lines = xlib::parallel_parse(start, end, count_op, parse_op);
+    detail::check_lines("Konect", num_lines, read_lines);
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::parseDimacs10(const char* start, const char* end, size_t num_lines,
+                size_t num_edges) {
+    //line i: "neighbor [weight] neighbor [weight] ...", unit weight if the
+    //header `fmt` is not 1
+    int tokens_per_edge = _stored_weights ? 2 : 1;
+    const auto& count_op = [&](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        if (ptr != line_end && *ptr == '%')
+            return -1;
+        int count = 0;
+        while (ptr != line_end) {
+            do {
+                ptr++;
+            } while (ptr != line_end && !std::isspace(*ptr));
+            count++;
+            ptr = xlib::skip_blanks(ptr, line_end);
+        }
+        return count / tokens_per_edge;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t item_id) {
+        if (line_id >= num_lines)
+            return;
+        ptr = xlib::skip_blanks(ptr, line_end);
+        while (ptr != line_end) {
+            vid_t    dest;
+            weight_t weight = 1;
+            ptr = std::max(xlib::parse_integer(ptr, line_end, dest), ptr + 1);
+            if (_stored_weights)
+                ptr = xlib::parse_number(ptr, line_end, weight);
+            if (item_id < num_edges) {
+                _coo_edges[item_id]   = { static_cast<vid_t>(line_id),
+                                          dest - 1 };
+                _coo_weights[item_id] = weight;
+                item_id++;
+            }
+            ptr = xlib::skip_blanks(ptr, line_end);
+        }
+    };
+    auto read_edges = xlib::parallel_parse(start, end, count_op, parse_op);
+    detail::check_edges("Dimacs10th", num_edges, read_edges);
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::parseNetRepo(const char* start, const char* end) {
+    //"source,destination[,weight]", unit weight if missing
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '%') ? -1 : 1;
+    };
+    const auto& skip_op = [](const char*, const char*, size_t, size_t) {};
+    auto num_lines = xlib::parallel_parse(start, end, count_op, skip_op);
+
+    auto coo_edges = new std::pair<vid_t, vid_t>[num_lines];
+    auto   weights = new weight_t[num_lines];
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        vid_t index1, index2;
+        weight_t weight = 1;
+        ptr = xlib::parse_integer(ptr, line_end, index1);  //',' is a blank
+        ptr = xlib::parse_integer(ptr, line_end, index2);
+        if (xlib::skip_blanks(ptr, line_end) != line_end)
+            xlib::parse_number(ptr, line_end, weight);
+        coo_edges[line_id] = { index1, index2 };
+        weights[line_id]   = weight;
+    };
+    xlib::parallel_parse(start, end, count_op, parse_op);
+    //allocate() is called with the number of unique vertices
+    this->allocateRelabeled(coo_edges, num_lines);
+    std::copy(weights, weights + num_lines, _coo_weights);
+    delete[] coo_edges;
+    delete[] weights;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>
+::readSnap(const char* start, const char* end, bool) {
+    xlib::MemoryStream stream(start, end);
+    auto ginfo = GraphBase<vid_t, eoff_t>::getSnapHeader(stream);
+    allocate(ginfo);
+
+    const auto& count_op = [](const char* ptr, const char* line_end) {
+        ptr = xlib::skip_blanks(ptr, line_end);
+        return (ptr == line_end || *ptr == '#') ? -1 : 1;
+    };
+    const auto& parse_op = [&](const char* ptr, const char* line_end,
+                               size_t line_id, size_t) {
+        if (line_id >= ginfo.num_lines)
+            return;
+        vid_t v1, v2;
+        weight_t weight;
+        ptr = xlib::parse_integer(ptr, line_end, v1);
+        ptr = xlib::parse_integer(ptr, line_end, v2);
+        xlib::parse_number(ptr, line_end, weight);
+        _coo_edges[line_id]   = { v1, v2 };
+        _coo_weights[line_id] = weight;
+    };
+    auto read_lines = xlib::parallel_parse(stream.current(), end,
+                                           count_op, parse_op);
+    detail::check_lines("SNAP", ginfo.num_lines, read_lines);
+    relabelCOO(ginfo.num_lines);
+}
+
 //------------------------------------------------------------------------------
 
 #if defined(__linux__)
@@ -137,6 +386,20 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 template<typename vid_t, typename eoff_t, typename weight_t>
 void GraphWeight<vid_t, eoff_t, weight_t>
 ::readBinary(const char* filename, bool print) {
+    if (binary::is_v2(filename)) {
+        this->readBinaryV2(filename, print);
+        if (xlib::type_name<weight_t>() !=
+                _binary_file->header().weight_type) {
+            ERROR("Different weight type: ",
+                  _binary_file->header().weight_type)
+        }
+        _out_weights = this->template readSection<weight_t>(
+                binary::Section::OUT_WEIGHTS, static_cast<size_t>(_nE));
+        if (_structure.is_undirected())
+            _in_weights = _out_weights;
+        return;
+    }
+    //legacy format
     size_t file_size = xlib::file_size(filename);
     xlib::MemoryMapped memory_mapped(filename, file_size,
                                      xlib::MemoryMapped::READ, print);
@@ -161,14 +424,23 @@ void GraphWeight<vid_t, eoff_t, weight_t>
                            _out_edges, _nE, _in_edges, _nE,             //NOLINT
                            _out_weights, _nE, _in_weights, _nE);
         for (vid_t i = 0; i < _nV; i++)
-            _in_degrees[i] = _in_offsets[i + 1] - _in_offsets[i - 1];
+            _in_degrees[i] = _in_offsets[i + 1] - _in_offsets[i];
     }
     else {
         memory_mapped.read(_out_offsets, _nV + 1, _out_edges, _nE,      //NOLINT
                            _out_weights, _nE);                          //NOLINT
     }
     for (vid_t i = 0; i < _nV; i++)
-        _out_degrees[i] = _out_offsets[i + 1] - _out_offsets[i - 1];
+        _out_degrees[i] = _out_offsets[i + 1] - _out_offsets[i];
+}
+
+template<typename vid_t, typename eoff_t, typename weight_t>
+void GraphWeight<vid_t, eoff_t, weight_t>::readReverseSections() const {
+    GraphStd<vid_t, eoff_t>::readReverseSections();
+    if (_structure.is_directed() && _structure.is_reverse()) {
+        _in_weights = this->template readSection<weight_t>(
+                binary::Section::IN_WEIGHTS, static_cast<size_t>(_nE));
+    }
 }
 
 #pragma clang diagnostic pop
@@ -177,6 +449,8 @@ void GraphWeight<vid_t, eoff_t, weight_t>
 
 template class GraphWeight<int, int, int>;
 template class GraphWeight<int, int, float>;
+template class GraphWeight<int, int64_t, int>;
+template class GraphWeight<int, int64_t, float>;
 template class GraphWeight<int64_t, int64_t, int64_t>;
 
 } // namespace graph
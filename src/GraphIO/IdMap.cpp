@@ -0,0 +1,113 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/IdMap.hpp"
+#include <algorithm>    //std::lower_bound
+#include <cassert>      //assert
+#include <cstdint>      //int64_t
+#include <type_traits>  //std::make_unsigned
+
+namespace graph {
+
+template<typename vid_t>
+const vid_t IdMap<vid_t>::NOT_FOUND;
+
+template<typename vid_t>
+IdMap<vid_t>::~IdMap() noexcept {
+    clear();
+}
+
+template<typename vid_t>
+void IdMap<vid_t>::clear() noexcept {
+    delete[] _sorted_ids;
+    delete[] _relabeled_ids;
+    delete[] _original_ids;
+    _sorted_ids    = nullptr;
+    _relabeled_ids = nullptr;
+    _original_ids  = nullptr;
+    _size          = 0;
+}
+
+template<typename vid_t>
+void IdMap<vid_t>::permute(const vid_t* permutation) noexcept {
+    for (size_t i = 0; i < _size; i++) {
+        _relabeled_ids[i] = permutation[_relabeled_ids[i]];
+        _original_ids[_relabeled_ids[i]] = _sorted_ids[i];
+    }
+}
+
+template<typename vid_t>
+size_t IdMap<vid_t>::size() const noexcept {
+    return _size;
+}
+
+template<typename vid_t>
+bool IdMap<vid_t>::empty() const noexcept {
+    return _size == 0;
+}
+
+template<typename vid_t>
+vid_t IdMap<vid_t>::original_id(vid_t relabeled_id) const noexcept {
+    assert(relabeled_id >= 0 && static_cast<size_t>(relabeled_id) < _size);
+    return _original_ids[relabeled_id];
+}
+
+template<typename vid_t>
+vid_t IdMap<vid_t>::relabeled_id(vid_t original_id) const noexcept {
+    using unsigned_t = typename std::make_unsigned<vid_t>::type;
+    //same order of the radix sort
+    const auto& less = [](vid_t a, vid_t b) {
+                            return static_cast<unsigned_t>(a) <
+                                   static_cast<unsigned_t>(b);
+                        };
+    auto it = std::lower_bound(_sorted_ids, _sorted_ids + _size, original_id,
+                               less);
+    if (it == _sorted_ids + _size || *it != original_id)
+        return NOT_FOUND;
+    return _relabeled_ids[it - _sorted_ids];
+}
+
+template<typename vid_t>
+const vid_t* IdMap<vid_t>::original_ids() const noexcept {
+    return _original_ids;
+}
+
+//------------------------------------------------------------------------------
+
+template class IdMap<int>;
+template class IdMap<unsigned>;
+template class IdMap<int64_t>;
+
+} // namespace graph
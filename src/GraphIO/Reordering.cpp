@@ -0,0 +1,309 @@
+/**
+ * @author Federico Busato                                                  <br>
+ *         Univerity of Verona, Dept. of Computer Science                   <br>
+ *         federico.busato@univr.it
+ * @date June, 2017
+ * @version v1.3
+ *
+ * @copyright Copyright © 2017 cuStinger. All rights reserved.
+ *
+ * @license{<blockquote>
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * </blockquote>}
+ */
+#include "GraphIO/Reordering.hpp"
+#include "Host/Algorithm.hpp"   //xlib::parallel_run, xlib::parallel_radix_sort
+#include "Host/Numeric.hpp"     //xlib::ceil_log2
+#include <algorithm>            //std::sort, std::reverse
+#include <atomic>               //std::atomic
+#include <cstdint>              //uint64_t
+#include <limits>               //std::numeric_limits
+#include <numeric>              //std::iota
+#include <vector>               //std::vector
+
+namespace graph {
+namespace {
+
+///@brief BFS levels smaller than this threshold are visited sequentially
+const size_t PARALLEL_LEVEL = 4096;
+
+/**
+ * @brief Vertices sorted by degree, ties by id
+ */
+template<typename vid_t, typename eoff_t>
+void degree_order(const eoff_t* offsets, size_t nV, bool decreasing,
+                  vid_t* order) {
+    auto keys = new uint64_t[nV];
+    std::vector<uint64_t> max_degrees(xlib::num_threads(), 0);
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++) {
+                keys[i]  = static_cast<uint64_t>(offsets[i + 1] - offsets[i]);
+                order[i] = static_cast<vid_t>(i);
+                max_degrees[thread_id] = std::max(max_degrees[thread_id],
+                                                  keys[i]);
+            }
+        });
+    auto max_degree = *std::max_element(max_degrees.begin(),
+                                        max_degrees.end());
+    if (decreasing) {
+        xlib::parallel_run([&](int thread_id, int num_threads) {
+                auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+                auto   end = xlib::thread_chunk(nV, thread_id + 1,
+                                                num_threads);
+                for (auto i = start; i < end; i++)
+                    keys[i] = max_degree - keys[i];
+            });
+    }
+    int bits = max_degree > 0 ? xlib::ceil_log2(max_degree + 1) : 1;
+    xlib::parallel_radix_sort(keys, order, nV, bits);
+    delete[] keys;
+}
+
+/**
+ * @brief Level-synchronous BFS visit order of all vertices
+ * @details A vertex is discovered by the first vertex of the frontier which
+ *          reaches it (atomic minimum of the frontier positions), then the
+ *          frontier vertices emit their children in adjacency order: the
+ *          result is the order of the sequential visit
+ * @param[in] starts vertices in the order in which they start a new visit
+ * @param[in] sort_children emit the children by increasing degree
+ *            (Cuthill-McKee)
+ */
+template<typename vid_t, typename eoff_t>
+void bfs_order(const eoff_t* offsets, const vid_t* edges, size_t nV,
+               const vid_t* starts, bool sort_children, vid_t* order) {
+    const vid_t NONE = std::numeric_limits<vid_t>::max();
+    const auto& degree = [&](vid_t v) { return offsets[v + 1] - offsets[v]; };
+    auto parents = new std::atomic<vid_t>[nV];
+    auto visited = new bool[nV]();
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++)
+                parents[i].store(NONE, std::memory_order_relaxed);
+        });
+    std::vector<std::vector<vid_t>> buffers(xlib::num_threads());
+    std::vector<size_t> counts(xlib::num_threads() + 1);
+
+    size_t tail = 0, next_start = 0;
+    while (tail < nV) {
+        while (visited[starts[next_start]])
+            next_start++;
+        auto source     = starts[next_start];
+        visited[source] = true;
+        order[tail++]   = source;
+        size_t front_start = tail - 1;
+
+        while (front_start < tail) {
+            auto frontier    = order + front_start;
+            auto size        = tail - front_start;
+            int  num_threads = size < PARALLEL_LEVEL ? 1 : xlib::num_threads();
+            xlib::parallel_run([&](int thread_id, int n) {
+                    auto start = xlib::thread_chunk(size, thread_id, n);
+                    auto   end = xlib::thread_chunk(size, thread_id + 1, n);
+                    for (auto i = start; i < end; i++) {
+                        auto u = frontier[i];
+                        for (auto e = offsets[u]; e < offsets[u + 1]; e++) {
+                            auto v = edges[e];
+                            if (visited[v])
+                                continue;
+                            auto pos = static_cast<vid_t>(i);
+                            auto old = parents[v].load(
+                                                std::memory_order_relaxed);
+                            while (pos < old &&
+                                   !parents[v].compare_exchange_weak(old, pos,
+                                                std::memory_order_relaxed));
+                        }
+                    }
+                }, num_threads);
+
+            counts[0] = 0;
+            xlib::parallel_run([&](int thread_id, int n) {
+                    auto start  = xlib::thread_chunk(size, thread_id, n);
+                    auto   end  = xlib::thread_chunk(size, thread_id + 1, n);
+                    auto& local = buffers[thread_id];
+                    local.clear();
+                    for (auto i = start; i < end; i++) {
+                        auto u     = frontier[i];
+                        auto first = local.size();
+                        for (auto e = offsets[u]; e < offsets[u + 1]; e++) {
+                            auto v = edges[e];
+                            //the parent is unique: only this thread
+                            //accesses visited[v] during the level
+                            if (parents[v].load(std::memory_order_relaxed) !=
+                                    static_cast<vid_t>(i) || visited[v])
+                                continue;
+                            visited[v] = true;
+                            local.push_back(v);
+                        }
+                        if (sort_children) {
+                            std::sort(local.begin() + first, local.end(),
+                                      [&](vid_t a, vid_t b) {
+                                          return degree(a) < degree(b) ||
+                                                 (degree(a) == degree(b) &&
+                                                  a < b);
+                                      });
+                        }
+                    }
+                    counts[thread_id + 1] = local.size();
+                }, num_threads);
+
+            for (int i = 0; i < num_threads; i++)
+                counts[i + 1] += counts[i];
+            front_start = tail;
+            xlib::parallel_run([&](int thread_id, int) {
+                    std::copy(buffers[thread_id].begin(),
+                              buffers[thread_id].end(),
+                              order + tail + counts[thread_id]);
+                }, num_threads);
+            tail += counts[num_threads];
+        }
+    }
+    delete[] parents;
+    delete[] visited;
+}
+
+/**
+ * @brief Community order: see reorder_permutation()
+ */
+template<typename vid_t, typename eoff_t>
+void community_order(const eoff_t* offsets, const vid_t* edges, size_t nV,
+                     vid_t* order) {
+    const vid_t NONE = std::numeric_limits<vid_t>::max();
+    const auto& degree = [&](vid_t v) {
+                            return static_cast<double>(offsets[v + 1] -
+                                                       offsets[v]);
+                        };
+    auto by_degree = new vid_t[nV];
+    degree_order(offsets, nV, false, by_degree);
+
+    auto community   = new vid_t[nV];       //root of the community
+    auto next        = new vid_t[nV];       //members: linked list
+    auto last        = new vid_t[nV];
+    auto volume      = new double[nV];      //degree sum of the community
+    auto connections = new eoff_t[nV]();    //edges from u to the community
+    std::iota(community, community + nV, 0);
+    std::iota(last, last + nV, 0);
+    std::fill(next, next + nV, NONE);
+    for (size_t i = 0; i < nV; i++)
+        volume[i] = degree(static_cast<vid_t>(i));
+
+    auto total = static_cast<double>(offsets[nV]);
+    std::vector<vid_t> touched;
+    for (size_t i = 0; i < nV; i++) {
+        auto u = by_degree[i];
+        //only singleton communities move
+        if (last[u] != u || offsets[u] == offsets[u + 1])
+            continue;
+        for (auto e = offsets[u]; e < offsets[u + 1]; e++) {
+            auto c = community[edges[e]];
+            if (edges[e] == u)
+                continue;
+            if (connections[c]++ == 0)
+                touched.push_back(c);
+        }
+        //modularity gain (scaled by the number of edges) of u joining c,
+        //ties broken by adjacency order
+        vid_t  best      = u;
+        double best_gain = 0.0;
+        for (auto c : touched) {
+            auto gain = connections[c] - degree(u) * volume[c] / total;
+            if (gain > best_gain) {
+                best      = c;
+                best_gain = gain;
+            }
+            connections[c] = 0;
+        }
+        touched.clear();
+        if (best == u)
+            continue;
+        community[u]  = best;
+        volume[best] += degree(u);
+        next[last[best]] = u;
+        last[best]       = u;
+    }
+    size_t k = 0;
+    for (size_t root = 0; root < nV; root++) {
+        if (community[root] != static_cast<vid_t>(root))
+            continue;
+        for (auto v = static_cast<vid_t>(root); v != NONE; v = next[v])
+            order[k++] = v;
+    }
+    delete[] by_degree;
+    delete[] community;
+    delete[] next;
+    delete[] last;
+    delete[] volume;
+    delete[] connections;
+}
+
+} // namespace
+
+//==============================================================================
+
+template<typename vid_t, typename eoff_t>
+void reorder_permutation(Reordering type, const eoff_t* offsets,
+                         const vid_t* edges, size_t num_vertices,
+                         vid_t* permutation) {
+    auto nV    = num_vertices;
+    auto order = new vid_t[nV];
+    if (type == Reordering::DEGREE)
+        degree_order(offsets, nV, true, order);
+    else if (type == Reordering::COMMUNITY)
+        community_order(offsets, edges, nV, order);
+    else {
+        bool is_rcm = type == Reordering::RCM;
+        auto starts = new vid_t[nV];
+        degree_order(offsets, nV, !is_rcm, starts);
+        bfs_order(offsets, edges, nV, starts, is_rcm, order);
+        if (is_rcm)
+            std::reverse(order, order + nV);
+        delete[] starts;
+    }
+    xlib::parallel_run([&](int thread_id, int num_threads) {
+            auto start = xlib::thread_chunk(nV, thread_id, num_threads);
+            auto   end = xlib::thread_chunk(nV, thread_id + 1, num_threads);
+            for (auto i = start; i < end; i++)
+                permutation[order[i]] = static_cast<vid_t>(i);
+        });
+    delete[] order;
+}
+
+template void reorder_permutation<int, int>(Reordering, const int*,
+                                            const int*, size_t, int*);
+template void reorder_permutation<int, int64_t>(Reordering, const int64_t*,
+                                                const int*, size_t, int*);
+template void reorder_permutation<unsigned, int64_t>(Reordering,
+                                                     const int64_t*,
+                                                     const unsigned*, size_t,
+                                                     unsigned*);
+template void reorder_permutation<int64_t, int64_t>(Reordering,
+                                                    const int64_t*,
+                                                    const int64_t*, size_t,
+                                                    int64_t*);
+
+} // namespace graph
@@ -34,14 +34,15 @@
  * </blockquote>}
  */
 #include "GraphIO/SCC.hpp"
+#include "GraphIO/GraphCompressed.hpp"
 #include "GraphIO/GraphStd.hpp"
 #include "Host/Basic.hpp"
 #include <iomanip>
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
-SCC<vid_t, eoff_t>::SCC(const GraphStd<vid_t, eoff_t>& graph) noexcept :
+template<typename vid_t, typename eoff_t, typename graph_t>
+SCC<vid_t, eoff_t, graph_t>::SCC(const graph_t& graph) noexcept :
                                     _graph(graph),
                                     _in_stack(_graph.nV()),
                                     _queue(_graph.nV()) {
@@ -51,15 +52,15 @@ SCC<vid_t, eoff_t>::SCC(const GraphStd<vid_t, eoff_t>& graph) noexcept :
     reset();
 }
 
-template<typename vid_t, typename eoff_t>
-SCC<vid_t, eoff_t>::~SCC() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+SCC<vid_t, eoff_t, graph_t>::~SCC() noexcept {
     delete[] _low_link;
     delete[] _indices;
     delete[] _color;
 }
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::reset() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::reset() noexcept {
     _curr_index = 0;
     _scc_index  = 0;
     std::fill(_low_link, _low_link + _graph.nV(), MAX_LINK);
@@ -69,8 +70,8 @@ void SCC<vid_t, eoff_t>::reset() noexcept {
     _queue.clear();
 }
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::run() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::run() noexcept {
     for (vid_t i = 0; i < _graph.nV(); i++) {
         if (_indices[i] == NO_INDEX) {
             single_scc(i);
@@ -79,23 +80,23 @@ void SCC<vid_t, eoff_t>::run() noexcept {
     }
 }
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::single_scc(vid_t source) noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::single_scc(vid_t source) noexcept {
     _queue.insert(source);
     _indices[source]  = _low_link[source] = _curr_index++;
     _in_stack[source] = true;
 
-    for (auto i = _graph._out_offsets[source];
-         i < _graph._out_offsets[source + 1]; i++) {
-
-        vid_t dest = _graph._out_edges[i];
-        if ( _indices[dest] == NO_INDEX ) {
-            single_scc(dest);
-            _low_link[source] = std::min(_low_link[source], _low_link[dest]);
-        }
-        else if ( _in_stack[dest] )
-            _low_link[source] = std::min(_low_link[source], _indices[dest]);
-    }
+    _graph.for_each_out(source, [&](vid_t dest) {
+            if ( _indices[dest] == NO_INDEX ) {
+                single_scc(dest);
+                _low_link[source] = std::min(_low_link[source],
+                                             _low_link[dest]);
+            }
+            else if ( _in_stack[dest] ) {
+                _low_link[source] = std::min(_low_link[source],
+                                             _indices[dest]);
+            }
+        });
 
     if (_indices[source] == _low_link[source]) {
         vid_t extracted;
@@ -111,42 +112,42 @@ void SCC<vid_t, eoff_t>::single_scc(vid_t source) noexcept {
     }
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t SCC<vid_t, eoff_t>::size() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t SCC<vid_t, eoff_t, graph_t>::size() const noexcept {
     return _scc_vector.size();
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t SCC<vid_t, eoff_t>::largest() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t SCC<vid_t, eoff_t, graph_t>::largest() const noexcept {
     return *std::max_element(_scc_vector.begin(), _scc_vector.end());
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t SCC<vid_t, eoff_t>::num_trivial() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t SCC<vid_t, eoff_t, graph_t>::num_trivial() const noexcept {
     const auto& lambda = [](const vid_t& item) { return item == 1; };
     return std::count_if(_scc_vector.begin(), _scc_vector.end(), lambda);
 }
 
-template<typename vid_t, typename eoff_t>
-const std::vector<vid_t>& SCC<vid_t, eoff_t>::list() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const std::vector<vid_t>& SCC<vid_t, eoff_t, graph_t>::list() const noexcept {
     return _scc_vector;
 }
 
-template<typename vid_t, typename eoff_t>
-const vid_t* SCC<vid_t, eoff_t>::result() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const vid_t* SCC<vid_t, eoff_t, graph_t>::result() const noexcept {
     return _color;
 }
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::print() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::print() const noexcept {
     std::cout << "SCCs:\n";
     for (const auto& it : _scc_vector)
         std::cout << it << " ";
     std::cout << "\n";
 }
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::print_histogram() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::print_histogram() const noexcept {
     vid_t frequency[32] = {};
     for (const auto& it : _scc_vector)
         frequency[xlib::log2(it)] += it;
@@ -164,12 +165,16 @@ void SCC<vid_t, eoff_t>::print_histogram() const noexcept {
 //------------------------------------------------------------------------------
 
 template class SCC<int, int>;
+template class SCC<int, int64_t>;
 template class SCC<int64_t, int64_t>;
+template class SCC<int, int, GraphCompressed<int, int>>;
+template class SCC<int, int64_t, GraphCompressed<int, int64_t>>;
+template class SCC<int64_t, int64_t, GraphCompressed<int64_t, int64_t>>;
 
 #if defined(STACK)
 
-template<typename vid_t, typename eoff_t>
-void SCC<vid_t, eoff_t>::single_scc(vid_t source) noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void SCC<vid_t, eoff_t, graph_t>::single_scc(vid_t source) noexcept {
         eoff_t i;
         _stack.push({ source, 0 });
 
@@ -34,31 +34,38 @@
  * </blockquote>}
  */
 #include "GraphIO/WCC.hpp"
+#include "GraphIO/GraphCompressed.hpp"
 #include <iomanip>
 
 namespace graph {
 
-template<typename vid_t, typename eoff_t>
-WCC<vid_t, eoff_t>::WCC(const GraphStd<vid_t, eoff_t>& graph) noexcept :
+template<typename vid_t, typename eoff_t, typename graph_t>
+WCC<vid_t, eoff_t, graph_t>::WCC(const graph_t& graph) noexcept :
                                             _graph(graph),
                                             _queue(_graph.nV()) {
     _color = new color_t[_graph.nV()];
     std::fill(_color, _color + _graph.nV(), NO_COLOR);
 }
 
-template<typename vid_t, typename eoff_t>
-WCC<vid_t, eoff_t>::~WCC() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+WCC<vid_t, eoff_t, graph_t>::~WCC() noexcept {
     delete[] _color;
 }
 
-template<typename vid_t, typename eoff_t>
-void WCC<vid_t, eoff_t>::run() noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void WCC<vid_t, eoff_t, graph_t>::run() {
     static bool flag = false;
     if (flag)
         ERROR("WCC cannot be repeated")
     flag = true;
 
     vid_t wcc_count = 0;
+    const auto& color_op = [&](vid_t vertex) {
+            if (_color[vertex] == NO_COLOR) {
+                _color[vertex] = wcc_count;
+                _queue.insert(vertex);
+            }
+        };
     for (vid_t source = 0; source < _graph.nV(); source++) {
         if (_color[source] != NO_COLOR) continue;
 
@@ -70,26 +77,10 @@ void WCC<vid_t, eoff_t>::run() noexcept {
             vid_t current = _queue.extract();
             vertex_count++;
 
-            for (eoff_t i = _graph._out_offsets[current];
-                 i < _graph._out_offsets[current + 1]; i++) {
-
-                vid_t dest = _graph._out_edges[i];
-                if (_color[dest] == NO_COLOR) {
-                    _color[dest] = wcc_count;
-                    _queue.insert(dest);
-                }
-            }
+            _graph.for_each_out(current, color_op);
             if (!_graph.is_directed()) continue;
 
-            for (eoff_t i = _graph._in_offsets[current];
-                i < _graph._in_offsets[current + 1]; i++) {
-
-                vid_t incoming = _graph._in_edges[i];
-                if (_color[incoming] == NO_COLOR) {
-                    _color[incoming] = true;
-                    _queue.insert(incoming);
-                }
-            }
+            _graph.for_each_in(current, color_op);
         }
         _queue.clear();
         _wcc_vector.push_back(vertex_count);
@@ -97,42 +88,42 @@ void WCC<vid_t, eoff_t>::run() noexcept {
     }
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t WCC<vid_t, eoff_t>::size() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t WCC<vid_t, eoff_t, graph_t>::size() const noexcept {
     return _wcc_vector.size();
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t WCC<vid_t, eoff_t>::largest() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t WCC<vid_t, eoff_t, graph_t>::largest() const noexcept {
     return *std::max_element(_wcc_vector.begin(), _wcc_vector.end());
 }
 
-template<typename vid_t, typename eoff_t>
-vid_t WCC<vid_t, eoff_t>::num_trivial() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+vid_t WCC<vid_t, eoff_t, graph_t>::num_trivial() const noexcept {
     const auto lambda = [](const vid_t& item) { return item == 1; };
     return std::count_if(_wcc_vector.begin(), _wcc_vector.end(), lambda);
 }
 
-template<typename vid_t, typename eoff_t>
-const std::vector<vid_t>& WCC<vid_t, eoff_t>::list() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const std::vector<vid_t>& WCC<vid_t, eoff_t, graph_t>::list() const noexcept {
     return _wcc_vector;
 }
 
-template<typename vid_t, typename eoff_t>
-const vid_t* WCC<vid_t, eoff_t>::result() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+const vid_t* WCC<vid_t, eoff_t, graph_t>::result() const noexcept {
     return _color;
 }
 
-template<typename vid_t, typename eoff_t>
-void WCC<vid_t, eoff_t>::print() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void WCC<vid_t, eoff_t, graph_t>::print() const noexcept {
     std::cout << "WCCs:\n";
     for (const auto& it : _wcc_vector)
         std::cout << it << " ";
     std::cout << "\n";
 }
 
-template<typename vid_t, typename eoff_t>
-void WCC<vid_t, eoff_t>::print_histogram() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void WCC<vid_t, eoff_t, graph_t>::print_histogram() const noexcept {
     vid_t frequency[32] = {};
     for (const auto& it : _wcc_vector)
         frequency[xlib::log2(it)] += it;
@@ -148,8 +139,8 @@ void WCC<vid_t, eoff_t>::print_histogram() const noexcept {
     std::cout << std::endl;
 }
 
-template<typename vid_t, typename eoff_t>
-void WCC<vid_t, eoff_t>::print_statistics() const noexcept {
+template<typename vid_t, typename eoff_t, typename graph_t>
+void WCC<vid_t, eoff_t, graph_t>::print_statistics() const noexcept {
     auto ratio_largest = xlib::per_cent(largest(), _graph.nV());
     auto ratio_trivial = xlib::per_cent(num_trivial(),  _graph.nV());
     std::cout << "\n        Number CC: " << xlib::format(size())
@@ -162,6 +153,10 @@ void WCC<vid_t, eoff_t>::print_statistics() const noexcept {
 //------------------------------------------------------------------------------
 
 template class WCC<int, int>;
+template class WCC<int, int64_t>;
 template class WCC<int64_t, int64_t>;
+template class WCC<int, int, GraphCompressed<int, int>>;
+template class WCC<int, int64_t, GraphCompressed<int, int64_t>>;
+template class WCC<int64_t, int64_t, GraphCompressed<int64_t, int64_t>>;
 
 } // namespace graph
@@ -70,6 +70,14 @@ L1:     std::ifstream syntax_file("../docs/Syntax.txt");
             prop -= PRINT_INFO;
         else if (str == "--write-binary")
             write_binary = true;
+        else if (str == "--cache")
+            prop += CACHE;
+        else if (str == "--cache-dir" && i + 1 < argc) {
+            graph::set_cache_directory(argv[++i]);
+            prop += CACHE;
+        }
+        else if (str == "--low-memory")
+            prop += LOW_MEMORY;
         else if (str == "--device-info")
             xlib::device_info();
         else if (str == "--device" && xlib::is_integer(argv[i + 1]))
@@ -170,6 +178,8 @@ L1:     std::ifstream syntax_file("../docs/Syntax.txt");
 
 template CommandLineParam::CommandLineParam(graph::GraphStd<int, int>&,
                                             int, char* argv[], bool);
+template CommandLineParam::CommandLineParam(graph::GraphStd<int, int64_t>&,
+                                            int, char* argv[], bool);
 template CommandLineParam::CommandLineParam(graph::GraphStd<int64_t, int64_t>&,
                                             int, char* argv[], bool);
 
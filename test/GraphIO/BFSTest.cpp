@@ -0,0 +1,139 @@
+#include "GraphIO/BFS.hpp"
+#include "GraphIO/GraphCompressed.hpp"
+#include "GraphIO/SCC.hpp"
+#include "GraphIO/WCC.hpp"
+#include "TestUtil.hpp"
+#include <vector>                   //std::vector
+
+using namespace graph::structure_prop;
+using namespace graph::parsing_prop;
+
+using vid_t  = int;
+using eoff_t = int;
+using dist_t = graph::BFS<vid_t, eoff_t>::dist_t;
+using Mode   = graph::BFS<vid_t, eoff_t>::Mode;
+
+//------------------------------------------------------------------------------
+
+template<typename G>
+std::vector<dist_t> distances(const G& graph, vid_t source, Mode mode,
+                              int num_threads) {
+    graph::BFS<vid_t, eoff_t, G> bfs(graph, mode, num_threads);
+    bfs.run(source);
+    return std::vector<dist_t>(bfs.result(), bfs.result() + graph.nV());
+}
+
+/**
+ * @brief BFS on the compressed CSR (every mode and number of threads)
+ *        matches the BFS on GraphStd
+ */
+void compressed_bfs(const graph::GraphStd<vid_t, eoff_t>& graph) {
+    graph::GraphCompressed<vid_t, eoff_t> compressed(graph);
+    CHECK_EQ(compressed.is_directed(), graph.is_directed())
+    auto source   = graph.max_out_degree_id();
+    auto expected = distances(graph, source, Mode::TOP_DOWN, 1);
+    for (auto mode : { Mode::TOP_DOWN, Mode::DIRECTION_OPTIMIZING }) {
+        for (int num_threads : { 1, 4 }) {
+            CHECK(distances(compressed, source, mode, num_threads) ==
+                  expected)
+        }
+    }
+    graph::BFS<vid_t, eoff_t, decltype(compressed)> bfs(compressed);
+    graph::BFS<vid_t, eoff_t> std_bfs(graph);
+    CHECK_EQ(bfs.diameter(), std_bfs.diameter())
+}
+
+void compressed_components(const graph::GraphStd<vid_t, eoff_t>& graph) {
+    graph::GraphCompressed<vid_t, eoff_t> compressed(graph);
+    graph::WCC<vid_t, eoff_t> wcc(graph);
+    graph::WCC<vid_t, eoff_t, decltype(compressed)> compressed_wcc(compressed);
+    wcc.run();
+    compressed_wcc.run();
+    CHECK(compressed_wcc.list() == wcc.list())
+
+    graph::SCC<vid_t, eoff_t> scc(graph);
+    graph::SCC<vid_t, eoff_t, decltype(compressed)> compressed_scc(compressed);
+    scc.run();
+    compressed_scc.run();
+    CHECK(compressed_scc.list() == scc.list())
+}
+
+/**
+ * @brief radius() and diameter() of the largest component: the edge 4 -> 5
+ *        (eccentricity 1) does not change the result of the 4-cycle
+ */
+void directed_side_component() {
+    test::TempFile file("side_directed.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "6 6 5\n"
+                        "1 2\n2 3\n3 4\n4 1\n5 6\n");
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED);
+    graph.read(file.path(), SORT);
+    graph::BFS<vid_t, eoff_t> bfs(graph);
+    CHECK_EQ(bfs.radius(), 3)
+    CHECK_EQ(bfs.diameter(), 3)
+}
+
+/**
+ * @brief The sink 4 hangs off the cycle 0 -> 1 -> 2 -> 3 and the vertex 5
+ *        reaches only the sink (eccentricity 1): the radius is the one of
+ *        the cycle vertices, which reach every other vertex but 5
+ */
+void directed_sink() {
+    test::TempFile file("sink_directed.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "6 6 6\n"
+                        "1 2\n2 3\n3 4\n4 1\n2 5\n6 5\n");
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED);
+    graph.read(file.path(), SORT);
+    graph::BFS<vid_t, eoff_t> bfs(graph);
+    CHECK_EQ(bfs.radius(), 3)
+    CHECK_EQ(bfs.diameter(), 4)
+}
+
+/**
+ * @brief The bounding algorithm ignores the edge 5 - 6 (eccentricity 1):
+ *        radius and diameter of the path 0 - 1 - 2 - 3 - 4
+ */
+void undirected_side_component() {
+    test::TempFile file("side_undirected.mtx",
+                        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                        "7 7 5\n"
+                        "2 1\n3 2\n4 3\n5 4\n7 6\n");
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(file.path(), SORT);
+    graph::BFS<vid_t, eoff_t> bfs(graph);
+    CHECK_EQ(bfs.radius(), 2)
+    CHECK_EQ(bfs.bfs_runs(), 3)         //double sweep, then from vertex 2
+    CHECK_EQ(bfs.diameter(), 4)
+    CHECK_EQ(bfs.bfs_runs(), 2)         //double sweep
+}
+
+///@brief no BFS runs on a one-vertex component (a self-loop)
+void single_vertex() {
+    test::TempFile file("single.mtx",
+                        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                        "1 1 1\n"
+                        "1 1\n");
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(file.path());
+    graph::BFS<vid_t, eoff_t> bfs(graph);
+    CHECK_EQ(bfs.diameter(), 0)
+    CHECK_EQ(bfs.bfs_runs(), 0)
+}
+
+int main() {
+    graph::GraphStd<vid_t, eoff_t> undirected, directed(DIRECTED);
+    undirected.generate(graph::generator::kronecker(12, 8),
+                        graph::ParsingProp(SORT));
+    directed.generate(graph::generator::rmat(12, 4),
+                      graph::ParsingProp(SORT));
+    compressed_bfs(undirected);
+    compressed_bfs(directed);
+    compressed_components(directed);
+    directed_side_component();
+    directed_sink();
+    undirected_side_component();
+    single_vertex();
+    return test::failures();
+}
@@ -0,0 +1,179 @@
+#include "GraphIO/ExternalCSR.hpp"
+#include "GraphIO/GraphStd.hpp"
+#include "Host/Algorithm.hpp"       //xlib::parallel_counting_sort
+#include "TestUtil.hpp"
+#include <algorithm>                //std::stable_sort, std::equal
+#include <numeric>                  //std::iota
+#include <random>                   //std::mt19937
+#include <sstream>                  //std::ostringstream
+#include <vector>                   //std::vector
+
+using namespace graph::structure_prop;
+using namespace graph::parsing_prop;
+
+using vid_t  = int;
+using eoff_t = int;
+using adj_t  = std::vector<vid_t>;
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Stable order, counts and offsets of the multi-threaded counting sort
+ *        with per-key histograms (many items per key) and with key ranges
+ *        (few items per key, as in low-degree graphs)
+ */
+void counting_sort(size_t size, size_t num_keys, int num_threads,
+                   bool by_range) {
+    auto threads = xlib::counting_sort_threads(size, num_keys, num_threads);
+    CHECK((xlib::counting_sort_bins(size, num_keys, threads) != num_keys) ==
+          by_range)
+
+    std::mt19937 engine(static_cast<unsigned>(size + num_keys));
+    std::uniform_int_distribution<int> distribution(
+                                            0, static_cast<int>(num_keys) - 1);
+    std::vector<int> keys(size);
+    for (auto& key : keys)
+        key = distribution(engine);
+
+    std::vector<size_t> expected(size), order(size);
+    std::iota(expected.begin(), expected.end(), size_t(0));
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+    std::vector<size_t> counts(num_keys), expected_counts(num_keys);
+    std::vector<size_t> offsets(num_keys + 1);
+    for (auto key : keys)
+        expected_counts[key]++;
+
+    xlib::parallel_counting_sort(size, num_keys,
+                                 [&](size_t i) { return keys[i]; },
+                                 [&](size_t i, size_t pos) { order[pos] = i; },
+                                 counts.data(), offsets.data(), num_threads);
+    bool offsets_ok = offsets[0] == 0;
+    for (size_t k = 0; k < num_keys; k++)
+        offsets_ok = offsets_ok && offsets[k + 1] - offsets[k] == counts[k];
+    CHECK(order == expected)
+    CHECK(counts == expected_counts)
+    CHECK(offsets_ok)
+}
+
+void reverse_csr() {
+    test::TempFile file("reverse.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "4 4 6\n"
+                        "1 2\n1 3\n2 3\n3 1\n4 3\n4 1\n");
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(file.path(), SORT);
+    auto offsets = graph.in_offsets_ptr();
+    auto   edges = graph.in_edges_ptr();
+    const auto& in_adjacency = [&](vid_t v) {
+                                return adj_t(edges + offsets[v],
+                                             edges + offsets[v + 1]);
+                            };
+    CHECK(in_adjacency(0) == adj_t({ 2, 3 }))
+    CHECK(in_adjacency(1) == adj_t({ 0 }))
+    CHECK(in_adjacency(2) == adj_t({ 0, 1, 3 }))
+    CHECK(in_adjacency(3) == adj_t())
+}
+
+/**
+ * @brief The in-place construction (LOW_MEMORY) gives the same sorted CSR
+ *        and reverse CSR as the default one. Large enough for the parallel
+ *        partition of the edges
+ */
+void low_memory() {
+    const int nV = 50000, nE = 200000;
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> distribution(1, nV);
+    std::ostringstream content;
+    content << "%%MatrixMarket matrix coordinate pattern general\n"
+            << nV << " " << nV << " " << nE << "\n";
+    for (int i = 0; i < nE; i++)
+        content << distribution(engine) << " " << distribution(engine) << "\n";
+    test::TempFile file("low_memory.mtx", content.str());
+
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE),
+                                   packed(DIRECTED | REVERSE);
+    graph.read(file.path(), SORT);
+    packed.read(file.path(), SORT | LOW_MEMORY);
+    CHECK_EQ(packed.nE(), nE)
+    CHECK(std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + nV + 1,
+                     packed.out_offsets_ptr()))
+    CHECK(std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                     packed.out_edges_ptr()))
+    CHECK(std::equal(graph.in_offsets_ptr(), graph.in_offsets_ptr() + nV + 1,
+                     packed.in_offsets_ptr()))
+    CHECK(std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                     packed.in_edges_ptr()))
+}
+
+///@brief profile() counts the in-degrees with and without the reverse CSR
+void profile_in_degrees() {
+    test::TempFile file("profile.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "4 4 5\n"
+                        "1 3\n2 3\n4 3\n3 1\n1 2\n");
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED), reverse(DIRECTED | REVERSE);
+    graph.read(file.path());
+    reverse.read(file.path());
+    for (const auto& profile : { graph.profile(), reverse.profile() }) {
+        CHECK_EQ(profile.max_in_degree, 3u)
+        CHECK_EQ(profile.in_degree_0, 1u)
+        CHECK_EQ(profile.in_degree_1, 2u)
+    }
+}
+
+/**
+ * @brief Out-of-core construction with the minimum edge buffers: several
+ *        sorted runs are spilled and merged. The binary file, read with
+ *        MMAP, matches the in-memory (sorted) CSR. Both ignore the entries
+ *        beyond the count of the header
+ */
+void external_csr(bool symmetric) {
+    const int nV = 3000, nE = 20000;
+    std::mt19937 engine(symmetric ? 11 : 13);
+    std::uniform_int_distribution<int> distribution(1, nV);
+    std::ostringstream content;
+    content << "%%MatrixMarket matrix coordinate pattern "
+            << (symmetric ? "symmetric" : "general") << "\n"
+            << nV << " " << nV << " " << nE << "\n";
+    for (int i = 0; i < nE; i++)
+        content << distribution(engine) << " " << distribution(engine) << "\n";
+    content << "1 2\n2 3\n";
+    test::TempFile file("external.mtx", content.str());
+    test::TempFile binary("external.bin", "");
+    graph::buildBinaryExternal<vid_t, eoff_t>(file.path(), binary.path(), 1,
+                                              true, "", false);
+
+    auto structure = symmetric ? graph::StructureProp(UNDIRECTED)
+                               : DIRECTED | REVERSE;
+    graph::GraphStd<vid_t, eoff_t> graph(structure), external(structure);
+    graph.read(file.path(), SORT);
+    external.read(binary.path(), SORT | MMAP);
+    CHECK_EQ(external.nV(), graph.nV())
+    CHECK_EQ(external.nE(), graph.nE())
+    if (external.nV() != graph.nV() || external.nE() != graph.nE())
+        return;
+    auto V = graph.nV();
+    auto E = graph.nE();
+    CHECK(std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + V + 1,
+                     external.out_offsets_ptr()))
+    CHECK(std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + E,
+                     external.out_edges_ptr()))
+    CHECK(std::equal(graph.in_offsets_ptr(), graph.in_offsets_ptr() + V + 1,
+                     external.in_offsets_ptr()))
+    CHECK(std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + E,
+                     external.in_edges_ptr()))
+}
+
+int main() {
+    counting_sort(100000, 16,    4, false);
+    counting_sort(100000, 60000, 4, true);
+    counting_sort(20000,  50000, 3, true);      //many empty keys
+    counting_sort(50000,  3,     8, false);
+    reverse_csr();
+    low_memory();
+    profile_in_degrees();
+    external_csr(false);
+    external_csr(true);
+    return test::failures();
+}
@@ -0,0 +1,359 @@
+#include "GraphIO/GraphStd.hpp"
+#include "TestUtil.hpp"
+#include <algorithm>                //std::equal
+#include <cstdio>                   //std::remove
+#include <dirent.h>                 //::opendir, ::readdir
+#include <fcntl.h>                  //AT_FDCWD
+#include <fstream>                  //std::ofstream
+#include <limits>                   //std::numeric_limits
+#include <sstream>                  //std::ostringstream
+#include <string>                   //std::string
+#include <sys/stat.h>               //::utimensat
+#include <unistd.h>                 //::rmdir
+#include <utility>                  //std::pair
+#include <vector>                   //std::vector
+
+using namespace graph::structure_prop;
+using namespace graph::parsing_prop;
+
+using vid_t  = int;
+using eoff_t = int;
+using adj_t  = std::vector<vid_t>;
+
+//------------------------------------------------------------------------------
+
+void market_directed() {
+    test::TempFile file("directed.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "% comment\n"
+                        "4 4 5\n"
+                        "1 2\n2 3\n1 3\n4 1\n3 4");     //no final newline
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED);
+    graph.read(file.path(), SORT);
+    CHECK_EQ(graph.nV(), 4)
+    CHECK_EQ(graph.nE(), 5)
+    CHECK(test::adjacency(graph, 0) == adj_t({ 1, 2 }))
+    CHECK(test::adjacency(graph, 1) == adj_t({ 2 }))
+    CHECK(test::adjacency(graph, 2) == adj_t({ 3 }))
+    CHECK(test::adjacency(graph, 3) == adj_t({ 0 }))
+}
+
+void market_symmetric() {
+    test::TempFile file("symmetric.mtx",
+                        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                        "3 3 2\n"
+                        "2 1\n3 2\n");
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(file.path(), SORT);
+    CHECK(graph.is_undirected())
+    CHECK_EQ(graph.nE(), 4)
+    CHECK(test::adjacency(graph, 0) == adj_t({ 1 }))
+    CHECK(test::adjacency(graph, 1) == adj_t({ 0, 2 }))
+    CHECK(test::adjacency(graph, 2) == adj_t({ 1 }))
+}
+
+/**
+ * @brief Large enough to be split in several chunks: the parallel, the
+ *        memory-mapped and the pipelined parsers keep the file order of the
+ *        edges
+ */
+void market_chunks() {
+    const int nV = 1000, degree = 50;
+    std::ostringstream content;
+    content << "%%MatrixMarket matrix coordinate pattern general\n"
+            << nV << " " << nV << " " << nV * degree << "\n";
+    for (int i = 0; i < nV; i++) {
+        for (int j = 0; j < degree; j++)
+            content << i + 1 << " " << (i * 7 + j * 13) % nV + 1 << "\n";
+    }
+    test::TempFile file("chunks.mtx", content.str());
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED), mapped(DIRECTED),
+                                   piped(DIRECTED);
+    graph.read(file.path(), graph::ParsingProp());
+    mapped.read(file.path(), MMAP);
+    piped.read(file.path(), MMAP | PIPELINE);
+    CHECK_EQ(graph.nE(), nV * degree)
+    bool ok = true;
+    for (int i = 0; i < nV; i++) {
+        auto adj = test::adjacency(graph, i);
+        ok = ok && adj.size() == degree && adj == test::adjacency(mapped, i) &&
+             adj == test::adjacency(piped, i);
+        for (int j = 0; j < degree && ok; j++)
+            ok = adj[j] == (i * 7 + j * 13) % nV;
+    }
+    CHECK(ok)
+}
+
+/**
+ * @brief Weight and timestamp columns are skipped by the stream and by the
+ *        memory-mapped readers
+ */
+void konect_extra_columns() {
+    test::TempFile file("out.konect",
+                        "% asym positive\n"
+                        "% 4 3 3\n"
+                        "1 2 5 1200000000\n"
+                        "2 3 1 1200000001\n"
+                        "3 1 7 1200000002\n"
+                        "1 3 2 1200000003\n");
+    for (const auto& prop : { graph::ParsingProp(SORT), SORT | MMAP }) {
+        graph::GraphStd<vid_t, eoff_t> graph;
+        graph.read(file.path(), prop);
+        CHECK(graph.is_directed())
+        CHECK_EQ(graph.nV(), 3)
+        CHECK_EQ(graph.nE(), 4)
+        CHECK(test::adjacency(graph, 0) == adj_t({ 1, 2 }))
+        CHECK(test::adjacency(graph, 1) == adj_t({ 2 }))
+        CHECK(test::adjacency(graph, 2) == adj_t({ 0 }))
+    }
+}
+
+/**
+ * @brief Comma-separated Network Repository edges, the ids are relabeled in
+ *        ascending order by the stream and by the memory-mapped readers
+ */
+void netrepo_relabel() {
+    test::TempFile file("netrepo.edges",
+                        "% directed\n"
+                        "10,20\n20,30\n30,10\n40,10\n");
+    for (const auto& prop : { graph::ParsingProp(SORT), SORT | MMAP }) {
+        graph::GraphStd<vid_t, eoff_t> graph;
+        graph.read(file.path(), prop);
+        CHECK(graph.is_directed())
+        CHECK_EQ(graph.nV(), 4)
+        CHECK_EQ(graph.nE(), 4)
+        CHECK(test::adjacency(graph, 0) == adj_t({ 1 }))
+        CHECK(test::adjacency(graph, 1) == adj_t({ 2 }))
+        CHECK(test::adjacency(graph, 2) == adj_t({ 0 }))
+        CHECK(test::adjacency(graph, 3) == adj_t({ 0 }))
+    }
+}
+
+///@brief missing ids of unsigned relabeled graphs are IdMap::NOT_FOUND
+void unsigned_id_map() {
+    test::TempFile file("unsigned.edges", "% directed\n10,20\n20,30\n");
+    graph::GraphStd<unsigned, int64_t> graph;
+    graph.read(file.path(), SORT);
+    using id_map_t = graph::IdMap<unsigned>;
+    CHECK_EQ(graph.id_map().relabeled_id(20), 1u)
+    CHECK_EQ(graph.id_map().relabeled_id(40), id_map_t::NOT_FOUND)
+    CHECK_EQ(id_map_t::NOT_FOUND, std::numeric_limits<unsigned>::max())
+}
+
+/**
+ * @brief Dimacs10th adjacency lists, one line per vertex (vertex 4 is
+ *        isolated), read by the stream and by the memory-mapped readers
+ */
+void dimacs10_adjacency() {
+    test::TempFile file("adjacency.graph",
+                        "% comment\n"
+                        "4 2\n"
+                        "2 3\n"
+                        "1\n"
+                        "1\n"
+                        "\n");
+    for (const auto& prop : { graph::ParsingProp(SORT), SORT | MMAP }) {
+        graph::GraphStd<vid_t, eoff_t> graph;
+        graph.read(file.path(), prop);
+        CHECK(graph.is_undirected())
+        CHECK_EQ(graph.nV(), 4)
+        CHECK_EQ(graph.nE(), 4)
+        CHECK(test::adjacency(graph, 0) == adj_t({ 1, 2 }))
+        CHECK(test::adjacency(graph, 1) == adj_t({ 0 }))
+        CHECK(test::adjacency(graph, 2) == adj_t({ 0 }))
+        CHECK(test::adjacency(graph, 3) == adj_t())
+    }
+}
+
+/**
+ * @brief Sectioned binary format (v2) with checksums: the out-CSR, the
+ *        reverse CSR (loaded on first access) and the original SNAP ids are
+ *        restored by the copying and by the zero-copy (MMAP) readers
+ */
+void binary_round_trip() {
+    test::TempFile file("round_trip.txt",
+                        "# Directed graph\n"
+                        "# Nodes: 4 Edges: 5\n"
+                        "# FromNodeId\tToNodeId\n"
+                        "70\t30\n30\t90\n70\t90\n90\t10\n10\t70\n");
+    test::TempFile binary("round_trip.bin", "");
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(file.path(), SORT);
+    graph.writeBinary(binary.path(), false, true);
+
+    const auto& equal = [](const vid_t* a, const vid_t* b, int size) {
+                            return std::equal(a, a + size, b);
+                        };
+    for (const auto& prop : { graph::ParsingProp(),
+                              graph::ParsingProp(MMAP) }) {
+        graph::GraphStd<vid_t, eoff_t> loaded;
+        loaded.read(binary.path(), prop);
+        CHECK(loaded.is_directed())
+        CHECK_EQ(loaded.nV(), 4)
+        CHECK_EQ(loaded.nE(), 5)
+        CHECK(equal(loaded.out_offsets_ptr(), graph.out_offsets_ptr(), 5))
+        CHECK(equal(loaded.out_edges_ptr(), graph.out_edges_ptr(), 5))
+        CHECK(equal(loaded.in_offsets_ptr(), graph.in_offsets_ptr(), 5))
+        CHECK(equal(loaded.in_edges_ptr(), graph.in_edges_ptr(), 5))
+        CHECK(equal(loaded.in_degrees_ptr(), graph.in_degrees_ptr(), 4))
+
+        CHECK_EQ(loaded.id_map().size(), 4u)
+        CHECK(equal(loaded.id_map().original_ids(),
+                    graph.id_map().original_ids(), 4))
+        for (vid_t original : { 10, 30, 70, 90 }) {
+            CHECK_EQ(loaded.id_map().relabeled_id(original),
+                     graph.id_map().relabeled_id(original))
+        }
+        CHECK_EQ(loaded.id_map().relabeled_id(20),
+                 graph::IdMap<vid_t>::NOT_FOUND)
+    }
+}
+
+/**
+ * @brief Cache files of `name` in `directory`
+ */
+std::vector<std::string> cache_files(const std::string& directory,
+                                     const std::string& name) {
+    std::vector<std::string> files;
+    auto dir = ::opendir(directory.c_str());
+    if (dir == nullptr)
+        return files;
+    while (auto entry = ::readdir(dir)) {
+        std::string file(entry->d_name);
+        if (file.compare(0, name.size() + 1, name + ".") == 0 &&
+                file.size() > 4 && file.substr(file.size() - 4) == ".bin")
+            files.push_back(directory + "/" + file);
+    }
+    ::closedir(dir);
+    return files;
+}
+
+/**
+ * @brief Binary cache of text inputs (CACHE): the cold read writes the
+ *        cache file in cache_directory(), the next read is served from it
+ *        and a change of size or modification time of the text file
+ *        rebuilds it
+ * @details the text file is rewritten with different edges and the same
+ *          size and modification time: the graph still matches the cached
+ *          edges only if the read is served from the cache
+ */
+void binary_cache() {
+    char dir_template[] = "/tmp/graphio_test_cacheXXXXXX";
+    std::string directory(::mkdtemp(dir_template));
+    graph::set_cache_directory(directory);
+
+    const char header[] = "%%MatrixMarket matrix coordinate pattern general\n"
+                          "3 3 2\n";
+    test::TempFile file("cache.mtx", std::string(header) + "1 2\n2 3\n");
+    std::string path(file.path());
+    auto name = path.substr(path.find_last_of('/') + 1);
+
+    const auto& rewrite = [&](const std::string& body, long mtime) {
+                              std::ofstream(file.path()) << header << body;
+                              struct timespec times[2] = { { mtime, 0 },
+                                                           { mtime, 0 } };
+                              ::utimensat(AT_FDCWD, file.path(), times, 0);
+                          };
+    const auto& read = [&]() {
+                           graph::GraphStd<vid_t, eoff_t> graph(DIRECTED);
+                           graph.read(file.path(), SORT | CACHE);
+                           return std::vector<adj_t>{
+                                            test::adjacency(graph, 0),
+                                            test::adjacency(graph, 1),
+                                            test::adjacency(graph, 2) };
+                       };
+    rewrite("1 2\n2 3\n", 1000000);
+    //cold read: the cache file is written in the cache directory only
+    CHECK(read() == std::vector<adj_t>({ { 1 }, { 2 }, {} }))
+    CHECK_EQ(cache_files(directory, name).size(), 1u)
+    auto input_dir = path.substr(0, path.find_last_of('/'));
+    CHECK(cache_files(input_dir, name).empty())
+
+    //same size and modification time: served from the cache
+    rewrite("3 1\n2 1\n", 1000000);
+    CHECK(read() == std::vector<adj_t>({ { 1 }, { 2 }, {} }))
+
+    //modification time changed: parsed again
+    rewrite("3 1\n2 1\n", 2000000);
+    CHECK(read() == std::vector<adj_t>({ {}, { 0 }, { 0 } }))
+    CHECK(read() == std::vector<adj_t>({ {}, { 0 }, { 0 } }))
+
+    //size changed, same modification time: parsed again
+    rewrite("1 3\n2 1\n\n", 2000000);
+    CHECK(read() == std::vector<adj_t>({ { 2 }, { 0 }, {} }))
+
+    for (const auto& cache : cache_files(directory, name))
+        std::remove(cache.c_str());
+    ::rmdir(directory.c_str());
+    graph::set_cache_directory("");
+}
+
+template<typename G>
+bool equal_csr(const G& a, const G& b) {
+    return a.nV() == b.nV() && a.nE() == b.nE() &&
+           std::equal(a.out_offsets_ptr(), a.out_offsets_ptr() + a.nV() + 1,
+                      b.out_offsets_ptr()) &&
+           std::equal(a.out_edges_ptr(), a.out_edges_ptr() + a.nE(),
+                      b.out_edges_ptr());
+}
+
+/**
+ * @brief The parallel Market and Dimacs10th writers: the file read back
+ *        gives the same CSR, isolated vertices included (the first and the
+ *        last vertex of the small graph) and a hub whose list is written in
+ *        several pieces
+ */
+void write_round_trip(const graph::GraphStd<vid_t, eoff_t>& graph) {
+    test::TempFile market("round_trip_out.mtx", "");
+    test::TempFile dimacs10("round_trip_out.graph", "");
+    graph.writeMarket(market.path(), false);
+    graph.writeDimacs10th(dimacs10.path(), false);
+
+    graph::GraphStd<vid_t, eoff_t> from_market(DIRECTED),
+                                   from_dimacs10(DIRECTED);
+    from_market.read(market.path(), SORT);
+    from_dimacs10.read(dimacs10.path(), SORT);
+    CHECK(equal_csr(from_market, graph))
+    CHECK(equal_csr(from_dimacs10, graph))
+}
+
+void write_round_trip() {
+    test::TempFile file("isolated.mtx",
+                        "%%MatrixMarket matrix coordinate pattern general\n"
+                        "5 5 4\n"
+                        "2 3\n3 2\n2 4\n4 4\n");
+    graph::GraphStd<vid_t, eoff_t> small(DIRECTED), generated(DIRECTED);
+    small.read(file.path(), SORT);
+    CHECK_EQ(small.out_degree(0), 0)
+    CHECK_EQ(small.out_degree(4), 0)
+    write_round_trip(small);
+
+    generated.generate(graph::generator::rmat(14, 8),
+                       graph::ParsingProp(SORT));
+    write_round_trip(generated);
+
+    const int nV = 20000;
+    std::ostringstream content;
+    content << "%%MatrixMarket matrix coordinate pattern general\n"
+            << nV << " " << nV << " " << nV - 1 << "\n";
+    for (int i = 2; i <= nV; i++)
+        content << "1 " << i << "\n";
+    test::TempFile star_file("star.mtx", content.str());
+    graph::GraphStd<vid_t, eoff_t> star(DIRECTED);
+    star.read(star_file.path(), SORT);
+    write_round_trip(star);
+}
+
+int main() {
+    market_directed();
+    market_symmetric();
+    market_chunks();
+    konect_extra_columns();
+    netrepo_relabel();
+    unsigned_id_map();
+    dimacs10_adjacency();
+    binary_round_trip();
+    binary_cache();
+    write_round_trip();
+    return test::failures();
+}
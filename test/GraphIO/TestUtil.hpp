@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdio>                   //std::remove
+#include <fstream>                  //std::ofstream
+#include <iostream>                 //std::cerr
+#include <string>                   //std::string
+#include <unistd.h>                 //getpid
+#include <vector>                   //std::vector
+
+/**
+ * @brief Minimal regression-test support for the GraphIO tests (run by
+ *        CTest): CHECK() records a failure and continues, the test main
+ *        returns test::failures()
+ */
+namespace test {
+
+inline int& failures() noexcept {
+    static int count = 0;
+    return count;
+}
+
+/**
+ * @brief Small input fixture written to the temporary directory. The file
+ *        is removed by the destructor
+ */
+class TempFile {
+public:
+    TempFile(const std::string& name, const std::string& content) :
+            _path(std::string("/tmp/graphio_test_") +
+                  std::to_string(getpid()) + "_" + name) {
+        std::ofstream fout(_path);
+        fout << content;
+    }
+
+    ~TempFile() { std::remove(_path.c_str()); }
+
+    const char* path() const noexcept { return _path.c_str(); }
+private:
+    std::string _path;
+};
+
+///@brief CSR adjacency list of `vertex` as a vector
+template<typename G, typename vid_t>
+std::vector<vid_t> adjacency(const G& graph, vid_t vertex) {
+    auto offsets = graph.out_offsets_ptr();
+    auto   edges = graph.out_edges_ptr();
+    return std::vector<vid_t>(edges + offsets[vertex],
+                              edges + offsets[vertex + 1]);
+}
+
+} // namespace test
+
+#define CHECK(condition) {                                                     \
+    if (!(condition)) {                                                        \
+        std::cerr << __FILE__ << "(" << __LINE__ << ") [ " << __func__         \
+                  << " ]: CHECK(" #condition ") failed" << std::endl;          \
+        test::failures()++;                                                    \
+    }                                                                          \
+}
+
+#define CHECK_EQ(value, expected) {                                            \
+    if (!((value) == (expected))) {                                            \
+        std::cerr << __FILE__ << "(" << __LINE__ << ") [ " << __func__         \
+                  << " ]: " #value " == " << (value) << ", expected "          \
+                  << (expected) << std::endl;                                  \
+        test::failures()++;                                                    \
+    }                                                                          \
+}
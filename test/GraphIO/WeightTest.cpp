@@ -0,0 +1,134 @@
+#include "GraphIO/Dijkstra.hpp"
+#include "GraphIO/GraphWeight.hpp"
+#include "TestUtil.hpp"
+#include <algorithm>                //std::equal
+#include <vector>                   //std::vector
+
+using namespace graph::structure_prop;
+using namespace graph::parsing_prop;
+
+using vid_t    = int;
+using eoff_t   = int;
+using weight_t = int;
+using wgraph_t = graph::GraphWeight<vid_t, eoff_t, weight_t>;
+
+//------------------------------------------------------------------------------
+
+template<graph::DijkstraQueue queue_t>
+std::vector<weight_t> distances(const wgraph_t& graph, vid_t source) {
+    graph::Dijkstra<vid_t, eoff_t, weight_t, queue_t> dijkstra(graph);
+    dijkstra.run(source);
+    return std::vector<weight_t>(dijkstra.result(),
+                                 dijkstra.result() + graph.nV());
+}
+
+/**
+ * @brief The filename constructors run the weighted readers: the weights
+ *        are stored and Dijkstra can run on the graph
+ */
+void dimacs9_constructor() {
+    test::TempFile file("weights.gr",
+                        "c comment\n"
+                        "p sp 4 8\n"
+                        "a 1 2 4\na 2 1 4\n"
+                        "a 1 3 1\na 3 1 1\n"
+                        "a 3 2 2\na 2 3 2\n"
+                        "a 2 4 5\na 4 2 5\n");
+    wgraph_t graph(file.path(), SORT);
+    CHECK_EQ(graph.nV(), 4)
+    CHECK_EQ(graph.nE(), 8)
+    CHECK(graph.out_weights_array() != nullptr)
+    if (graph.out_weights_array() == nullptr)
+        return;
+    CHECK(test::adjacency(graph, 0) == std::vector<vid_t>({ 1, 2 }))
+    CHECK_EQ(graph.out_weights_array()[0], 4)
+    CHECK_EQ(graph.out_weights_array()[1], 1)
+
+    const std::vector<weight_t> expected { 0, 3, 1, 8 };
+    CHECK(distances<graph::DijkstraQueue::SET>(graph, 0) == expected)
+    CHECK(distances<graph::DijkstraQueue::INDEXED_HEAP>(graph, 0) == expected)
+    CHECK(distances<graph::DijkstraQueue::RADIX_HEAP>(graph, 0) == expected)
+    CHECK(distances<graph::DijkstraQueue::LAZY_HEAP>(graph, 0) == expected)
+}
+
+void market_constructor() {
+    test::TempFile file("weights.mtx",
+                        "%%MatrixMarket matrix coordinate integer general\n"
+                        "3 3 3\n"
+                        "1 2 7\n2 3 3\n1 3 20\n");
+    wgraph_t graph(DIRECTED, file.path(), SORT);
+    CHECK(graph.is_directed())
+    CHECK_EQ(graph.nE(), 3)
+    CHECK(graph.out_weights_array() != nullptr)
+    if (graph.out_weights_array() == nullptr)
+        return;
+    const std::vector<weight_t> expected { 0, 7, 10 };
+    CHECK(distances<graph::DijkstraQueue::INDEXED_HEAP>(graph, 0) == expected)
+}
+
+/**
+ * @brief Weighted Dimacs10th adjacency lists (`fmt` 1) read by the stream
+ *        and by the memory-mapped readers
+ */
+void dimacs10_weights() {
+    test::TempFile file("weights.graph",
+                        "3 2 1\n"
+                        "2 4 3 9\n"
+                        "1 4\n"
+                        "1 9\n");
+    for (const auto& prop : { graph::ParsingProp(SORT), SORT | MMAP }) {
+        wgraph_t graph;
+        graph.read(file.path(), prop);
+        CHECK_EQ(graph.nE(), 4)
+        CHECK(graph.out_weights_array() != nullptr)
+        if (graph.out_weights_array() == nullptr)
+            return;
+        CHECK(test::adjacency(graph, 0) == std::vector<vid_t>({ 1, 2 }))
+        const std::vector<weight_t> expected { 0, 4, 9 };
+        CHECK(distances<graph::DijkstraQueue::INDEXED_HEAP>(graph, 0) ==
+              expected)
+    }
+}
+
+/**
+ * @brief OUT_WEIGHTS and IN_WEIGHTS sections of the binary format (v2) are
+ *        restored by the copying and by the zero-copy (MMAP) readers
+ */
+void binary_weights() {
+    test::TempFile file("binary_weights.mtx",
+                        "%%MatrixMarket matrix coordinate integer general\n"
+                        "3 3 4\n"
+                        "1 2 7\n2 3 3\n1 3 20\n3 1 5\n");
+    test::TempFile binary("binary_weights.bin", "");
+    wgraph_t graph(DIRECTED | REVERSE, file.path(), SORT);
+    graph.writeBinary(binary.path(), false, true);
+
+    for (const auto& prop : { graph::ParsingProp(),
+                              graph::ParsingProp(MMAP) }) {
+        wgraph_t loaded;
+        loaded.read(binary.path(), prop);
+        CHECK(loaded.out_weights_array() != nullptr)
+        CHECK(loaded.in_weights_array() != nullptr)
+        if (loaded.out_weights_array() == nullptr ||
+                loaded.in_weights_array() == nullptr) {
+            return;
+        }
+        CHECK(std::equal(graph.out_weights_array(),
+                         graph.out_weights_array() + 4,
+                         loaded.out_weights_array()))
+        CHECK(std::equal(graph.in_weights_array(),
+                         graph.in_weights_array() + 4,
+                         loaded.in_weights_array()))
+        const std::vector<weight_t> expected { 0, 7, 10 };
+        CHECK(distances<graph::DijkstraQueue::INDEXED_HEAP>(loaded, 0) ==
+              expected)
+    }
+}
+
+int main() {
+    dimacs9_constructor();
+    market_constructor();
+    dimacs10_weights();
+    binary_weights();
+    return test::failures();
+}
@@ -0,0 +1,1041 @@
+#include "GraphIO/GraphCompressed.hpp"
+#include "GraphIO/BFS.hpp"
+#include "GraphIO/Dijkstra.hpp"
+#include "GraphIO/ExternalCSR.hpp"
+#include "GraphIO/GraphStd.hpp"
+#include "GraphIO/SCC.hpp"
+#include "GraphIO/WCC.hpp"
+#include "Host/Algorithm.hpp"       //xlib::parallel_counting_sort
+#include "Host/Numeric.hpp"         //xlib::ceil_log2
+#include "Host/Basic.hpp"           //ERROR
+#include "Host/FileUtil.hpp"        //xlib::skip_lines
+#include "Host/Timer.hpp"           //timer::Timer
+#include <algorithm>                //std::equal, std::sort
+#include <cmath>                    //std::abs
+#include <cstdint>                  //uint64_t
+#include <cstdio>                   //std::remove
+#include <fstream>                  //std::ifstream
+#include <iomanip>                  //std::setw
+#include <iostream>                 //std::cout
+#include <limits>                   //std::numeric_limits
+#include <numeric>                  //std::partial_sum, std::iota
+#include <utility>                  //std::pair
+#include <vector>                   //std::vector
+
+using namespace timer;
+using namespace graph::structure_prop;
+using namespace graph::parsing_prop;
+
+using vid_t  = int;
+using eoff_t = int;
+using coo_t  = std::pair<vid_t, vid_t>;
+
+/**
+ * @brief Reference (single-threaded iostream) Market parser
+ */
+std::vector<coo_t> market_iostream(const char* filename) {
+    std::ifstream fin(filename);
+    while (fin.peek() == '%')
+        xlib::skip_lines(fin);
+    size_t rows, columns, num_lines;
+    fin >> rows >> columns >> num_lines;
+    xlib::skip_lines(fin);
+
+    std::vector<coo_t> coo_edges(num_lines);
+    for (size_t lines = 0; lines < num_lines; lines++) {
+        vid_t index1, index2;
+        fin >> index1 >> index2;
+        coo_edges[lines] = { index1 - 1, index2 - 1 };
+        xlib::skip_lines(fin);
+    }
+    return coo_edges;
+}
+
+void market_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    TM.start();
+
+    auto reference = market_iostream(filename);
+
+    TM.stop();
+    TM.print("Market iostream:  ");
+
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph(COO);
+    graph.read(filename, graph::ParsingProp());
+
+    TM.stop();
+    TM.print("Market parallel:  ");
+
+    auto coo_edges = graph.coo_array();
+    if (!std::equal(reference.begin(), reference.end(), coo_edges))
+        ERROR("Market parallel: wrong COO order")
+    std::cout << "Market parallel: correct\n" << std::endl;
+
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_mmap(COO);
+    graph_mmap.read(filename, MMAP);
+
+    TM.stop();
+    TM.print("Market mmap:      ");
+
+    coo_edges = graph_mmap.coo_array();
+    if (!std::equal(reference.begin(), reference.end(), coo_edges))
+        ERROR("Market mmap: wrong COO order")
+    std::cout << "Market mmap: correct\n" << std::endl;
+}
+
+/**
+ * @brief Serial and parallel reverse CSR construction on the sorted COO of the
+ *        graph. Both results must be byte-identical to the CSR of the graph
+ */
+void csr_benchmark(const char* filename) {
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE | COO);
+    graph.read(filename, SORT);
+    auto nV  = static_cast<size_t>(graph.nV());
+    auto nE  = static_cast<size_t>(graph.nE());
+    auto coo = graph.coo_array();
+
+    const auto& check = [&](const std::vector<eoff_t>& offsets,
+                            const std::vector<vid_t>&  edges,
+                            const char* str) {
+        if (!std::equal(offsets.begin(), offsets.end(),
+                        graph.in_offsets_ptr()) ||
+            !std::equal(edges.begin(), edges.end(), graph.in_edges_ptr())) {
+            ERROR(str, ": wrong reverse CSR")
+        }
+    };
+    std::vector<int>    degrees(nV);
+    std::vector<eoff_t> offsets(nV + 1);
+    std::vector<vid_t>  edges(nE);
+    Timer<HOST> TM(2);
+    TM.start();
+
+    for (size_t i = 0; i < nE; i++)
+        degrees[coo[i].second]++;
+    offsets[0] = 0;
+    std::partial_sum(degrees.begin(), degrees.end(), offsets.begin() + 1);
+    std::vector<int> counters(nV);
+    for (size_t i = 0; i < nE; i++) {
+        auto dest = coo[i].second;
+        edges[offsets[dest] + counters[dest]++] = coo[i].first;
+    }
+
+    TM.stop();
+    TM.print("COO to CSR serial:    ");
+    check(offsets, edges, "COO to CSR serial");
+    std::fill(edges.begin(), edges.end(), 0);
+    TM.start();
+
+    xlib::parallel_counting_sort(nE, nV,
+                                 [&](size_t i) { return coo[i].second; },
+                                 [&](size_t i, eoff_t pos) {
+                                     edges[pos] = coo[i].first;
+                                 }, degrees.data(), offsets.data());
+
+    TM.stop();
+    TM.print("COO to CSR parallel:  ");
+    check(offsets, edges, "COO to CSR parallel");
+    std::cout << "COO to CSR: correct\n" << std::endl;
+}
+
+/**
+ * @brief Comparison sort of (source, destination) pairs against the radix
+ *        sort on packed 64-bit keys
+ */
+void sort_benchmark(const char* filename) {
+    auto coo_edges = market_iostream(filename);
+    vid_t max_id = 0;
+    for (const auto& edge : coo_edges)
+        max_id = std::max(max_id, std::max(edge.first, edge.second));
+    int  bits = max_id > 0 ? xlib::ceil_log2(max_id + 1) : 1;
+    auto size = coo_edges.size();
+
+    std::vector<uint64_t> keys(size);
+    for (size_t i = 0; i < size; i++) {
+        keys[i] = (static_cast<uint64_t>(coo_edges[i].first) << bits) |
+                  static_cast<uint64_t>(coo_edges[i].second);
+    }
+    Timer<HOST> TM(2);
+    TM.start();
+
+    std::sort(coo_edges.begin(), coo_edges.end());
+
+    TM.stop();
+    TM.print("std::sort (pairs):    ");
+    TM.start();
+
+    xlib::parallel_radix_sort(keys.data(), size, 2 * bits);
+
+    TM.stop();
+    TM.print("Radix sort (keys):    ");
+
+    auto mask = (uint64_t(1) << bits) - 1;
+    for (size_t i = 0; i < size; i++) {
+        if (coo_edges[i] != coo_t(static_cast<vid_t>(keys[i] >> bits),
+                                  static_cast<vid_t>(keys[i] & mask)))
+            ERROR("Radix sort: wrong order")
+    }
+    std::cout << "Radix sort: correct\n" << std::endl;
+}
+
+/**
+ * @brief Sequential parse + CSR construction against the pipelined ingestion,
+ *        where the degree counting overlaps with the parsing
+ */
+void pipeline_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, MMAP);
+
+    TM.stop();
+    TM.print("Ingestion sequential: ");
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_pipe(DIRECTED | REVERSE);
+    graph_pipe.read(filename, MMAP | PIPELINE);
+
+    TM.stop();
+    TM.print("Ingestion pipelined:  ");
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    if (!std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + nV + 1,
+                    graph_pipe.out_offsets_ptr()) ||
+        !std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                    graph_pipe.out_edges_ptr()) ||
+        !std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                    graph_pipe.in_edges_ptr())) {
+        ERROR("Pipelined ingestion: wrong graph")
+    }
+    std::cout << "Pipelined ingestion: correct\n" << std::endl;
+}
+
+/**
+ * @brief Binary loading: copy into new arrays against zero-copy (MMAP). The
+ *        reverse CSR sections are loaded only on first access
+ */
+void binary_benchmark(const char* filename) {
+    auto bin_file = xlib::extract_filepath_noextension(filename) + ".bin";
+    {
+        graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+        graph.read(filename, graph::ParsingProp());
+        graph.writeBinary(bin_file, false, true);
+    }
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_copy;
+    graph_copy.read(bin_file.c_str(), graph::ParsingProp());
+
+    TM.stop();
+    TM.print("Binary copy:          ");
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_mmap;
+    graph_mmap.read(bin_file.c_str(), MMAP);
+
+    TM.stop();
+    TM.print("Binary zero-copy:     ");
+    TM.start();
+
+    graph_copy.in_offsets_ptr();
+
+    TM.stop();
+    TM.print("Binary lazy reverse:  ");
+
+    auto nV = graph_copy.nV();
+    auto nE = graph_copy.nE();
+    if (!std::equal(graph_copy.in_offsets_ptr(),
+                    graph_copy.in_offsets_ptr() + nV + 1,
+                    graph_mmap.in_offsets_ptr()) ||
+        !std::equal(graph_copy.in_edges_ptr(), graph_copy.in_edges_ptr() + nE,
+                    graph_mmap.in_edges_ptr()) ||
+        !std::equal(graph_copy.out_degrees_ptr(),
+                    graph_copy.out_degrees_ptr() + nV,
+                    graph_mmap.out_degrees_ptr())) {
+        ERROR("Binary zero-copy: wrong graph")
+    }
+    std::cout << "Binary zero-copy: correct\n" << std::endl;
+}
+
+/**
+ * @brief CSR construction in place of the COO array (LOW_MEMORY) against
+ *        the counting sort: same sorted graph, no second edge array
+ */
+void low_memory_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, SORT);
+
+    TM.stop();
+    TM.print("CSR counting sort:    ");
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_low(DIRECTED | REVERSE);
+    graph_low.read(filename, SORT | LOW_MEMORY);
+
+    TM.stop();
+    TM.print("CSR in-place:         ");
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    //COO, sort keys, out and in edges against the COO only
+    auto peak_bytes = nE * (4 * sizeof(vid_t) + sizeof(uint64_t));
+    std::cout << "Peak edge arrays:     " << (peak_bytes >> 10) << " KB -> "
+              << ((2 * nE * sizeof(vid_t)) >> 10) << " KB" << std::endl;
+    if (static_cast<size_t>(graph_low.nE()) != nE ||
+        !std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + nV + 1,
+                    graph_low.out_offsets_ptr()) ||
+        !std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                    graph_low.out_edges_ptr()) ||
+        !std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                    graph_low.in_edges_ptr())) {
+        ERROR("In-place CSR: wrong graph")
+    }
+    std::cout << "In-place CSR: correct\n" << std::endl;
+}
+
+/**
+ * @brief Reverse CSR built on demand (first access, here by graph::WCC)
+ *        against the one built during the parsing with REVERSE, before and
+ *        after release_reverse()
+ */
+void reverse_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, SORT);
+    graph::GraphStd<vid_t, eoff_t> graph_lazy(DIRECTED);
+    graph_lazy.read(filename, SORT);
+
+    //graph::WCC can run only once
+    graph::WCC<vid_t, eoff_t> wcc(graph_lazy);
+    TM.start();
+
+    wcc.run();
+
+    TM.stop();
+    TM.print("WCC + reverse CSR:    ");
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    if (std::accumulate(wcc.list().begin(), wcc.list().end(), size_t(0)) !=
+            nV) {
+        ERROR("Lazy reverse CSR: wrong WCC")
+    }
+    for (int i = 0; i < 2; i++) {
+        if (!std::equal(graph.in_offsets_ptr(),
+                        graph.in_offsets_ptr() + nV + 1,
+                        graph_lazy.in_offsets_ptr()) ||
+            !std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                        graph_lazy.in_edges_ptr()) ||
+            !std::equal(graph.in_degrees_ptr(),
+                        graph.in_degrees_ptr() + nV,
+                        graph_lazy.in_degrees_ptr())) {
+            ERROR("Lazy reverse CSR: wrong graph")
+        }
+        graph_lazy.release_reverse();
+        graph.release_reverse();
+    }
+    std::cout << "Lazy reverse CSR: correct\n" << std::endl;
+}
+
+/**
+ * @brief 32-bit vertex ids with 64-bit offsets against the all-64-bit
+ *        instantiation: same CSR, smaller edge array. The binary file
+ *        records the mixed class identifier
+ */
+void mixed_width_benchmark(const char* filename) {
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, graph::ParsingProp());
+    graph::GraphStd<int, int64_t> graph_mixed(DIRECTED | REVERSE);
+    graph_mixed.read(filename, graph::ParsingProp());
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    auto bytes64 = 2 * ((nV + 1) * sizeof(int64_t) + nE * sizeof(int64_t));
+    auto bytes32 = 2 * ((nV + 1) * sizeof(int64_t) + nE * sizeof(int));
+    std::cout << "CSR <int64_t, int64_t>: " << (bytes64 >> 10) << " KB\n"
+              << "CSR <int, int64_t>:     " << (bytes32 >> 10) << " KB"
+              << std::endl;
+
+    auto bin_file = xlib::extract_filepath_noextension(filename) +
+                    ".mixed.bin";
+    graph_mixed.writeBinary(bin_file, false);
+    graph::GraphStd<int, int64_t> graph_bin;
+    graph_bin.read(bin_file.c_str(), graph::ParsingProp());
+
+    const auto& equal = [nV, nE](const graph::GraphStd<vid_t, eoff_t>& g1,
+                                 const graph::GraphStd<int, int64_t>& g2) {
+            return static_cast<size_t>(g2.nE()) == nE &&
+                   std::equal(g1.out_offsets_ptr(),
+                              g1.out_offsets_ptr() + nV + 1,
+                              g2.out_offsets_ptr()) &&
+                   std::equal(g1.out_edges_ptr(), g1.out_edges_ptr() + nE,
+                              g2.out_edges_ptr()) &&
+                   std::equal(g1.in_edges_ptr(), g1.in_edges_ptr() + nE,
+                              g2.in_edges_ptr());
+        };
+    if (!equal(graph, graph_mixed) || !equal(graph, graph_bin))
+        ERROR("<int, int64_t> instantiation: wrong graph")
+    std::remove(bin_file.c_str());
+    std::cout << "<int, int64_t> instantiation: correct\n" << std::endl;
+}
+
+/**
+ * @brief In-memory construction against the out-of-core construction with a
+ *        memory budget of a quarter of the COO size
+ */
+void external_benchmark(const char* filename) {
+    auto bin_file = xlib::extract_filepath_noextension(filename) + ".ext.bin";
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, SORT);
+
+    TM.stop();
+    TM.print("CSR in-memory:        ");
+
+    auto nV     = static_cast<size_t>(graph.nV());
+    auto nE     = static_cast<size_t>(graph.nE());
+    auto budget = nE * sizeof(coo_t) / 4;
+    TM.start();
+
+    graph::buildBinaryExternal<vid_t, eoff_t>(filename, bin_file, budget,
+                                              true, "", false);
+
+    TM.stop();
+    TM.print("CSR out-of-core:      ");
+
+    graph::GraphStd<vid_t, eoff_t> graph_ext;
+    graph_ext.read(bin_file.c_str(), MMAP);
+    if (static_cast<size_t>(graph_ext.nE()) != nE ||
+        !std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + nV + 1,
+                    graph_ext.out_offsets_ptr()) ||
+        !std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                    graph_ext.out_edges_ptr()) ||
+        !std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                    graph_ext.in_edges_ptr())) {
+        ERROR("CSR out-of-core: wrong graph")
+    }
+    std::cout << "CSR out-of-core: correct\n" << std::endl;
+}
+
+/**
+ * @brief Two reads with the binary cache (parsing_prop::CACHE). The
+ *        first read builds the cache file (if missing or out of date), the
+ *        second one loads it
+ */
+void cache_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED | REVERSE);
+    graph.read(filename, CACHE);
+
+    TM.stop();
+    TM.print("Cache first read:     ");
+    TM.start();
+
+    graph::GraphStd<vid_t, eoff_t> graph_cache(DIRECTED | REVERSE);
+    graph_cache.read(filename, CACHE);
+
+    TM.stop();
+    TM.print("Cache second read:    ");
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    if (static_cast<size_t>(graph_cache.nE()) != nE ||
+        !std::equal(graph.out_offsets_ptr(), graph.out_offsets_ptr() + nV + 1,
+                    graph_cache.out_offsets_ptr()) ||
+        !std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                    graph_cache.out_edges_ptr()) ||
+        !std::equal(graph.in_edges_ptr(), graph.in_edges_ptr() + nE,
+                    graph_cache.in_edges_ptr())) {
+        ERROR("Binary cache: wrong graph")
+    }
+    std::cout << "Binary cache: correct\n" << std::endl;
+}
+
+/**
+ * @brief Memory footprint and adjacency decoding throughput of the
+ *        gap/varint compressed CSR against the plain CSR
+ */
+void compressed_benchmark(const char* filename) {
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(filename, graph::ParsingProp());
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+
+    Timer<HOST> TM(2);
+    TM.start();
+
+    graph::GraphCompressed<vid_t, eoff_t> compressed(graph);
+
+    TM.stop();
+    TM.print("Compression:          ");
+
+    auto csr_bytes = (nV + 1) * sizeof(eoff_t) + nE * sizeof(vid_t) +
+                     nV * sizeof(int);
+    std::cout << "CSR:        " << (csr_bytes >> 10) << " KB\n"
+              << "Compressed: " << (compressed.memory_bytes() >> 10) << " KB  ("
+              << static_cast<double>(compressed.data_bytes()) / nE
+              << " bytes/edge)" << std::endl;
+
+    uint64_t csr_sum = 0, compressed_sum = 0;
+    TM.start();
+
+    for (size_t i = 0; i < nE; i++)
+        csr_sum += static_cast<uint64_t>(graph.out_edges_ptr()[i]);
+
+    TM.stop();
+    auto csr_time = TM.duration();
+    TM.start();
+
+    for (auto vertex : compressed.V) {
+        for (auto edge : vertex)
+            compressed_sum += static_cast<uint64_t>(edge.dst_id());
+    }
+
+    TM.stop();
+    std::cout << "Decode CSR:           " << nE / (csr_time * 1000.0)
+              << " Medges/s\n"
+              << "Decode compressed:    " << nE / (TM.duration() * 1000.0)
+              << " Medges/s" << std::endl;
+    if (csr_sum != compressed_sum)
+        ERROR("Compressed CSR: wrong adjacency lists")
+    std::cout << "Compressed CSR: correct\n" << std::endl;
+}
+
+/**
+ * @brief In-memory synthetic graphs: generation throughput and
+ *        reproducibility (same parameters and seed, same graph)
+ */
+void generator_benchmark(int scale) {
+    using namespace graph::generator;
+    const graph::GeneratorProp generators[] = {
+        rmat(scale), kronecker(scale), gnp(scale), gnm(scale),
+        chung_lu(scale)
+    };
+    for (const auto& generator : generators) {
+        Timer<HOST> TM(2);
+        TM.start();
+
+        graph::GraphStd<vid_t, eoff_t> graph;
+        graph.generate(generator, graph::ParsingProp());
+
+        TM.stop();
+        std::cout << std::left << std::setw(22) << generator.name()
+                  << std::right;
+        TM.print("");
+
+        graph::GraphStd<vid_t, eoff_t> graph2;
+        graph2.generate(generator, graph::ParsingProp());
+        auto nV = static_cast<size_t>(graph.nV());
+        auto nE = static_cast<size_t>(graph.nE());
+        if (graph2.nE() != graph.nE() ||
+            !std::equal(graph.out_offsets_ptr(),
+                        graph.out_offsets_ptr() + nV + 1,
+                        graph2.out_offsets_ptr()) ||
+            !std::equal(graph.out_edges_ptr(), graph.out_edges_ptr() + nE,
+                        graph2.out_edges_ptr())) {
+            ERROR(generator.name(), ": not reproducible")
+        }
+    }
+    std::cout << "Generators: correct\n" << std::endl;
+}
+
+/**
+ * @brief Parallel profile of a directed graph without the reverse CSR and
+ *        with unsorted adjacency lists (in-degrees and reciprocity computed
+ *        on the fly) against a serial recount
+ */
+void profile_benchmark(const char* filename) {
+    Timer<HOST> TM(2);
+    graph::GraphStd<vid_t, eoff_t> graph(DIRECTED);
+    graph.read(filename, RANDOMIZE);
+    TM.start();
+
+    auto profile = graph.profile();
+
+    TM.stop();
+    TM.print("Profile:              ");
+
+    auto nV = static_cast<size_t>(graph.nV());
+    auto nE = static_cast<size_t>(graph.nE());
+    std::vector<coo_t>    edges;
+    std::vector<uint64_t> in_degrees(nV);
+    uint64_t self_loops = 0, reciprocal = 0, max_in_degree = 0;
+    for (size_t u = 0; u < nV; u++) {
+        for (auto i = graph.out_offsets_ptr()[u];
+             i < graph.out_offsets_ptr()[u + 1]; i++) {
+            auto v = graph.out_edges_ptr()[i];
+            edges.push_back(coo_t(static_cast<vid_t>(u), v));
+            in_degrees[v]++;
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (const auto& edge : edges) {
+        if (edge.first == edge.second)
+            self_loops++;
+        else if (std::binary_search(edges.begin(), edges.end(),
+                                    coo_t(edge.second, edge.first))) {
+            reciprocal++;
+        }
+    }
+    for (auto degree : in_degrees)
+        max_in_degree = std::max(max_in_degree, degree);
+    auto vertices = std::accumulate(profile.out_vertices,
+                                    profile.out_vertices +
+                                    graph::GraphProfile::NUM_BUCKETS,
+                                    profile.out_degree_0);
+    auto histogram_edges = std::accumulate(profile.out_edges,
+                                           profile.out_edges +
+                                           graph::GraphProfile::NUM_BUCKETS,
+                                           uint64_t(0));
+    if (profile.self_loops != self_loops ||
+        profile.reciprocal_edges != reciprocal ||
+        profile.max_in_degree != max_in_degree || vertices != nV ||
+        histogram_edges != nE || profile.gini < 0.0 || profile.gini > 1.0) {
+        ERROR("Profile: wrong statistics")
+    }
+    std::cout << "Profile: correct\n" << std::endl;
+}
+
+/**
+ * @brief Pull PageRank (fixed number of iterations) over the incoming
+ *        edges: the kernel whose gathers are most sensitive to the
+ *        vertex order
+ */
+double pagerank(const graph::GraphStd<vid_t, eoff_t>& graph) {
+    const int    ITERATIONS = 20;
+    const double DAMPING    = 0.85;
+    auto nV = static_cast<size_t>(graph.nV());
+    std::vector<double> rank(nV, 1.0 / nV), contribution(nV);
+    for (int i = 0; i < ITERATIONS; i++) {
+        for (size_t v = 0; v < nV; v++) {
+            auto degree = graph.out_degrees_ptr()[v];
+            contribution[v] = degree == 0 ? 0.0 : rank[v] / degree;
+        }
+        for (size_t v = 0; v < nV; v++) {
+            double sum = 0.0;
+            for (auto j = graph.in_offsets_ptr()[v];
+                 j < graph.in_offsets_ptr()[v + 1]; j++) {
+                sum += contribution[graph.in_edges_ptr()[j]];
+            }
+            rank[v] = (1.0 - DAMPING) / nV + DAMPING * sum;
+        }
+    }
+    return std::accumulate(rank.begin(), rank.end(), 0.0);
+}
+
+/**
+ * @brief Top-down against direction-optimizing BFS from the highest-degree
+ *        vertex: same distances, fewer examined edges on low-diameter graphs
+ */
+void bfs_benchmark(const graph::GraphStd<vid_t, eoff_t>& graph,
+                   const char* name) {
+    using Mode = graph::BFS<vid_t, eoff_t>::Mode;
+    auto source = graph.max_out_degree_id();
+    auto     nV = static_cast<size_t>(graph.nV());
+    graph::BFS<vid_t, eoff_t> top_down(graph);
+    graph::BFS<vid_t, eoff_t> hybrid(graph, Mode::DIRECTION_OPTIMIZING);
+    hybrid.run(source);     //builds the reverse CSR of directed graphs
+    hybrid.reset();
+    Timer<HOST> TM(2);
+    TM.start();
+
+    top_down.run(source);
+
+    TM.stop();
+    auto top_down_time = TM.duration();
+    TM.start();
+
+    hybrid.run(source);
+
+    TM.stop();
+    std::cout << name << std::fixed << std::setprecision(2)
+              << "\n  top-down:             " << std::setw(8)
+              << top_down_time << " ms  " << std::setw(12)
+              << top_down.visited_edges() << " edges"
+              << "\n  direction-optimizing: " << std::setw(8)
+              << TM.duration() << " ms  " << std::setw(12)
+              << hybrid.visited_edges() << " edges" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    if (hybrid.visited_nodes() != top_down.visited_nodes() ||
+        !std::equal(top_down.result(), top_down.result() + nV,
+                    hybrid.result())) {
+        ERROR("Direction-optimizing BFS: wrong distances")
+    }
+    std::cout << "Direction-optimizing BFS: correct\n" << std::endl;
+}
+
+/**
+ * @brief Thread scaling of the parallel BFS (both modes, up to
+ *        xlib::num_threads() threads): distances identical to the serial
+ *        top-down BFS
+ */
+void parallel_bfs_benchmark(const graph::GraphStd<vid_t, eoff_t>& graph,
+                            const char* name) {
+    using Mode = graph::BFS<vid_t, eoff_t>::Mode;
+    const char* mode_names[] = { "top-down", "direction-optimizing" };
+    auto source = graph.max_out_degree_id();
+    auto     nV = static_cast<size_t>(graph.nV());
+    graph::BFS<vid_t, eoff_t> serial(graph);
+    serial.run(source);
+    Timer<HOST> TM(2);
+    std::cout << name << std::fixed << std::setprecision(2) << "\n";
+
+    for (auto mode : { Mode::TOP_DOWN, Mode::DIRECTION_OPTIMIZING }) {
+        std::cout << "  " << mode_names[static_cast<int>(mode)] << ":\n";
+        for (int num_threads = 1; num_threads <= xlib::num_threads();
+             num_threads *= 2) {
+            graph::BFS<vid_t, eoff_t> bfs(graph, mode, num_threads);
+            bfs.run(source);    //builds the reverse CSR of directed graphs
+            bfs.reset();
+            TM.start();
+
+            bfs.run(source);
+
+            TM.stop();
+            std::cout << "    " << std::setw(3) << num_threads
+                      << " threads: " << std::setw(8) << TM.duration()
+                      << " ms" << std::endl;
+            if (bfs.visited_nodes() != serial.visited_nodes() ||
+                !std::equal(serial.result(), serial.result() + nV,
+                            bfs.result())) {
+                ERROR("Parallel BFS: wrong distances (", num_threads,
+                      " threads)")
+            }
+        }
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "Parallel BFS: correct\n" << std::endl;
+}
+
+/**
+ * @brief Multi-source BFS from `num_sources` vertices against one BFS per
+ *        source: same eccentricity, reached vertices and distance sum of
+ *        every source
+ */
+void multi_source_bfs_benchmark(const graph::GraphStd<vid_t, eoff_t>& graph,
+                                const char* name, int num_sources) {
+    std::vector<vid_t> sources(static_cast<size_t>(num_sources));
+    for (size_t i = 0; i < sources.size(); i++) {
+        sources[i] = static_cast<vid_t>((i * 2654435761u) %
+                                         static_cast<size_t>(graph.nV()));
+    }
+    auto nV = static_cast<size_t>(graph.nV());
+    graph::BFS<vid_t, eoff_t> multi_source(graph), single_source(graph);
+    Timer<HOST> TM(2);
+    TM.start();
+
+    multi_source.run(sources.data(), num_sources);
+
+    TM.stop();
+    auto multi_source_time = TM.duration();
+    std::vector<graph::BFS<vid_t, eoff_t>::dist_t> eccentricities(
+                                                           sources.size());
+    std::vector<vid_t> reached(sources.size());
+    std::vector<uint64_t> distance_sums(sources.size());
+    const auto INF = std::numeric_limits<int>::max();
+    TM.start();
+
+    for (size_t i = 0; i < sources.size(); i++) {
+        single_source.reset();
+        single_source.run(sources[i]);
+        auto distances    = single_source.result();
+        eccentricities[i] = 0;
+        reached[i]        = 0;
+        distance_sums[i]  = 0;
+        for (size_t v = 0; v < nV; v++) {
+            if (distances[v] == INF)
+                continue;
+            eccentricities[i] = std::max(eccentricities[i], distances[v]);
+            reached[i]++;
+            distance_sums[i] += static_cast<uint64_t>(distances[v]);
+        }
+    }
+
+    TM.stop();
+    std::cout << name << " (" << num_sources << " sources)" << std::fixed
+              << std::setprecision(2)
+              << "\n  one BFS per source: " << std::setw(10)
+              << TM.duration() << " ms"
+              << "\n  multi-source BFS:   " << std::setw(10)
+              << multi_source_time << " ms" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    if (!std::equal(eccentricities.begin(), eccentricities.end(),
+                    multi_source.eccentricities()) ||
+        !std::equal(reached.begin(), reached.end(),
+                    multi_source.reached_nodes()) ||
+        !std::equal(distance_sums.begin(), distance_sums.end(),
+                    multi_source.distance_sums())) {
+        ERROR("Multi-source BFS: wrong results")
+    }
+    std::cout << "Multi-source BFS: correct\n" << std::endl;
+}
+
+/**
+ * @brief Diameter and radius by bounding eccentricities against the
+ *        multi-source BFS from all vertices (eccentricities of the largest
+ *        component)
+ */
+void diameter_benchmark(const graph::GraphStd<vid_t, eoff_t>& graph,
+                        const char* name) {
+    graph::BFS<vid_t, eoff_t> bfs(graph), all_sources(graph);
+    Timer<HOST> TM(2);
+    TM.start();
+
+    auto diameter = bfs.diameter();
+
+    TM.stop();
+    auto diameter_time = TM.duration();
+    auto diameter_runs = bfs.bfs_runs();
+    TM.start();
+
+    auto radius = bfs.radius();
+
+    TM.stop();
+    std::cout << name << " (" << graph.nV() << " vertices)" << std::fixed
+              << std::setprecision(2)
+              << "\n  diameter: " << std::setw(4) << diameter << std::setw(10)
+              << diameter_time << " ms " << std::setw(6) << diameter_runs
+              << " BFS runs"
+              << "\n  radius:   " << std::setw(4) << radius << std::setw(10)
+              << TM.duration() << " ms " << std::setw(6) << bfs.bfs_runs()
+              << " BFS runs" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+
+    std::vector<vid_t> sources(static_cast<size_t>(graph.nV()));
+    std::iota(sources.begin(), sources.end(), 0);
+    all_sources.run(sources.data(), graph.nV());
+    //largest component: the one of the smallest vertex id on ties
+    auto reached = all_sources.reached_nodes();
+    auto   first = std::max_element(reached, reached + graph.nV()) - reached;
+    graph::BFS<vid_t, eoff_t> component(graph);
+    component.run(static_cast<vid_t>(first));
+    graph::BFS<vid_t, eoff_t>::dist_t max_eccentricity = 0,
+                                      min_eccentricity = graph.nV();
+    for (size_t i = 0; i < sources.size(); i++) {
+        if (component.result()[i] >= graph.nV())
+            continue;
+        auto eccentricity = all_sources.eccentricities()[i];
+        max_eccentricity  = std::max(max_eccentricity, eccentricity);
+        min_eccentricity  = std::min(min_eccentricity, eccentricity);
+    }
+    if (diameter != max_eccentricity || radius != min_eccentricity)
+        ERROR("Bounding eccentricities: wrong diameter or radius")
+    std::cout << "Bounding eccentricities: correct\n" << std::endl;
+}
+
+/**
+ * @brief Dijkstra with every graph::DijkstraQueue from `num_sources`
+ *        vertices: same distances as the std::set queue
+ */
+template<graph::DijkstraQueue queue_t>
+void dijkstra_run(const graph::GraphWeight<vid_t, eoff_t, int>& graph,
+                  const char* queue_name, int num_sources,
+                  std::vector<int>& reference) {
+    auto nV = static_cast<size_t>(graph.nV());
+    graph::Dijkstra<vid_t, eoff_t, int, queue_t> dijkstra(graph);
+    reference.resize(nV * static_cast<size_t>(num_sources));
+    Timer<HOST> TM(2);
+    float total_time = 0;
+    for (int i = 0; i < num_sources; i++) {
+        auto source = static_cast<vid_t>((static_cast<size_t>(i) *
+                                          2654435761u) % nV);
+        dijkstra.reset();
+        TM.start();
+
+        dijkstra.run(source);
+
+        TM.stop();
+        total_time   += TM.duration();
+        auto distances = dijkstra.result();
+        auto  expected = reference.data() + nV * static_cast<size_t>(i);
+        if (queue_t == graph::DijkstraQueue::SET)
+            std::copy(distances, distances + nV, expected);
+        else if (!std::equal(distances, distances + nV, expected))
+            ERROR("Dijkstra (", queue_name, "): wrong distances")
+    }
+    std::cout << "  " << std::left << std::setw(14) << queue_name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << total_time / static_cast<float>(num_sources)
+              << " ms/source" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+void dijkstra_benchmark(const graph::GraphWeight<vid_t, eoff_t, int>& graph,
+                        const char* name, int num_sources) {
+    using graph::DijkstraQueue;
+    std::cout << name << " (" << graph.nV() << " vertices)\n";
+    std::vector<int> reference;
+    dijkstra_run<DijkstraQueue::SET>(graph, "set", num_sources, reference);
+    dijkstra_run<DijkstraQueue::INDEXED_HEAP>(graph, "4-ary heap",
+                                              num_sources, reference);
+    dijkstra_run<DijkstraQueue::RADIX_HEAP>(graph, "radix heap",
+                                            num_sources, reference);
+    dijkstra_run<DijkstraQueue::LAZY_HEAP>(graph, "lazy heap",
+                                           num_sources, reference);
+    std::cout << "Dijkstra queues: correct\n" << std::endl;
+}
+
+/**
+ * @brief `side` x `side` grid with random weights in [1, 1000], both
+ *        directions of each edge (road-network-like: planar, large diameter)
+ */
+void dijkstra_grid_benchmark(vid_t side, int num_sources) {
+    auto nV = static_cast<size_t>(side) * static_cast<size_t>(side);
+    std::vector<eoff_t> offsets(nV + 1, 0);
+    std::vector<vid_t>  edges;
+    std::vector<int>    weights;
+    uint64_t seed = graph::generator::DEFAULT_SEED;
+    const auto& add_edge = [&](size_t dest) {
+            seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+            edges.push_back(static_cast<vid_t>(dest));
+            weights.push_back(static_cast<int>(seed % 1000) + 1);
+        };
+    for (size_t v = 0; v < nV; v++) {
+        auto row = v / static_cast<size_t>(side);
+        auto col = v % static_cast<size_t>(side);
+        if (row > 0)
+            add_edge(v - static_cast<size_t>(side));
+        if (col > 0)
+            add_edge(v - 1);
+        if (col + 1 < static_cast<size_t>(side))
+            add_edge(v + 1);
+        if (row + 1 < static_cast<size_t>(side))
+            add_edge(v + static_cast<size_t>(side));
+        offsets[v + 1] = static_cast<eoff_t>(edges.size());
+    }
+    auto nE = static_cast<eoff_t>(edges.size());
+    graph::GraphWeight<vid_t, eoff_t, int> grid(offsets.data(),
+                                                static_cast<vid_t>(nV),
+                                                edges.data(), nE,
+                                                weights.data());
+    dijkstra_benchmark(grid, "grid road network", num_sources);
+}
+
+/**
+ * @brief BFS, SCC and PageRank on the original vertex order and after each
+ *        graph::Reordering. The results are invariant under relabeling
+ *        (visited vertices, number of components, PageRank mass)
+ */
+void reorder_benchmark(graph::GraphStd<vid_t, eoff_t>& graph,
+                       const char* name) {
+    const char* names[] = { "original", "degree", "rcm", "bfs", "community" };
+    const graph::Reordering types[] = {
+        graph::Reordering::DEGREE, graph::Reordering::RCM,
+        graph::Reordering::BFS,    graph::Reordering::COMMUNITY
+    };
+    std::cout << name << std::endl;
+
+    auto nV = static_cast<size_t>(graph.nV());
+    std::vector<vid_t> original_ids(nV);
+    std::iota(original_ids.begin(), original_ids.end(), 0);
+    vid_t  ref_visited = 0, ref_scc = 0;
+    double ref_rank    = 0.0;
+    for (int i = 0; i < 5; i++) {
+        if (i > 0) {
+            auto permutation = graph.reorder(types[i - 1]);
+            for (auto& id : original_ids)
+                id = permutation[id];
+        }
+        Timer<HOST> TM(2);
+        graph::BFS<vid_t, eoff_t> bfs(graph);
+        TM.start();
+
+        bfs.run(original_ids[0]);
+
+        TM.stop();
+        auto bfs_time = TM.duration();
+        graph::SCC<vid_t, eoff_t> scc(graph);
+        TM.start();
+
+        scc.run();
+
+        TM.stop();
+        auto scc_time = TM.duration();
+        TM.start();
+
+        auto rank = pagerank(graph);
+
+        TM.stop();
+        std::cout << "  " << std::left << std::setw(10) << names[i]
+                  << std::right << std::fixed << std::setprecision(2)
+                  << "  BFS: " << std::setw(8) << bfs_time << " ms"
+                  << "  SCC: " << std::setw(8) << scc_time << " ms"
+                  << "  PageRank: " << std::setw(8) << TM.duration() << " ms"
+                  << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        if (i == 0) {
+            ref_visited = bfs.visited_nodes();
+            ref_scc     = scc.size();
+            ref_rank    = rank;
+        }
+        else if (bfs.visited_nodes() != ref_visited ||
+                 scc.size() != ref_scc || std::abs(rank - ref_rank) > 1e-6) {
+            ERROR(names[i], " reordering: wrong results")
+        }
+    }
+    std::cout << "Reordering: correct\n" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || xlib::extract_file_extension(argv[1]) != ".mtx")
+        ERROR("Usage: ", argv[0], " <graph.mtx> [graph...]")
+    market_benchmark(argv[1]);
+    csr_benchmark(argv[1]);
+    sort_benchmark(argv[1]);
+    pipeline_benchmark(argv[1]);
+    binary_benchmark(argv[1]);
+    mixed_width_benchmark(argv[1]);
+    low_memory_benchmark(argv[1]);
+    reverse_benchmark(argv[1]);
+    external_benchmark(argv[1]);
+    cache_benchmark(argv[1]);
+    //e.g. example/rome99.gr
+    for (int i = 1; i < argc; i++)
+        compressed_benchmark(argv[i]);
+    generator_benchmark(20);
+    profile_benchmark(argv[1]);
+
+    for (int i = 1; i < argc; i++) {
+        graph::GraphStd<vid_t, eoff_t> graph(UNDIRECTED);
+        graph.read(argv[i], SORT);
+        reorder_benchmark(graph, argv[i]);
+    }
+    graph::GraphStd<vid_t, eoff_t> directed(DIRECTED);
+    directed.read(argv[1], SORT);
+    bfs_benchmark(directed, argv[1]);
+    parallel_bfs_benchmark(directed, argv[1]);
+    graph::GraphStd<vid_t, eoff_t> kronecker(UNDIRECTED);
+    kronecker.generate(graph::generator::kronecker(18), SORT);
+    bfs_benchmark(kronecker, "kronecker (scale 18)");
+    parallel_bfs_benchmark(kronecker, "kronecker (scale 18)");
+    multi_source_bfs_benchmark(kronecker, "kronecker (scale 18)", 128);
+    graph::GraphStd<vid_t, eoff_t> small_kronecker(UNDIRECTED);
+    small_kronecker.generate(graph::generator::kronecker(14), SORT);
+    diameter_benchmark(small_kronecker, "kronecker (scale 14)");
+    //graph::SCC is recursive: keep the power-law graph moderately sized
+    graph::GraphStd<vid_t, eoff_t> synthetic(DIRECTED | REVERSE);
+    synthetic.generate(graph::generator::chung_lu(16), SORT);
+    bfs_benchmark(synthetic, "chung-lu (scale 16)");
+    reorder_benchmark(synthetic, "chung-lu (scale 16)");
+
+    for (int i = 1; i < argc; i++) {
+        if (xlib::extract_file_extension(argv[i]) != ".gr")
+            continue;
+        graph::GraphWeight<vid_t, eoff_t, int> road(argv[i], SORT);
+        dijkstra_benchmark(road, argv[i], 64);
+    }
+    dijkstra_grid_benchmark(1024, 4);
+}